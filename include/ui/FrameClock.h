@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QWidget>
+#include <functional>
+#include <vector>
+
+// Shared redraw scheduler for the embedded GL viewers. Viewers register a
+// cheap "needs a frame" predicate and a render function. Whenever the Qt event
+// loop is about to sleep, the clock asks the visible viewers whether they are
+// dirty and, if any is, schedules one tick at most every kFrameIntervalMs.
+// A tick renders only the dirty (or explicitly requested) visible viewers.
+// Idle, hidden or unchanged viewers therefore cost nothing: no timers, no
+// GLFW polling, no buffer swaps.
+class FrameClock : public QObject {
+    Q_OBJECT
+public:
+    using NeedsFrameFn = std::function<bool()>;
+    using RenderFrameFn = std::function<void()>;
+
+    static constexpr int kFrameIntervalMs = 16; // ~60 FPS cap while something animates
+
+    // Created on first use; call from the GUI thread
+    static FrameClock* instance();
+
+    // The viewer is unregistered automatically when it is destroyed
+    void addViewer(QWidget* viewer, NeedsFrameFn needsFrame, RenderFrameFn renderFrame);
+    void removeViewer(QWidget* viewer);
+
+    // One frame for a viewer whose change its predicate cannot see; requests
+    // made before the next tick coalesce into one frame
+    void requestFrame(QWidget* viewer);
+
+    // Thread-safe: makes the GUI thread re-check the viewers (e.g. after a
+    // background page render finished)
+    static void wakeUp();
+
+    quint64 framesRendered() const { return m_framesRendered; }
+
+private slots:
+    void schedule();
+    void tick();
+
+private:
+    explicit FrameClock(QObject* parent = nullptr);
+    bool wantsFrame(size_t index) const;
+    void reportStats();
+
+    struct Viewer {
+        QPointer<QWidget> widget;
+        NeedsFrameFn needsFrame;
+        RenderFrameFn renderFrame;
+        bool requested = false;
+    };
+    std::vector<Viewer> m_viewers;
+    QTimer m_timer;
+    QElapsedTimer m_sinceTick;
+    bool m_inTick = false;
+    quint64 m_framesRendered = 0;
+
+    // LG_FRAME_STATS=1 logs frames and process CPU time every few seconds
+    bool m_statsEnabled = false;
+    QElapsedTimer m_statsClock;
+    quint64 m_statsFrames = 0;
+    double m_statsCpuSeconds = 0.0;
+};
@@ -10,6 +10,7 @@ struct GLFWwindow;
 struct ImGuiContext;
 class PCBRenderer;
 class BRDFileBase;
+class ByteView;
 struct BRDPin;
 // Use renderer's ColorTheme without including the heavy header here
 enum class ColorTheme;
@@ -55,6 +56,9 @@ public:
     std::string getCurrentFilePath() const { return m_currentFilePath; }
 
     // Viewer operations
+    // True when the next render() would draw something different: input or a
+    // resize since the last frames, or renderer state changed through the API
+    bool needsRender() const;
     void render();
     void resize(int width, int height);
     void zoomIn();
@@ -119,9 +123,10 @@ public:
     void getCameraPosition(float& x, float& y) const;
     void setCameraPosition(float x, float y);
 
-    // Simple numeric layer filter (UI-only; renderer may ignore). -1 means ALL
+    // Copper layer filter: n shows only the board's n-th trace layer, -1 means ALL
     void setLayerFilter(int layerIndex); // 1..10, -1 for ALL
     int  getLayerFilter() const { return m_activeLayerFilter; }
+    int  getTraceLayerCount() const; // copper layers with traces in the loaded board
 
     // Callbacks for Qt widget integration
     void setErrorCallback(ErrorCallback callback) { m_errorCallback = callback; }
@@ -181,6 +186,11 @@ private:
     int m_windowWidth;
     int m_windowHeight;
 
+    // Frames still to render after input (see requestRedraw)
+    static constexpr int kSettleFrames = 3;
+    int m_redrawFrames {0};
+    void requestRedraw();
+
     // Mouse state for interaction
     double m_lastMouseX;
     double m_lastMouseY;
@@ -214,11 +224,18 @@ private:
     // Renderer factory method
     std::unique_ptr<PCBRenderer> createRenderer(const std::string& fileExtension);
 
+    // Board snapshot cache: returns the cached board for these source bytes, or
+    // runs parse and stores the result. timing describes warm vs cold open time.
+    using BoardParser = std::function<std::unique_ptr<BRDFileBase>(ByteView)>;
+    std::unique_ptr<BRDFileBase> loadBoardCached(ByteView source, const BoardParser& parse, std::string& timing);
+    static std::string boardCacheDirectory();
+
     // GLFW callback wrappers
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void cursorEnterCallback(GLFWwindow* window, int entered);
     static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
 
     // Layer/state
@@ -105,7 +105,8 @@ private:
     void setupUI();
     void setupToolbar();
     void setupLayerBar();            // left-side 1..10, ALL
-    void updateLayerBarVisibility(); // show when filename contains "layer"
+    void updateLayerBarVisibility(); // show for multi-layer boards or when filename contains "layer"
+    void resetLayerFilter();         // back to ALL after a new board is loaded
     void positionLayerBar();         // overlay position within viewer container
     void connectSignals();
     void applyToolbarTheme(); // reapply styles for current dark/light theme
@@ -129,7 +130,9 @@ private:
     QComboBox *m_netCombo{nullptr};
     QPushButton *m_netSearchButton{nullptr};
     QWidget *m_viewerContainer;
-    QTimer *m_updateTimer;
+    // Loaded and shown: the shared FrameClock renders this viewer when it is dirty
+    bool m_framesActive { false };
+    void setFramesActive(bool active);
     // Left-side layer bar
     QWidget *m_layerBar { nullptr };
     QList<class QToolButton*> m_layerButtons; // 1..10 + ALL
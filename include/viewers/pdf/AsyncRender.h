@@ -7,6 +7,7 @@
 #include <queue>
 #include <atomic>
 #include <cstdint>
+#include <functional>
 
 class PDFRenderer;
 
@@ -47,6 +48,13 @@ public:
     // Cancel all work and bump generation to avoid stale uploads
     void cancelAll();
 
+    // Invoked on the worker thread after each result is stored (e.g. to wake
+    // the UI thread); set before submitting work
+    void setResultCallback(std::function<void()> callback) { m_resultCallback = std::move(callback); }
+
+    // True when drainResults() would return something
+    bool hasResults();
+
 private:
     void workerLoop();
 
@@ -63,4 +71,5 @@ private:
     std::vector<PageRenderResult> m_results;
 
     std::atomic<int> m_currentGeneration{0};
+    std::function<void()> m_resultCallback;
 };
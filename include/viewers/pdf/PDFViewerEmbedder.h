@@ -66,6 +66,13 @@ public:
      */
     void update();
 
+    /**
+     * Whether update() would draw anything new: input or a resize since the last
+     * frame, pending regeneration or texture uploads, or a view change made
+     * through the API. Cheap enough to poll before every frame.
+     */
+    bool needsUpdate() const;
+
     /**
      * Handle window resize events
      * @param width New width
@@ -219,6 +226,24 @@ private:
     bool isActiveGlobal() const;              // Whether global pointers map to this viewer
     void logContextMismatch(const char* where) const; // Helper
     
+    // On-demand frames: set by input callbacks and resizes, cleared by update()
+    bool m_frameRequested { true };
+    // What the last frame showed, to notice view changes made outside update()
+    struct ViewSignature {
+        float scrollOffset {0.0f};
+        float horizontalOffset {0.0f};
+        float zoomScale {0.0f};
+        bool  selectionActive {false};
+        int   selectionStart[2] {-1, -1}; // page, char
+        int   selectionEnd[2] {-1, -1};
+        double selectionEndPos[2] {0.0, 0.0};
+        int   searchResultIndex {-1};
+        size_t searchResultCount {0};
+        bool operator==(const ViewSignature& o) const;
+    };
+    ViewSignature currentViewSignature() const;
+    ViewSignature m_lastDrawnView;
+
     // Rendering state management
     bool m_needsFullRegeneration;
     bool m_needsVisibleRegeneration;
@@ -278,6 +303,9 @@ private:
     // --- Quick right-click hook for Qt context menu integration ---
 public:
     void setQuickRightClickCallback(const std::function<void(const std::string &selectedText)> &cb) { m_quickRightClickCallback = cb; }
+    // Called from the render worker thread whenever a background page render
+    // completes, so the host can schedule a frame to upload it
+    void setAsyncResultCallback(const std::function<void()> &cb) { m_asyncResultCallback = cb; }
 private:
     // Pending GL uploads queue to cap per-frame texture upload work
     std::vector<PageRenderResult> m_pendingGLUploads;
@@ -286,6 +314,7 @@ private:
     double m_rightPressY {0.0};
     bool   m_rightMoved {false};
     std::function<void(const std::string&)> m_quickRightClickCallback;
+    std::function<void()> m_asyncResultCallback;
 
     // Ensure global viewer pointers point to this instance before executing actions
     void ensureActiveGlobals();
@@ -222,8 +222,9 @@ private:
     
     // Split view navigation widgets removed
     
-    // Update timer for the embedded viewer
-    QTimer* m_updateTimer;
+    // Shown with a viewer: the shared FrameClock renders it whenever it is dirty
+    bool m_framesActive { false };
+    void setFramesActive(bool active);
     QTimer* m_navigationTimer;  // Timer to reset navigation flag
     QTimer* m_searchDebounceTimer; // Debounce timer for search
     
@@ -247,9 +248,6 @@ private:
     double m_lastKnownZoom = -1; // Track last zoom level
     QString m_lastSearchTerm;    // Track last executed search term
     static constexpr int SEARCH_DEBOUNCE_MS = 250;
-    
-    // Constants
-    static constexpr int UPDATE_INTERVAL_MS = 16; // ~60 FPS
 
     // Async scaffolding state (Phase 1)
     int m_currentLoadId = 0;
@@ -0,0 +1,145 @@
+#include "ui/FrameClock.h"
+
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QDebug>
+#include <algorithm>
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+
+// User + kernel CPU time of the whole process, in seconds
+double processCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) return 0.0;
+    auto toSeconds = [](const FILETIME& t) {
+        ULARGE_INTEGER v;
+        v.LowPart = t.dwLowDateTime;
+        v.HighPart = t.dwHighDateTime;
+        return static_cast<double>(v.QuadPart) * 1e-7; // 100 ns units
+    };
+    return toSeconds(kernel) + toSeconds(user);
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+constexpr int kStatsIntervalMs = 5000;
+
+} // namespace
+
+FrameClock* FrameClock::instance()
+{
+    static FrameClock* clock = new FrameClock(QCoreApplication::instance());
+    return clock;
+}
+
+FrameClock::FrameClock(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &FrameClock::tick);
+    // Every batch of events (input, resizes, queued results) ends here, so
+    // state changed by any handler is picked up before the thread sleeps
+    if (auto* dispatcher = QAbstractEventDispatcher::instance(thread())) {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &FrameClock::schedule);
+    }
+    m_sinceTick.start();
+
+    // LG_FRAME_STATS=1 logs frames and process CPU every 5 s; with tabs open
+    // and the window left alone, this line is the idle CPU figure
+    m_statsEnabled = qEnvironmentVariableIntValue("LG_FRAME_STATS") != 0;
+    if (m_statsEnabled) {
+        auto* statsTimer = new QTimer(this);
+        connect(statsTimer, &QTimer::timeout, this, &FrameClock::reportStats);
+        statsTimer->start(kStatsIntervalMs);
+        m_statsClock.start();
+        m_statsCpuSeconds = processCpuSeconds();
+    }
+}
+
+void FrameClock::addViewer(QWidget* viewer, NeedsFrameFn needsFrame, RenderFrameFn renderFrame)
+{
+    if (!viewer) return;
+    removeViewer(viewer);
+    m_viewers.push_back({viewer, std::move(needsFrame), std::move(renderFrame), false});
+    connect(viewer, &QObject::destroyed, this, [this, viewer]() { removeViewer(viewer); });
+}
+
+void FrameClock::removeViewer(QWidget* viewer)
+{
+    m_viewers.erase(std::remove_if(m_viewers.begin(), m_viewers.end(), [viewer](const Viewer& v) {
+                        return v.widget.isNull() || v.widget.data() == viewer;
+                    }),
+                    m_viewers.end());
+}
+
+void FrameClock::requestFrame(QWidget* viewer)
+{
+    for (Viewer& v : m_viewers) {
+        if (v.widget.data() == viewer) v.requested = true;
+    }
+    schedule();
+}
+
+void FrameClock::wakeUp()
+{
+    // Posting an event is thread-safe; the resulting loop iteration ends in schedule()
+    QMetaObject::invokeMethod(instance(), []() {}, Qt::QueuedConnection);
+}
+
+bool FrameClock::wantsFrame(size_t index) const
+{
+    const Viewer& v = m_viewers[index];
+    if (v.widget.isNull() || !v.widget->isVisible()) return false;
+    return v.requested || (v.needsFrame && v.needsFrame());
+}
+
+void FrameClock::schedule()
+{
+    if (m_inTick || m_timer.isActive()) return;
+    for (size_t i = 0; i < m_viewers.size(); ++i) {
+        if (!wantsFrame(i)) continue;
+        // Coalesce: no closer than one frame interval after the previous tick
+        qint64 wait = kFrameIntervalMs - m_sinceTick.elapsed();
+        m_timer.start(static_cast<int>(std::max<qint64>(0, wait)));
+        return;
+    }
+}
+
+void FrameClock::tick()
+{
+    m_inTick = true;
+    m_sinceTick.restart();
+    // Index loop: a frame may pump events that add or remove viewers
+    for (size_t i = 0; i < m_viewers.size(); ++i) {
+        if (!wantsFrame(i)) continue;
+        m_viewers[i].requested = false;
+        RenderFrameFn render = m_viewers[i].renderFrame;
+        if (render) {
+            render();
+            m_framesRendered++;
+        }
+    }
+    m_inTick = false;
+    // Viewers still dirty (animation, uploads in flight) get the next tick from
+    // the aboutToBlock check once this event has been handled
+}
+
+void FrameClock::reportStats()
+{
+    double cpu = processCpuSeconds();
+    double wall = m_statsClock.restart() / 1000.0;
+    quint64 frames = m_framesRendered - m_statsFrames;
+    qDebug().nospace() << "[FrameClock] " << m_viewers.size() << " viewers, " << frames << " frames in " << wall
+                       << " s, process CPU " << (wall > 0.0 ? 100.0 * (cpu - m_statsCpuSeconds) / wall : 0.0) << "%";
+    m_statsFrames = m_framesRendered;
+    m_statsCpuSeconds = cpu;
+}
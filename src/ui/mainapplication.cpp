@@ -2131,7 +2131,7 @@ void MainApplication::openFileInTab(const QString &filePath)
     }
     
     // Check if it's a PCB file
-    if (extension == "xzz" || extension == "pcb" || extension == "xzzpcb") {
+    if (extension == "xzz" || extension == "pcb" || extension == "xzzpcb" || extension == "brd" || extension == "brd2") {
         openPCBInTab(filePath);
         return;
     }
@@ -2139,7 +2139,7 @@ void MainApplication::openFileInTab(const QString &filePath)
     // For non-PDF/PCB files, show a message
     statusBar()->showMessage("Only PDF and PCB files are supported in tabs");
     QMessageBox::information(this, "File Type Not Supported", 
-        "Only PDF files (.pdf) and PCB files (.xzz, .pcb, .xzzpcb) can be opened in tabs.\n\n"
+        "Only PDF files (.pdf) and PCB files (.xzz, .pcb, .xzzpcb, .brd, .brd2) can be opened in tabs.\n\n"
         "Selected file: " + fileInfo.fileName() + "\n"
         "File type: " + (extension.isEmpty() ? "Unknown" : extension.toUpper()));
 }
@@ -2359,9 +2359,9 @@ void MainApplication::openPCBInTab(const QString &filePath)
                 "Path: %2\n\n"
                 "This PCB file may be:\n"
                 "• Corrupted or invalid\n"
-                "• Incompatible with XZZPCB format\n" 
+                "• Incompatible with XZZPCB or BRD format\n" 
                 "• Not accessible due to permissions\n\n"
-                "Supported formats: .xzz, .pcb, .xzzpcb"
+                "Supported formats: .xzz, .pcb, .xzzpcb, .brd, .brd2"
             ).arg(fileInfo.fileName()).arg(filePath);
             
             QMessageBox::warning(this, "PCB Loading Error", errorMessage);
@@ -3417,7 +3417,7 @@ QIcon MainApplication::getFileIcon(const QString &filePath)
         QIcon pdfIcon(":/icons/images/icons/PDF_icon.svg");
         if (!pdfIcon.isNull()) return pdfIcon;
         return style()->standardIcon(QStyle::SP_FileDialogListView);
-    } else if (extension == "pcb" || extension == "xzz" || extension == "xzzpcb") {
+    } else if (extension == "pcb" || extension == "xzz" || extension == "xzzpcb" || extension == "brd" || extension == "brd2") {
         // Custom PCB icon
         QIcon pcbIcon(":/icons/images/icons/PCB_icon.svg");
         if (!pcbIcon.isNull()) return pcbIcon;
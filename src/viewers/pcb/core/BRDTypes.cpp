@@ -1,5 +1,36 @@
 #include "BRDTypes.h"
+#include <algorithm>
+#include <cmath>
 
-// Implementation file for BRDTypes
-// Currently all types are header-only, but this file can be used
-// for future implementations if needed.
+void BRDArc::GetBounds(float& min_x, float& min_y, float& max_x, float& max_y) const {
+    const double deg_to_rad = 3.14159265358979323846 / 180.0;
+    const double cx = center.x, cy = center.y;
+    double a0 = start_angle, a1 = start_angle + sweep_angle;
+    if (a0 > a1) std::swap(a0, a1);
+
+    auto point_at = [&](double degrees, double& x, double& y) {
+        x = cx + radius * std::cos(degrees * deg_to_rad);
+        y = cy + radius * std::sin(degrees * deg_to_rad);
+    };
+    double x, y;
+    point_at(a0, x, y);
+    double lo_x = x, hi_x = x, lo_y = y, hi_y = y;
+    point_at(a1, x, y);
+    lo_x = std::min(lo_x, x); hi_x = std::max(hi_x, x);
+    lo_y = std::min(lo_y, y); hi_y = std::max(hi_y, y);
+
+    // Every multiple of 90 degrees inside the sweep is an extreme on one axis
+    for (double q = std::ceil(a0 / 90.0) * 90.0; q <= a1 && q < a0 + 360.0; q += 90.0) {
+        int quadrant = static_cast<int>(std::fmod(std::fmod(q / 90.0, 4.0) + 4.0, 4.0) + 0.5) & 3;
+        switch (quadrant) {
+            case 0: hi_x = std::max(hi_x, cx + radius); break;
+            case 1: hi_y = std::max(hi_y, cy + radius); break;
+            case 2: lo_x = std::min(lo_x, cx - radius); break;
+            default: lo_y = std::min(lo_y, cy - radius); break;
+        }
+    }
+    min_x = static_cast<float>(lo_x);
+    min_y = static_cast<float>(lo_y);
+    max_x = static_cast<float>(hi_x);
+    max_y = static_cast<float>(hi_y);
+}
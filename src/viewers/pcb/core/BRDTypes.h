@@ -38,21 +38,23 @@ struct BRDPart {
 // Pin sides
 enum class BRDPinSide { Both, Bottom, Top };
 
-// PCB Pin structure
+// Ids every board's string pool reserves (see BRDFileBase::string_pool)
+constexpr uint32_t kEmptyStringId = 0;     // ""
+constexpr uint32_t kUnconnectedNetId = 1;  // "UNCONNECTED"
+
+// PCB Pin structure. Net, name and pin number repeat across thousands of pins,
+// so they are ids into the owning board's string pool: read them with
+// BRDFileBase::PinNet()/PinName()/PinSnum() and set them with SetPinNet() etc.
 struct BRDPin {
     BRDPoint pos;
     int probe = 0;
     unsigned int part = 0;
     BRDPinSide side = BRDPinSide::Top;
-    std::string net = "UNCONNECTED";
+    uint32_t net_id = kUnconnectedNetId;
     double radius = 0.5f;
-    std::string snum;
-    std::string name;
+    uint32_t snum_id = kEmptyStringId;
+    uint32_t name_id = kEmptyStringId;
     std::string comment;
-
-    bool operator<(const BRDPin &p) const {
-        return part == p.part ? (snum < p.snum) : (part < p.part);
-    }
 };
 
 // PCB Nail structure
@@ -99,3 +101,36 @@ struct BRDOval {
     BRDOval(BRDPoint center, float width, float height, float rotation = 0.0f, float r = 1.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f) 
         : center(center), width(width), height(height), rotation(rotation), r(r), g(g), b(b), a(a) {}
 };
+
+// Straight PCB copper trace segment; copper arcs are BRDArcs in the same
+// TraceLayer, tessellated at render time by ArcTessellator. net indexes the
+// board's trace_nets table
+struct BRDTrace {
+    BRDPoint a;
+    BRDPoint b;
+    float width = 0.0f; // board units; 0 if the file gives none
+    uint32_t net = 0;
+
+    BRDTrace() = default;
+    BRDTrace(BRDPoint a, BRDPoint b, float width, uint32_t net) : a(a), b(b), width(width), net(net) {}
+};
+
+// Circular arc kept analytically and tessellated by the renderer for the
+// current zoom. Angles are in degrees, counter-clockwise from +x; the arc runs
+// from start_angle over sweep_angle (negative sweeps run clockwise)
+struct BRDArc {
+    BRDPoint center;
+    float radius = 0.0f;
+    float start_angle = 0.0f;
+    float sweep_angle = 0.0f;
+    float width = 0.0f; // copper arcs only, board units
+    uint32_t net = 0;   // copper arcs only, index into trace_nets
+
+    BRDArc() = default;
+    BRDArc(BRDPoint center, float radius, float start_angle, float sweep_angle, float width = 0.0f, uint32_t net = 0)
+        : center(center), radius(radius), start_angle(start_angle), sweep_angle(sweep_angle), width(width), net(net) {}
+
+    // Exact axis-aligned bounds of the centerline (end points plus the axis
+    // extremes the sweep passes)
+    void GetBounds(float& min_x, float& min_y, float& max_x, float& max_y) const;
+};
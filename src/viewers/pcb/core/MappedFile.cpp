@@ -0,0 +1,136 @@
+#include "MappedFile.h"
+#include "Utils.h"
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PCB_HAVE_MMAP 1
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other) noexcept {
+    m_size = other.m_size;
+    m_open = other.m_open;
+    m_mapping = other.m_mapping;
+    m_mappingHandle = other.m_mappingHandle;
+    m_fallback = std::move(other.m_fallback);
+    m_data = m_mapping ? static_cast<const char*>(m_mapping) : m_fallback.data();
+
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+    other.m_mapping = nullptr;
+    other.m_mappingHandle = nullptr;
+}
+
+bool MappedFile::Open(const std::string& filepath) {
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    CloseHandle(file); // the mapping keeps the file alive
+                    m_mapping = view;
+                    m_mappingHandle = mapping;
+                    m_data = static_cast<const char*>(view);
+                    m_size = static_cast<size_t>(fileSize.QuadPart);
+                    m_open = true;
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#elif defined(PCB_HAVE_MMAP)
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                ::close(fd); // the mapping keeps the file alive
+                m_mapping = view;
+                m_data = static_cast<const char*>(view);
+                m_size = static_cast<size_t>(st.st_size);
+                m_open = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    // Fallback: buffered read (also covers empty files, which cannot be mapped)
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open file: " + filepath);
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    m_fallback.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(m_fallback.data(), size)) {
+        LOG_ERROR("Failed to read file: " + filepath);
+        m_fallback.clear();
+        return false;
+    }
+
+    m_data = m_fallback.data();
+    m_size = m_fallback.size();
+    m_open = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_mapping) {
+#if defined(_WIN32)
+        UnmapViewOfFile(m_mapping);
+        if (m_mappingHandle) CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+#elif defined(PCB_HAVE_MMAP)
+        munmap(m_mapping, m_size);
+#endif
+    }
+    m_mapping = nullptr;
+    m_mappingHandle = nullptr;
+    m_fallback.clear();
+    m_fallback.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. Uses a memory mapping where the platform
+// supports it (mmap / CreateFileMapping) so repeated opens are served from the
+// OS page cache without a private copy; otherwise falls back to a buffered read.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filepath) { Open(filepath); }
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Returns false if the file cannot be opened or read
+    bool Open(const std::string& filepath);
+    void Close();
+
+    bool IsOpen() const { return m_open; }
+    bool IsMapped() const { return m_mapping != nullptr; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    void MoveFrom(MappedFile& other) noexcept;
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+    void* m_mapping = nullptr;        // mapped base address (nullptr when using the fallback)
+    void* m_mappingHandle = nullptr;  // Windows file-mapping handle
+    std::vector<char> m_fallback;     // buffered copy when mapping is unavailable
+};
@@ -8,6 +8,8 @@
 #include "../format/XZZPCBFile.h"
 #include "../format/BRDFile.h"
 #include "../format/BRD2File.h"
+#include "../format/BoardCacheFile.h"
+#include "../core/MappedFile.h"
 #include "../core/BRDTypes.h"
 #include "../core/Utils.h"
 
@@ -15,6 +17,7 @@
 #include <QStandardPaths>
 #include <QDateTime>
 #include <QFile>
+#include <QDir>
 
 // GLFW includes
 #include <GLFW/glfw3.h>
@@ -39,6 +42,8 @@
 #include <algorithm>
 #include <cmath>
 #include <mutex>
+#include <chrono>
+#include <cstdio>
 
 PCBViewerEmbedder::PCBViewerEmbedder()
     : m_glfwWindow(nullptr)
@@ -87,6 +92,43 @@ std::unique_ptr<PCBRenderer> PCBViewerEmbedder::createRenderer(const std::string
     */
 }
 
+std::string PCBViewerEmbedder::boardCacheDirectory()
+{
+    QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (base.isEmpty()) return std::string();
+    return QDir(base).filePath("pcb").toStdString();
+}
+
+std::unique_ptr<BRDFileBase> PCBViewerEmbedder::loadBoardCached(ByteView source, const BoardParser& parse, std::string& timing)
+{
+    using Clock = std::chrono::steady_clock;
+    auto formatMs = [](double ms) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.1f ms", ms);
+        return std::string(text);
+    };
+
+    const std::string cacheDir = boardCacheDirectory();
+    const auto start = Clock::now();
+    const uint64_t hash = BoardCacheFile::ContentHash(source);
+
+    if (auto cached = BoardCacheFile::LoadFromCache(cacheDir, hash, source.size())) {
+        double warmMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        timing = "warm open " + formatMs(warmMs) + " from cache, cold parse was " + formatMs(cached->SourceParseMs());
+        return cached;
+    }
+
+    std::unique_ptr<BRDFileBase> board = parse(source);
+    if (!board) return nullptr;
+
+    double coldMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    timing = "cold open " + formatMs(coldMs);
+    if (!BoardCacheFile::Store(cacheDir, hash, source.size(), *board, coldMs)) {
+        timing += ", not cached";
+    }
+    return board;
+}
+
 bool PCBViewerEmbedder::initialize(void* parentWindowHandle, int width, int height)
 {
     if (m_initialized) {
@@ -234,38 +276,35 @@ bool PCBViewerEmbedder::loadPCB(const std::string& filePath)
         // Determine file format and load accordingly
         std::string ext = Utils::ToLower(Utils::GetFileExtension(filePath));
         std::shared_ptr<BRDFileBase> pcbFile = nullptr;
+        std::string openTiming;
         
-        // BRD and BRD2 support disabled - parsing code kept for reference
-        /*
-        if (ext == "brd") {
-            // Load BRD file
-            auto brd = BRDFile::LoadFromFile(filePath);
-            if (brd) {
-                pcbFile = std::shared_ptr<BRDFileBase>(brd.release());
-            }
-        } else if (ext == "brd2") {
-            // Load BRD2 file
-            auto brd2 = BRD2File::LoadFromFile(filePath);
-            if (brd2) {
-                pcbFile = std::shared_ptr<BRDFileBase>(brd2.release());
-            }
-        } else {
-        */
-            // Load XZZPCB file (for .xzz, .pcb, .xzzpcb)
-            auto xzzpcb = XZZPCBFile::LoadFromFile(filePath);
-            if (xzzpcb) {
-                pcbFile = std::shared_ptr<BRDFileBase>(xzzpcb.release());
-            }
-        /*
+        // Reuse a cached snapshot when the bytes match; otherwise parse by extension
+        // (.brd, .brd2, and XZZPCB for .xzz, .pcb, .xzzpcb)
+        MappedFile file;
+        if (file.Open(filePath)) {
+            auto board = loadBoardCached(ByteView(file.data(), file.size()), [&](ByteView source) -> std::unique_ptr<BRDFileBase> {
+                std::unique_ptr<BRDFileBase> parsed;
+                if (ext == "brd") {
+                    parsed = std::make_unique<BRDFile>();
+                } else if (ext == "brd2") {
+                    parsed = std::make_unique<BRD2File>();
+                } else {
+                    parsed = std::make_unique<XZZPCBFile>();
+                }
+                if (!parsed->Load(source, filePath)) return nullptr;
+                return parsed;
+            }, openTiming);
+            pcbFile = std::shared_ptr<BRDFileBase>(board.release());
         }
-        */
         
         if (!pcbFile) {
             handleError("Failed to load PCB file: " + filePath);
             return false;
         }
 
-        // Create appropriate renderer based on file type
+        // Create appropriate renderer based on file type; the old one frees its
+        // GL objects, which live in this tab's context
+        if (m_glfwWindow) glfwMakeContextCurrent(m_glfwWindow);
         m_renderer = createRenderer(ext);
         if (!m_renderer) {
             handleError("Failed to create renderer for file type: " + ext);
@@ -288,8 +327,9 @@ bool PCBViewerEmbedder::loadPCB(const std::string& filePath)
 
         m_currentFilePath = filePath;
         m_pdfLoaded = true;
+        requestRedraw();
 
-        handleStatus("PCB file loaded successfully: " + filePath);
+        handleStatus("PCB file loaded successfully: " + filePath + " (" + openTiming + ")");
         return true;
     }
     catch (const std::exception& e) {
@@ -307,54 +347,58 @@ bool PCBViewerEmbedder::loadPCBFromMemory(const char* data, size_t size, const s
     }
 
     try {
-        // Build a buffer view from the provided bytes
-        std::vector<char> buffer;
-        buffer.reserve(size);
-        buffer.insert(buffer.end(), data, data + size);
+        // Parse straight from the caller's bytes; loaders copy only what they must decode in place
+        ByteView buffer(data, size);
 
         // Determine file type. Prefer XZZPCB (current supported path)
-        std::unique_ptr<BRDFileBase> pcbFile;
-
-        // Try XZZPCB first
-        {
-            XZZPCBFile probe;
-            if (probe.VerifyFormat(buffer)) {
-                auto xzz = std::make_unique<XZZPCBFile>();
-                if (!xzz->Load(buffer, displayName)) {
-                    handleError("Failed to parse XZZPCB data from memory");
-                    return false;
+        std::string parseError;
+        auto parse = [&](ByteView source) -> std::unique_ptr<BRDFileBase> {
+            // Try XZZPCB first
+            {
+                XZZPCBFile probe;
+                if (probe.VerifyFormat(source)) {
+                    auto xzz = std::make_unique<XZZPCBFile>();
+                    if (!xzz->Load(source, displayName)) {
+                        parseError = "Failed to parse XZZPCB data from memory";
+                        return nullptr;
+                    }
+                    return xzz;
                 }
-                pcbFile = std::move(xzz);
             }
-        }
 
-        // If not XZZPCB, optionally try BRD/BRD2 (parsers support memory buffers)
-        if (!pcbFile) {
-            BRDFile brdProbe;
-            if (brdProbe.VerifyFormat(buffer)) {
-                auto brd = std::make_unique<BRDFile>();
-                if (!brd->Load(buffer, displayName)) {
-                    handleError("Failed to parse BRD data from memory");
-                    return false;
+            // If not XZZPCB, optionally try BRD/BRD2 (parsers support memory buffers)
+            {
+                BRDFile brdProbe;
+                if (brdProbe.VerifyFormat(source)) {
+                    auto brd = std::make_unique<BRDFile>();
+                    if (!brd->Load(source, displayName)) {
+                        parseError = "Failed to parse BRD data from memory";
+                        return nullptr;
+                    }
+                    return brd;
                 }
-                pcbFile = std::move(brd);
             }
-        }
 
-        if (!pcbFile) {
-            BRD2File brd2Probe;
-            if (brd2Probe.VerifyFormat(buffer)) {
-                auto brd2 = std::make_unique<BRD2File>();
-                if (!brd2->Load(buffer, displayName)) {
-                    handleError("Failed to parse BRD2 data from memory");
-                    return false;
+            {
+                BRD2File brd2Probe;
+                if (brd2Probe.VerifyFormat(source)) {
+                    auto brd2 = std::make_unique<BRD2File>();
+                    if (!brd2->Load(source, displayName)) {
+                        parseError = "Failed to parse BRD2 data from memory";
+                        return nullptr;
+                    }
+                    return brd2;
                 }
-                pcbFile = std::move(brd2);
             }
-        }
 
+            parseError = "Unrecognized PCB format in memory buffer";
+            return nullptr;
+        };
+
+        std::string openTiming;
+        std::unique_ptr<BRDFileBase> pcbFile = loadBoardCached(buffer, parse, openTiming);
         if (!pcbFile) {
-            handleError("Unrecognized PCB format in memory buffer");
+            handleError(parseError);
             return false;
         }
 
@@ -378,7 +422,8 @@ bool PCBViewerEmbedder::loadPCBFromMemory(const char* data, size_t size, const s
 
         m_currentFilePath = displayName.empty() ? std::string("memory://pcb") : displayName;
         m_pdfLoaded = true;
-        handleStatus("PCB loaded successfully from memory (" + std::to_string(size) + " bytes)");
+        requestRedraw();
+        handleStatus("PCB loaded successfully from memory (" + std::to_string(size) + " bytes, " + openTiming + ")");
         return true;
     }
     catch (const std::exception& e) {
@@ -394,6 +439,7 @@ void PCBViewerEmbedder::closePCB()
     }
 
     handleStatus("Closing PCB file");
+    requestRedraw();
     
     m_pcbData.reset();
     m_pdfLoaded = false;
@@ -403,6 +449,24 @@ void PCBViewerEmbedder::closePCB()
     handleStatus("PCB file closed");
 }
 
+bool PCBViewerEmbedder::needsRender() const
+{
+    if (!m_initialized || m_usingFallback || !m_glfwWindow || !m_imguiContext || !m_visible) {
+        return false;
+    }
+    if (m_redrawFrames > 0) {
+        return true;
+    }
+    // Camera, selection, highlight and theme changes made through the API
+    return m_renderer && m_pdfLoaded && m_renderer->NeedsRedraw(m_windowWidth, m_windowHeight);
+}
+
+void PCBViewerEmbedder::requestRedraw()
+{
+    // ImGui settles hover and tooltip state over a couple of frames
+    m_redrawFrames = kSettleFrames;
+}
+
 void PCBViewerEmbedder::render()
 {
     if (!m_initialized || m_usingFallback || !m_glfwWindow || !m_imguiContext) {
@@ -412,6 +476,7 @@ void PCBViewerEmbedder::render()
     if (!m_visible) {
         return;
     }
+    if (m_redrawFrames > 0) m_redrawFrames--;
 
     // Poll GLFW events first - CRITICAL: This was missing!
     glfwPollEvents();
@@ -442,8 +507,11 @@ void PCBViewerEmbedder::render()
     // Display hover information like in main.cpp - this was missing!
     displayPinHoverInfo();
 
-    // Render ImGui - matching main.cpp sequence
+    // Render ImGui - matching main.cpp sequence; the cached board goes under the UI
     ImGui::Render();
+    if (m_renderer) {
+        m_renderer->SubmitScene(ImGui::GetDrawData());
+    }
     if (m_imguiUseGL3) {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     } else {
@@ -458,6 +526,7 @@ void PCBViewerEmbedder::resize(int width, int height)
 {
     m_windowWidth = width;
     m_windowHeight = height;
+    requestRedraw();
 
     if (m_glfwWindow) {
         // Resize the GLFW window
@@ -772,7 +841,7 @@ std::string PCBViewerEmbedder::getSelectedPinNet() const {
     if (!m_renderer->HasSelectedPin()) return {};
     int idx = m_renderer->GetSelectedPinIndex();
     if (idx < 0 || idx >= (int)m_pcbData->pins.size()) return {};
-    return m_pcbData->pins[idx].net;
+    return m_pcbData->PinNet(m_pcbData->pins[idx]);
 }
 
 std::string PCBViewerEmbedder::getSelectedPinPart() const {
@@ -806,7 +875,7 @@ std::string PCBViewerEmbedder::getSelectedPinInfo() const
     int selectedPin = m_renderer->GetSelectedPinIndex();
     if (selectedPin >= 0 && selectedPin < static_cast<int>(m_pcbData->pins.size())) {
         const auto& pin = m_pcbData->pins[selectedPin];
-        return "Pin: " + pin.name + " Net: " + pin.net;
+        return "Pin: " + m_pcbData->PinName(pin) + " Net: " + m_pcbData->PinNet(pin);
     }
 
     return "";
@@ -815,6 +884,7 @@ std::string PCBViewerEmbedder::getSelectedPinInfo() const
 void PCBViewerEmbedder::show()
 {
     m_visible = true;
+    requestRedraw();
     if (m_glfwWindow) {
         glfwShowWindow(m_glfwWindow);
     }
@@ -896,7 +966,11 @@ void PCBViewerEmbedder::setLayerFilter(int layerIndex)
         if (layerIndex > 10) layerIndex = 10;
     }
     m_activeLayerFilter = layerIndex;
-    // Renderer currently doesn't filter by layer; this is a UI hint for now.
+    // Button n shows the board's n-th copper layer (pads and outlines stay)
+    if (m_renderer) {
+        m_renderer->SetLayerFilter(layerIndex);
+        requestRedraw();
+    }
     if (layerIndex == -1) {
         handleStatus("Layer filter: ALL");
     } else {
@@ -904,6 +978,11 @@ void PCBViewerEmbedder::setLayerFilter(int layerIndex)
     }
 }
 
+int PCBViewerEmbedder::getTraceLayerCount() const
+{
+    return m_pcbData ? static_cast<int>(m_pcbData->trace_layers.size()) : 0;
+}
+
 // Private methods
 
 bool PCBViewerEmbedder::initializeGLFW(void* parentHandle, int width, int height)
@@ -1051,11 +1130,15 @@ bool PCBViewerEmbedder::initializeRenderer()
     }
 
     // Initialize renderer - matching PCBRenderer::Initialize() from the standalone version
+    if (m_glfwWindow) glfwMakeContextCurrent(m_glfwWindow);
     if (!m_renderer->Initialize()) {
         handleError("Failed to initialize PCB renderer");
         return false;
     }
 
+    // Instanced GPU pads need the GL3 backend; GL2 contexts keep the ImDrawList pads
+    bool gpuPads = m_renderer->SetGpuPadsEnabled(m_imguiUseGL3);
+
     // Apply ImGui UI setting and memory optimizations to renderer after initialization
     auto& settings = m_renderer->GetSettings();
     
@@ -1065,7 +1148,7 @@ bool PCBViewerEmbedder::initializeRenderer()
     settings.outline_alpha = 0.9f;
     
     handleStatus(std::string("PCB renderer initialized successfully with ImGui overlay ") + 
-                (m_imguiUIEnabled ? "enabled" : "disabled"));
+                (m_imguiUIEnabled ? "enabled" : "disabled") + (gpuPads ? ", GPU pads" : ""));
     
     return true;
 }
@@ -1085,6 +1168,7 @@ void PCBViewerEmbedder::setupCallbacks()
     glfwSetScrollCallback(m_glfwWindow, scrollCallback);
     glfwSetKeyCallback(m_glfwWindow, keyCallback);
     glfwSetFramebufferSizeCallback(m_glfwWindow, framebufferSizeCallback);
+    glfwSetCursorEnterCallback(m_glfwWindow, cursorEnterCallback);
 }
 
 
@@ -1109,7 +1193,7 @@ void PCBViewerEmbedder::onPinSelected(int pinIndex)
 {
     if (m_pinSelectedCallback && m_pcbData && pinIndex >= 0 && pinIndex < static_cast<int>(m_pcbData->pins.size())) {
         const auto& pin = m_pcbData->pins[pinIndex];
-        m_pinSelectedCallback(pin.name, pin.net);
+        m_pinSelectedCallback(m_pcbData->PinName(pin), m_pcbData->PinNet(pin));
     }
 }
 
@@ -1135,6 +1219,7 @@ void PCBViewerEmbedder::mouseButtonCallback(GLFWwindow* window, int button, int
     (void)mods;
     PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->requestRedraw();
         double xpos, ypos;
         glfwGetCursorPos(window, &xpos, &ypos);
 
@@ -1269,6 +1354,7 @@ void PCBViewerEmbedder::cursorPosCallback(GLFWwindow* window, double xpos, doubl
 {
     PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->requestRedraw();
         // Movement threshold for quick right-click detection
         if (embedder->m_rcPressTime > 0.0 && !embedder->m_rcMoved) {
             double dx = xpos - embedder->m_rcPressX;
@@ -1283,6 +1369,7 @@ void PCBViewerEmbedder::scrollCallback(GLFWwindow* window, double xoffset, doubl
 {
     PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->requestRedraw();
         embedder->handleMouseScroll(xoffset, yoffset);
     }
 }
@@ -1291,14 +1378,26 @@ void PCBViewerEmbedder::keyCallback(GLFWwindow* window, int key, int scancode, i
 {
     PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->requestRedraw();
         embedder->handleKeyPress(key, scancode, action, mods);
     }
 }
 
+void PCBViewerEmbedder::cursorEnterCallback(GLFWwindow* window, int entered)
+{
+    // Keep ImGui's hover tracking (its own callback is replaced here)
+    ImGui_ImplGlfw_CursorEnterCallback(window, entered);
+    PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
+    if (embedder) {
+        embedder->requestRedraw();
+    }
+}
+
 void PCBViewerEmbedder::framebufferSizeCallback(GLFWwindow* window, int width, int height)
 {
     PCBViewerEmbedder* embedder = static_cast<PCBViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->requestRedraw();
         embedder->resize(width, height);
     }
 }
@@ -1348,35 +1447,19 @@ void PCBViewerEmbedder::hideAllLayers()
 std::vector<std::string> PCBViewerEmbedder::getNetNames() const {
     std::vector<std::string> nets;
     if (!m_pcbData) return nets;
-    nets.reserve(m_pcbData->pins.size());
-    std::unordered_set<std::string> uniq;
-    for (const auto &p: m_pcbData->pins) {
-    if (p.net.empty() || p.net=="UNCONNECTED") continue;
-    std::string up = p.net; std::transform(up.begin(), up.end(), up.begin(), ::toupper);
-    if (up=="GND" || up=="GROUND" || up=="VSS" || up=="AGND" || up=="DGND" || up=="PGND" || up=="SGND" || up.rfind("GND",0)==0 || up.rfind("GROUND",0)==0) continue;
-        if (uniq.insert(p.net).second) nets.push_back(p.net);
-    }
-    std::sort(nets.begin(), nets.end());
+    // Net index already excludes unconnected/ground nets and is sorted by name
+    const auto &named = m_pcbData->net_index.named_nets;
+    nets.reserve(named.size());
+    for (uint32_t id : named) nets.push_back(m_pcbData->NetName(id));
     return nets;
 }
 
 void PCBViewerEmbedder::zoomToNet(const std::string& netName) {
     if (!m_renderer || !m_pcbData || netName.empty()) return;
-    float minx=0, miny=0, maxx=0, maxy=0; bool first=true;
-    for (const auto &pin: m_pcbData->pins) {
-        if (pin.net==netName) {
-            float x=pin.pos.x, y=pin.pos.y; // rotation applied later by renderer zoom-to-fit if needed
-            if (first) {
-                minx = maxx = x; miny = maxy = y; first = false;
-            } else {
-                if (x < minx) { minx = x; }
-                if (x > maxx) { maxx = x; }
-                if (y < miny) { miny = y; }
-                if (y > maxy) { maxy = y; }
-            }
-        }
-    }
-    if (first) return; // not found
+    // Pin bounding box precomputed per net (rotation applied later by renderer zoom-to-fit if needed)
+    BRDPoint netMin, netMax;
+    if (!m_pcbData->GetNetBoundingBox(m_pcbData->FindNetId(netName), netMin, netMax)) return; // not found
+    float minx=netMin.x, miny=netMin.y, maxx=netMax.x, maxy=netMax.y;
     // Center camera roughly: compute midpoint and set zoom to show bbox
     float cx=(minx+maxx)*0.5f;
     float cy=(miny+maxy)*0.5f;
@@ -1413,21 +1496,10 @@ void PCBViewerEmbedder::zoomToComponent(const std::string &ref) {
     int partIndex = -1; size_t idx=0;
     for (const auto &part : m_pcbData->parts) { if (part.name == ref) { partIndex = (int)idx; break;} ++idx; }
     if (partIndex < 0) return;
-    // compute bbox from pins belonging to part
-    float minx=0,miny=0,maxx=0,maxy=0; bool first=true;
-    for (const auto &pin: m_pcbData->pins) {
-        if ((int)pin.part == partIndex + 1) { // parts 1-indexed
-            float x=pin.pos.x, y=pin.pos.y;
-            if (first) { minx=maxx=x; miny=maxy=y; first=false; }
-            else {
-                if (x < minx) { minx = x; }
-                if (x > maxx) { maxx = x; }
-                if (y < miny) { miny = y; }
-                if (y > maxy) { maxy = y; }
-            }
-        }
-    }
-    if (first) return; // no pins
+    // bbox of the part's pins, precomputed by the part index
+    BRDPoint partMin, partMax;
+    if (!m_pcbData->GetPartPinBoundingBox(static_cast<size_t>(partIndex), partMin, partMax)) return; // no pins
+    float minx=partMin.x, miny=partMin.y, maxx=partMax.x, maxy=partMax.y;
     // camera only; do not implicitly change highlight state here so caller can control clearing
     float cx=(minx+maxx)*0.5f;
     float cy=(miny+maxy)*0.5f;
@@ -1480,30 +1552,31 @@ void PCBViewerEmbedder::displayPinHoverInfo()
                          ImGuiWindowFlags_NoMove | ImGuiWindowFlags_AlwaysAutoResize |
                          ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing)) {
 
+            const std::string& pinSnum = m_pcbData->PinSnum(pin);
+            const std::string& pinName = m_pcbData->PinName(pin);
+            const std::string& pinNet = m_pcbData->PinNet(pin);
+
             // Pin-centric hover info: show Pin Number prominently
             // Prefer snum (explicit pin number), fall back to name
             const char* pinNumber = nullptr;
-            if (!pin.snum.empty()) {
-                pinNumber = pin.snum.c_str();
-            } else if (!pin.name.empty()) {
-                pinNumber = pin.name.c_str();
+            if (!pinSnum.empty()) {
+                pinNumber = pinSnum.c_str();
+            } else if (!pinName.empty()) {
+                pinNumber = pinName.c_str();
             }
             ImGui::Text("Pin Number: %s", pinNumber ? pinNumber : "N/A");
 
             // If the pin has a distinct name different from the number, show it as well
-            if (!pin.name.empty() && pin.name != pin.snum) {
-                ImGui::Text("Pin Name: %s", pin.name.c_str());
+            if (!pinName.empty() && pin.name_id != pin.snum_id) {
+                ImGui::Text("Pin Name: %s", pinName.c_str());
             }
 
             // Optional context: Net name and number of connected pins on that net
-            if (!pin.net.empty()) {
-                ImGui::Text("Net: %s", pin.net.c_str());
+            if (!pinNet.empty()) {
+                ImGui::Text("Net: %s", pinNet.c_str());
 
-                if (pin.net != "UNCONNECTED") {
-                    int connectedPins = 0;
-                    for (const auto& otherPin : m_pcbData->pins) {
-                        if (otherPin.net == pin.net) connectedPins++;
-                    }
+                if (pin.net_id != kUnconnectedNetId) {
+                    int connectedPins = static_cast<int>(m_pcbData->PinsOnNet(pin.net_id).size());
                     ImGui::Text("Connected Pins: %d", connectedPins);
                 }
             }
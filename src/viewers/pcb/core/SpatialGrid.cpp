@@ -0,0 +1,147 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Grid side limit; keeps the offset table bounded for degenerate inputs
+constexpr int kMaxCellsPerSide = 2048;
+// Target cell occupancy
+constexpr double kItemsPerCell = 4.0;
+}
+
+void SpatialGrid::Clear() {
+    m_boxes.clear();
+    m_first_cell.clear();
+    m_marks.clear();
+    m_cell_offsets.clear();
+    m_items.clear();
+    m_cols = m_rows = 0;
+}
+
+void SpatialGrid::Build(const std::vector<Box>& boxes) {
+    Clear();
+    m_boxes = boxes;
+
+    size_t count = 0;
+    float min_x = 0.f, min_y = 0.f, max_x = 0.f, max_y = 0.f;
+    for (const Box& b : m_boxes) {
+        if (b.IsEmpty()) continue;
+        if (count++ == 0) {
+            min_x = b.min_x; min_y = b.min_y; max_x = b.max_x; max_y = b.max_y;
+        } else {
+            min_x = std::min(min_x, b.min_x); min_y = std::min(min_y, b.min_y);
+            max_x = std::max(max_x, b.max_x); max_y = std::max(max_y, b.max_y);
+        }
+    }
+    if (count == 0) {
+        m_boxes.clear();
+        return;
+    }
+
+    // About kItemsPerCell items per cell, with cells as square as the bounds allow
+    float width = std::max(max_x - min_x, 1.0f);
+    float height = std::max(max_y - min_y, 1.0f);
+    double cells = static_cast<double>(count) / kItemsPerCell;
+    double cols = std::ceil(std::sqrt(cells * width / height));
+    m_cols = static_cast<int>(std::clamp(cols, 1.0, static_cast<double>(kMaxCellsPerSide)));
+    m_rows = static_cast<int>(std::clamp(std::ceil(cells / m_cols), 1.0, static_cast<double>(kMaxCellsPerSide)));
+    m_min_x = min_x;
+    m_min_y = min_y;
+    m_max_x = max_x;
+    m_max_y = max_y;
+    m_inv_cell_w = m_cols / width;
+    m_inv_cell_h = m_rows / height;
+
+    // Count, prefix-sum, then fill in item order so every cell list is ascending
+    const size_t cell_count = static_cast<size_t>(m_cols) * m_rows;
+    m_cell_offsets.assign(cell_count + 1, 0);
+    for (const Box& b : m_boxes) {
+        if (b.IsEmpty()) continue;
+        int c0 = ColumnOf(b.min_x), c1 = ColumnOf(b.max_x);
+        int r0 = RowOf(b.min_y), r1 = RowOf(b.max_y);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) m_cell_offsets[static_cast<size_t>(r) * m_cols + c + 1]++;
+        }
+    }
+    for (size_t c = 0; c < cell_count; ++c) m_cell_offsets[c + 1] += m_cell_offsets[c];
+
+    m_items.resize(m_cell_offsets[cell_count]);
+    m_first_cell.assign(m_boxes.size(), Cell{});
+    std::vector<uint32_t> cursor(m_cell_offsets.begin(), m_cell_offsets.end() - 1);
+    for (size_t id = 0; id < m_boxes.size(); ++id) {
+        const Box& b = m_boxes[id];
+        if (b.IsEmpty()) continue;
+        int c0 = ColumnOf(b.min_x), c1 = ColumnOf(b.max_x);
+        int r0 = RowOf(b.min_y), r1 = RowOf(b.max_y);
+        m_first_cell[id] = {static_cast<uint16_t>(c0), static_cast<uint16_t>(r0)};
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) m_items[cursor[static_cast<size_t>(r) * m_cols + c]++] = static_cast<uint32_t>(id);
+        }
+    }
+}
+
+void SpatialGrid::Query(const Box& area, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (m_cols == 0 || area.IsEmpty() || !area.Overlaps({m_min_x, m_min_y, m_max_x, m_max_y})) return;
+
+    int c0 = ColumnOf(area.min_x), c1 = ColumnOf(area.max_x);
+    int r0 = RowOf(area.min_y), r1 = RowOf(area.max_y);
+
+    // Zoomed out over a large part of the grid: a straight pass over the boxes
+    // is cheaper than gathering and re-ordering cell lists
+    const size_t view_cells = static_cast<size_t>(c1 - c0 + 1) * (r1 - r0 + 1);
+    if (view_cells * 12 >= static_cast<size_t>(m_cols) * m_rows) {
+        for (size_t id = 0; id < m_boxes.size(); ++id) {
+            if (!m_boxes[id].IsEmpty() && m_boxes[id].Overlaps(area)) out.push_back(static_cast<uint32_t>(id));
+        }
+        return;
+    }
+
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            size_t cell = static_cast<size_t>(r) * m_cols + c;
+            for (uint32_t i = m_cell_offsets[cell]; i < m_cell_offsets[cell + 1]; ++i) {
+                uint32_t id = m_items[i];
+                const Box& b = m_boxes[id];
+                if (!b.Overlaps(area)) continue;
+                // An item spanning several cells is reported only from the first
+                // cell (lowest row, then column) it shares with the area
+                if (std::max(c0, static_cast<int>(m_first_cell[id].col)) != c) continue;
+                if (std::max(r0, static_cast<int>(m_first_cell[id].row)) != r) continue;
+                out.push_back(id);
+            }
+        }
+    }
+
+    // Back to item order: sort small results, sweep a mark table for large ones
+    if (out.size() * 64 < m_boxes.size()) {
+        std::sort(out.begin(), out.end());
+    } else {
+        m_marks.assign(m_boxes.size(), 0);
+        for (uint32_t id : out) m_marks[id] = 1;
+        out.clear();
+        for (size_t id = 0; id < m_marks.size(); ++id) {
+            if (m_marks[id]) out.push_back(static_cast<uint32_t>(id));
+        }
+    }
+}
+
+// Clamped to the grid; truncation equals floor once negatives are clamped to 0
+int SpatialGrid::ColumnOf(float x) const {
+    float t = (x - m_min_x) * m_inv_cell_w;
+    if (!(t > 0.f)) return 0;
+    return t >= static_cast<float>(m_cols) ? m_cols - 1 : static_cast<int>(t);
+}
+
+int SpatialGrid::RowOf(float y) const {
+    float t = (y - m_min_y) * m_inv_cell_h;
+    if (!(t > 0.f)) return 0;
+    return t >= static_cast<float>(m_rows) ? m_rows - 1 : static_cast<int>(t);
+}
+
+bool SpatialGrid::CellAt(float x, float y, size_t& cell) const {
+    if (m_cols == 0 || !(x >= m_min_x) || !(y >= m_min_y)) return false;
+    if (x > m_max_x || y > m_max_y) return false;
+    cell = static_cast<size_t>(RowOf(y)) * m_cols + ColumnOf(x);
+    return true;
+}
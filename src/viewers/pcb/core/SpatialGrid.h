@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Static uniform grid over axis-aligned boxes, built once after load and
+// queried for hit tests and view culling. Each item is listed in every cell its box overlaps,
+// in ascending item order, so a point query sees the lowest index first -
+// the same answer as a linear scan.
+class SpatialGrid {
+public:
+    struct Box {
+        float min_x = 0.f, min_y = 0.f, max_x = -1.f, max_y = -1.f; // empty by default
+
+        bool IsEmpty() const { return min_x > max_x || min_y > max_y; }
+        bool Contains(float x, float y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+        bool Overlaps(const Box& o) const { return min_x <= o.max_x && o.min_x <= max_x && min_y <= o.max_y && o.min_y <= max_y; }
+    };
+
+    // Item ids are indices into boxes; empty boxes are left out
+    void Build(const std::vector<Box>& boxes);
+    void Clear();
+    bool IsEmpty() const { return m_items.empty(); }
+
+    // First item (lowest id) whose box contains (x, y) and for which accept(id)
+    // returns true, or -1
+    template <typename Accept>
+    int FindFirst(float x, float y, Accept&& accept) const {
+        size_t cell;
+        if (!CellAt(x, y, cell)) return -1;
+        for (uint32_t i = m_cell_offsets[cell]; i < m_cell_offsets[cell + 1]; ++i) {
+            uint32_t id = m_items[i];
+            if (m_boxes[id].Contains(x, y) && accept(id)) return static_cast<int>(id);
+        }
+        return -1;
+    }
+
+    int FindFirst(float x, float y) const {
+        return FindFirst(x, y, [](uint32_t) { return true; });
+    }
+
+    // Replaces out with the ids of all items overlapping area, ascending and
+    // unique (draw order is preserved when rendering from the result)
+    void Query(const Box& area, std::vector<uint32_t>& out) const;
+
+private:
+    bool CellAt(float x, float y, size_t& cell) const;
+    int ColumnOf(float x) const;
+    int RowOf(float y) const;
+
+    struct Cell { uint16_t col = 0, row = 0; };
+
+    std::vector<Box> m_boxes;
+    std::vector<Cell> m_first_cell; // lowest cell of each item, for de-duplicating area queries
+    std::vector<uint32_t> m_cell_offsets; // CSR: cell c owns m_items[offsets[c], offsets[c+1])
+    std::vector<uint32_t> m_items;
+    mutable std::vector<uint8_t> m_marks; // Query scratch
+    float m_min_x = 0.f, m_min_y = 0.f, m_max_x = 0.f, m_max_y = 0.f;
+    float m_inv_cell_w = 0.f, m_inv_cell_h = 0.f;
+    int m_cols = 0, m_rows = 0;
+};
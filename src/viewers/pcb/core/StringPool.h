@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+// Interning table mapping strings to dense integer ids (0, 1, 2, ...), so hot
+// loops can compare net/pin names as integers. Id 0 is always the empty string.
+// References returned by Get() stay valid until Clear(), however many strings
+// are interned after them.
+class StringPool {
+public:
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    StringPool() { Clear(); }
+
+    void Clear() {
+        m_ids.clear();
+        m_strings.clear();
+        Intern(std::string());
+    }
+
+    uint32_t Intern(const std::string& s) {
+        auto it = m_ids.find(s);
+        if (it != m_ids.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(s);
+        m_ids.emplace(m_strings.back(), id);
+        return id;
+    }
+
+    // Id of s, or kInvalid if it was never interned
+    uint32_t Find(const std::string& s) const {
+        auto it = m_ids.find(s);
+        return it != m_ids.end() ? it->second : kInvalid;
+    }
+
+    const std::string& Get(uint32_t id) const {
+        return id < m_strings.size() ? m_strings[id] : m_strings[0];
+    }
+
+    size_t size() const { return m_strings.size(); }
+
+private:
+    std::unordered_map<std::string, uint32_t> m_ids;
+    std::deque<std::string> m_strings;
+};
@@ -1,30 +1,20 @@
 #include "Utils.h"
+#include "MappedFile.h"
 #include <fstream>
 #include <algorithm>
 #include <cctype>
+#include <atomic>
+#include <thread>
 
 namespace Utils {
 
 std::vector<char> LoadFile(const std::string& filepath) {
-    std::vector<char> data;
-    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
-    
-    if (!file.is_open()) {
-        LOG_ERROR("Failed to open file: " + filepath);
-        return data;
+    // Callers that only need to read should use MappedFile directly and skip this copy
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        return {};
     }
-    
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    data.resize(size);
-    if (!file.read(data.data(), size)) {
-        LOG_ERROR("Failed to read file: " + filepath);
-        data.clear();
-    }
-    
-    file.close();
-    return data;
+    return std::vector<char>(file.data(), file.data() + file.size());
 }
 
 bool FileExists(const std::string& filepath) {
@@ -47,4 +37,40 @@ std::string ToLower(const std::string& str) {
     return result;
 }
 
+void ParallelFor(size_t count, const std::function<void(size_t)>& fn, size_t min_parallel_count) {
+    size_t thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+    thread_count = std::min(thread_count, count);
+
+    if (thread_count <= 1 || count < min_parallel_count) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+    for (size_t t = 1; t < thread_count; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker(); // calling thread takes a share too
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+void ParallelForBlocks(size_t count, size_t block_size, const std::function<void(size_t, size_t)>& fn) {
+    if (block_size == 0) block_size = 1;
+    const size_t blocks = (count + block_size - 1) / block_size;
+    ParallelFor(blocks, [&](size_t b) {
+        fn(b * block_size, std::min(count, (b + 1) * block_size));
+    });
+}
+
 }
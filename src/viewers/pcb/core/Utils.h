@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <functional>
 
 // Simple logging macros
 #define LOG_ERROR(msg) std::cerr << "ERROR: " << msg << std::endl
@@ -17,7 +18,7 @@
     }
 
 namespace Utils {
-    // Load entire file into memory
+    // Load entire file into an owned buffer (see MappedFile for a read-only, copy-free view)
     std::vector<char> LoadFile(const std::string& filepath);
     
     // Check if file exists
@@ -28,4 +29,13 @@ namespace Utils {
     
     // Convert string to lowercase
     std::string ToLower(const std::string& str);
+
+    // Run fn(i) for every i in [0, count) on a pool of worker threads.
+    // Indices are handed out dynamically; fn must only touch per-index state.
+    // Runs inline when count is small or only one hardware thread is available.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn, size_t min_parallel_count = 2);
+
+    // ParallelFor over [0, count) in ranges of block_size items: fn(begin, end).
+    // For cheap per-item work, where one task per item would cost more than the item
+    void ParallelForBlocks(size_t count, size_t block_size, const std::function<void(size_t, size_t)>& fn);
 }
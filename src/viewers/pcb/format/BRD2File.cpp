@@ -1,4 +1,6 @@
 #include "BRD2File.h"
+#include "MappedFile.h"
+#include "TextCursor.h"
 #include "Utils.h"
 #include <cctype>
 #include <iostream>
@@ -8,69 +10,14 @@
 #include <fstream>
 #include <algorithm>
 
-// Helper macros for parsing
-#define READ_INT() strtol(p, &p, 10)
-#define READ_UINT() [&]() { \
-    int value = strtol(p, &p, 10); \
-    if (value < 0) { \
-        error_msg = "Negative value where unsigned expected"; \
-        return 0u; \
-    } \
-    return static_cast<unsigned int>(value); \
-}()
-#define READ_DOUBLE() strtod(p, &p)
-#define READ_STR() [&]() { \
-    while ((*p) && (isspace((uint8_t)*p))) ++p; \
-    s = p; \
-    while ((*p) && (!isspace((uint8_t)*p))) ++p; \
-    *p = 0; \
-    p++; \
-    return std::string(s); \
-}()
-
 #define ENSURE_OR_FAIL(condition, error_msg_str, action) \
     if (!(condition)) { \
         this->error_msg = error_msg_str; \
         action; \
     }
 
-// Helper function to split buffer into lines
-void stringfile_brd2(char *buffer, std::vector<char*> &lines) {
-    char *s;
-    size_t count, i;
-
-    // Two passes through: first time count lines, second time set them
-    for (i = 0; i < 2; ++i) {
-        s = buffer;
-        if (i == 1) lines[0] = s;
-        count = 1; // was '1', but C arrays are 0-indexed
-        while (*s) {
-            if (*s == '\n' || *s == '\r') {
-                // If this is the 2nd pass, then terminate the line at the first line break char
-                if (i == 1) *s = 0;
-                s++; // next char
-                // if the termination is a CRLF combo, then jump to the next char
-                if ((*s == '\r') || (*s == '\n')) s++;
-                // if the char is valid (first after line break), set up the next item in the line array
-                if (*s) { // it's not over yet
-                    if (i == 1) {
-                        lines[count] = s;
-                    }
-                    ++count;
-                }
-            }
-            s++;
-        } // while s
-
-        // Generate the required array to hold all the line starting points
-        if (i == 0) {
-            lines.resize(count);
-        }
-    }
-}
-
 // Helper function to find string in buffer
-bool find_str_in_buf_brd2(const std::string& needle, const std::vector<char>& buf) {
+bool find_str_in_buf_brd2(const std::string& needle, ByteView buf) {
     if (needle.length() > buf.size()) return false;
     auto it = std::search(buf.begin(), buf.end(), needle.begin(), needle.end());
     return it != buf.end();
@@ -78,24 +25,16 @@ bool find_str_in_buf_brd2(const std::string& needle, const std::vector<char>& bu
 
 std::unique_ptr<BRD2File> BRD2File::LoadFromFile(const std::string& filepath) {
     std::cout << "LoadFromFile: Opening BRD2 file " << filepath << std::endl;
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
         std::cerr << "Error: Cannot open BRD2 file " << filepath << std::endl;
         return nullptr;
     }
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(fileSize);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
     std::cout << "LoadFromFile: Creating BRD2File object" << std::endl;
     auto brd2File = std::make_unique<BRD2File>();
     std::cout << "LoadFromFile: Calling Load() method" << std::endl;
-    if (brd2File->Load(buffer, filepath)) {
+    if (brd2File->Load(ByteView(file.data(), file.size()), filepath)) {
         std::cout << "LoadFromFile: Load() succeeded, returning brd2File" << std::endl;
         return brd2File;
     }
@@ -103,174 +42,173 @@ std::unique_ptr<BRD2File> BRD2File::LoadFromFile(const std::string& filepath) {
     return nullptr;
 }
 
-bool BRD2File::VerifyFormat(const std::vector<char>& buffer) {
+bool BRD2File::VerifyFormat(ByteView buffer) {
     return find_str_in_buf_brd2("BRDOUT:", buffer) && find_str_in_buf_brd2("NETS:", buffer);
 }
 
-bool BRD2File::Load(const std::vector<char>& buf, const std::string& /*filepath*/) {
+bool BRD2File::Load(ByteView buf, const std::string& /*filepath*/) {
     auto buffer_size = buf.size();
     std::unordered_map<int, std::string> nets; // Map between net id and net name
     unsigned int num_nets = 0;
     BRDPoint max{0, 0}; // Top-right board boundary
 
     ENSURE_OR_FAIL(buffer_size > 4, "Buffer too small", return false);
-    size_t file_buf_size = 3 * (1 + buffer_size);
-    file_buf = (char *)calloc(1, file_buf_size);
-    ENSURE_OR_FAIL(file_buf != nullptr, "Memory allocation failed", return false);
-
-    std::copy(buf.begin(), buf.end(), file_buf);
-    file_buf[buffer_size] = 0;
-    // This is for fixing degenerate utf8
-    char *arena = &file_buf[buffer_size + 1];
-    char *arena_end = file_buf + file_buf_size - 1;
-    *arena_end = 0;
-    
-    // Suppress unused variable warning
-    (void)arena;
-
-    int current_block = 0;
-
-    std::vector<char*> lines;
-    stringfile_brd2(file_buf, lines);
-
-    for (char *line : lines) {
-        while (isspace((uint8_t)*line)) line++;
-        if (!line[0]) continue;
-
-        char *p = line;
-        char *s;
-
-        if (strstr(line, "BRDOUT:") == line) {
-            current_block = 1;
-            p += 7; // Skip "BRDOUT:"
-            num_format = READ_UINT();
-            max.x = READ_INT();
-            max.y = READ_INT();
-            continue;
-        }
-        if (strstr(line, "NETS:") == line) {
-            current_block = 2;
-            p += 5; // Skip "NETS:"
-            num_nets = READ_UINT();
-            continue;
-        }
-        if (strstr(line, "PARTS:") == line) {
-            current_block = 3;
-            p += 6; // Skip "PARTS:"
-            num_parts = READ_UINT();
-            continue;
-        }
-        if (strstr(line, "PINS:") == line) {
-            current_block = 4;
-            p += 5; // Skip "PINS:"
-            num_pins = READ_UINT();
-            continue;
-        }
-        if (strstr(line, "NAILS:") == line) {
-            current_block = 5;
-            p += 6; // Skip "NAILS:"
-            num_nails = READ_UINT();
-            continue;
+    const std::string_view text(buf.data(), buffer_size);
+
+    // Section headers (which carry the record counts) are found in one pass;
+    // pins and nails, the bulk of a large file, are then parsed in parallel
+    // chunks. Sections are handled in file order, so a chunk sees the nets
+    // declared before its section just like a serial parse
+    static constexpr std::string_view kHeaders[] = {"BRDOUT:", "NETS:", "PARTS:", "PINS:", "NAILS:"};
+    const std::vector<TextSection> sections = SplitTextSections(text, [](std::string_view line) {
+        for (size_t i = 0; i < std::size(kHeaders); ++i) {
+            if (line.substr(0, kHeaders[i].size()) == kHeaders[i]) return static_cast<int>(i) + 1;
         }
-
-        switch (current_block) {
+        return 0;
+    });
+
+    bool negative = false; // an unsigned field held a negative number
+    auto note_negative = [&](size_t, bool) { negative = true; };
+    auto net_name = [&](int netid, bool& found) -> const std::string& {
+        static const std::string unconnected = "UNCONNECTED";
+        auto it = nets.find(netid);
+        found = it != nets.end();
+        return found ? it->second : unconnected;
+    };
+
+    for (const TextSection& section : sections) {
+        TextCursor header(section.header.substr(kHeaders[section.block - 1].size()));
+        switch (section.block) {
             case 1: { // Format
-                if (format.size() >= num_format) break;
-                BRDPoint point;
-                point.x = READ_INT();
-                point.y = READ_INT();
-                if (point.x > max.x || point.y > max.y) {
-                    error_msg = "Format point exceeds board boundary";
-                    return false;
-                }
-                format.push_back(point);
+                num_format = header.ReadUInt(&negative);
+                max.x = header.ReadInt();
+                max.y = header.ReadInt();
+                bool parsed = ForEachTextLine(section.body, [&](std::string_view line) {
+                    if (format.size() >= num_format) return true;
+                    TextCursor in(line);
+                    BRDPoint point;
+                    point.x = in.ReadInt();
+                    point.y = in.ReadInt();
+                    if (point.x > max.x || point.y > max.y) {
+                        error_msg = "Format point exceeds board boundary";
+                        return false;
+                    }
+                    format.push_back(point);
+                    return true;
+                });
+                if (!parsed) return false;
             } break;
 
             case 2: { // Nets
-                if (nets.size() >= num_nets) break;
-                int id = READ_UINT();
-                nets[id] = READ_STR();
+                num_nets = header.ReadUInt(&negative);
+                ForEachTextLine(section.body, [&](std::string_view line) {
+                    if (nets.size() >= num_nets) return true;
+                    TextCursor in(line);
+                    int id = in.ReadUInt(&negative);
+                    nets[id] = in.ReadStr();
+                    return true;
+                });
             } break;
 
             case 3: { // PARTS
-                if (parts.size() >= num_parts) break;
-                BRDPart part;
-
-                part.name = READ_STR();
-                part.p1.x = READ_INT();
-                part.p1.y = READ_INT();
-                part.p2.x = READ_INT();
-                part.p2.y = READ_INT();
-                part.end_of_pins = READ_UINT(); // Warning: not end but beginning in this format
-                part.part_type = BRDPartType::SMD;
-                int side = READ_UINT();
-                if (side == 1)
-                    part.mounting_side = BRDPartMountingSide::Top; // SMD part on top
-                else if (side == 2)
-                    part.mounting_side = BRDPartMountingSide::Bottom; // SMD part on bottom
-                else //0
-                    part.mounting_side = BRDPartMountingSide::Both;
-
-                parts.push_back(part);
+                num_parts = header.ReadUInt(&negative);
+                ForEachTextLine(section.body, [&](std::string_view line) {
+                    if (parts.size() >= num_parts) return true;
+                    TextCursor in(line);
+                    BRDPart part;
+
+                    part.name = in.ReadStr();
+                    part.p1.x = in.ReadInt();
+                    part.p1.y = in.ReadInt();
+                    part.p2.x = in.ReadInt();
+                    part.p2.y = in.ReadInt();
+                    part.end_of_pins = in.ReadUInt(&negative); // Warning: not end but beginning in this format
+                    part.part_type = BRDPartType::SMD;
+                    int side = in.ReadUInt(&negative);
+                    if (side == 1)
+                        part.mounting_side = BRDPartMountingSide::Top; // SMD part on top
+                    else if (side == 2)
+                        part.mounting_side = BRDPartMountingSide::Bottom; // SMD part on bottom
+                    else //0
+                        part.mounting_side = BRDPartMountingSide::Both;
+
+                    parts.push_back(std::move(part));
+                    return true;
+                });
             } break;
 
             case 4: { // PINS
-                if (pins.size() >= num_pins) break;
-                BRDPin pin;
-
-                pin.pos.x = READ_INT();
-                pin.pos.y = READ_INT();
-                int netid = READ_UINT();
-                unsigned int side = READ_UINT();
-                if (side == 1)
-                    pin.side = BRDPinSide::Top;
-                else if (side == 2)
-                    pin.side = BRDPinSide::Bottom;
-                else //0
-                    pin.side = BRDPinSide::Both;
-
-                auto it = nets.find(netid);
-                if (it != nets.end()) {
-                    pin.net = it->second;
-                } else {
-                    pin.net = "UNCONNECTED";
+                num_pins = header.ReadUInt(&negative);
+                const size_t first = pins.size();
+                ParseTextRecords(section.body, num_pins, pins, [&](std::string_view line, BRDPin& pin) {
+                    TextCursor in(line);
+                    bool negative = false;
+
+                    pin.pos.x = in.ReadInt();
+                    pin.pos.y = in.ReadInt();
+                    pin.net_id = in.ReadUInt(&negative); // the file's net id until mapped below
+                    unsigned int side = in.ReadUInt(&negative);
+                    if (side == 1)
+                        pin.side = BRDPinSide::Top;
+                    else if (side == 2)
+                        pin.side = BRDPinSide::Bottom;
+                    else //0
+                        pin.side = BRDPinSide::Both;
+
+                    pin.probe = 1;
+                    pin.part = 0;
+                    return negative;
+                }, note_negative);
+
+                // Workers cannot intern into string_pool; intern each net once here
+                std::unordered_map<uint32_t, uint32_t> net_ids; // file net id -> string_pool id
+                for (size_t i = first; i < pins.size(); ++i) {
+                    auto inserted = net_ids.emplace(pins[i].net_id, kUnconnectedNetId);
+                    if (inserted.second) {
+                        bool found = false;
+                        inserted.first->second = string_pool.Intern(net_name(static_cast<int>(pins[i].net_id), found));
+                    }
+                    pins[i].net_id = inserted.first->second;
                 }
-
-                pin.probe = 1;
-                pin.part = 0;
-                pins.push_back(pin);
             } break;
 
             case 5: { // NAILS
-                if (nails.size() >= num_nails) break;
-                BRDNail nail;
-
-                nail.probe = READ_UINT();
-                nail.pos.x = READ_INT();
-                nail.pos.y = READ_INT();
-                int netid = READ_UINT();
-
-                auto inet = nets.find(netid);
-                if (inet != nets.end())
-                    nail.net = inet->second;
-                else {
-                    nail.net = "UNCONNECTED";
-                    std::cerr << "Missing net id: " << netid << std::endl;
-                }
-
-                bool nail_is_top = READ_UINT() == 1;
-                if (nail_is_top) {
-                    nail.side = BRDPartMountingSide::Top;
-                } else {
-                    nail.side = BRDPartMountingSide::Bottom;
-                    nail.pos.y = max.y - nail.pos.y;
-                }
-                nails.push_back(nail);
-
+                // A nail's note is its unknown net id (-1 if none); negative
+                // fields are flagged separately since ids are read as unsigned
+                struct NailNote {
+                    bool negative = false;
+                    int missing_net = -1;
+                    explicit operator bool() const { return negative || missing_net >= 0; }
+                };
+                num_nails = header.ReadUInt(&negative);
+                ParseTextRecords(section.body, num_nails, nails, [&](std::string_view line, BRDNail& nail) {
+                    TextCursor in(line);
+                    NailNote note;
+                    bool found = false;
+
+                    nail.probe = in.ReadUInt(&note.negative);
+                    nail.pos.x = in.ReadInt();
+                    nail.pos.y = in.ReadInt();
+                    int netid = in.ReadUInt(&note.negative);
+                    nail.net = net_name(netid, found);
+                    if (!found) note.missing_net = netid;
+
+                    bool nail_is_top = in.ReadUInt(&note.negative) == 1;
+                    if (nail_is_top) {
+                        nail.side = BRDPartMountingSide::Top;
+                    } else {
+                        nail.side = BRDPartMountingSide::Bottom;
+                        nail.pos.y = max.y - nail.pos.y;
+                    }
+                    return note;
+                }, [&](size_t, const NailNote& note) {
+                    if (note.negative) negative = true;
+                    if (note.missing_net >= 0) std::cerr << "Missing net id: " << note.missing_net << std::endl;
+                });
             } break;
-            default: continue;
         }
     }
+    if (negative) error_msg = "Negative value where unsigned expected";
 
     if (num_format != format.size()) {
         error_msg = "Format count mismatch";
@@ -313,6 +251,7 @@ bool BRD2File::Load(const std::vector<char>& buf, const std::string& /*filepath*
                 pei = pins.size();
             } else {
                 pei = parts[i + 1].end_of_pins; // Again, not end of pins but beginning
+                pei = std::min<int>(pei, pins.size()); // a truncated PINS: section
             }
 
             while (cpi < pei) {
@@ -352,15 +291,16 @@ bool BRD2File::Load(const std::vector<char>& buf, const std::string& /*filepath*
         pin.probe = nail.probe;
         pin.part = (nail.side == BRDPartMountingSide::Top) ? parts.size() : parts.size() - 1; // Use dummy parts
         pin.side = (nail.side == BRDPartMountingSide::Top) ? BRDPinSide::Top : BRDPinSide::Bottom;
-        pin.net = nail.net;
+        SetPinNet(pin, nail.net);
         pins.push_back(pin);
     }
 
-    valid = current_block != 0;
+    valid = !sections.empty();
     
     // Generate rendering geometry for pins
     if (valid) {
         GenerateRenderingGeometry();
+        BuildIndices();
     }
     
     std::cout << "BRD2 file parsed successfully:" << std::endl;
@@ -383,12 +323,6 @@ void BRD2File::GenerateRenderingGeometry() {
     outline_segments.clear();
     part_outline_segments.clear();
     
-    // Calculate board dimensions for layer separation
-    BRDPoint min_point, max_point;
-    GetBoundingBox(min_point, max_point);
-    float board_width = max_point.x - min_point.x;
-    float board_height = max_point.y - min_point.y;
-    
     // No offset - both sides overlap in the same position
     float bottom_side_offset_x = 0.0f;
     float bottom_side_offset_y = 0.0f; 
@@ -410,92 +344,97 @@ void BRD2File::GenerateRenderingGeometry() {
         }
     }
     
-    // Generate part outline segments from parts
-    for (const auto& part : parts) {
-        bool is_bottom_side = (part.mounting_side == BRDPartMountingSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        // Use p1 and p2 points to create part outline
-        if (part.p1 != part.p2) {
-            // Create rectangle from p1 and p2, mirror Y coordinates if bottom side
-            float p1_y = is_bottom_side ? -part.p1.y : part.p1.y;
-            float p2_y = is_bottom_side ? -part.p2.y : part.p2.y;
-            
-            BRDPoint top_left = {std::min(part.p1.x, part.p2.x) + offset_x, std::max(p1_y, p2_y) + offset_y};
-            BRDPoint top_right = {std::max(part.p1.x, part.p2.x) + offset_x, std::max(p1_y, p2_y) + offset_y};
-            BRDPoint bottom_right = {std::max(part.p1.x, part.p2.x) + offset_x, std::min(p1_y, p2_y) + offset_y};
-            BRDPoint bottom_left = {std::min(part.p1.x, part.p2.x) + offset_x, std::min(p1_y, p2_y) + offset_y};
-            
-            part_outline_segments.push_back({top_left, top_right});
-            part_outline_segments.push_back({top_right, bottom_right});
-            part_outline_segments.push_back({bottom_right, bottom_left});
-            part_outline_segments.push_back({bottom_left, top_left});
-        } else {
-            // Create a small square around the point, mirror Y coordinate if bottom side
-            float part_size = 10.0f;
-            float center_y = is_bottom_side ? -part.p1.y : part.p1.y;
-            BRDPoint center = {part.p1.x + offset_x, center_y + offset_y};
-            BRDPoint top_left = {center.x - part_size/2, center.y + part_size/2};
-            BRDPoint top_right = {center.x + part_size/2, center.y + part_size/2};
-            BRDPoint bottom_right = {center.x + part_size/2, center.y - part_size/2};
-            BRDPoint bottom_left = {center.x - part_size/2, center.y - part_size/2};
-            
-            part_outline_segments.push_back({top_left, top_right});
-            part_outline_segments.push_back({top_right, bottom_right});
-            part_outline_segments.push_back({bottom_right, bottom_left});
-            part_outline_segments.push_back({bottom_left, top_left});
-        }
-    }
-    
-    // Generate circles for pins
-    for (const auto& pin : pins) {
-        bool is_bottom_side = (pin.side == BRDPinSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        // Use pin radius if available, otherwise use a default radius
-        float radius = static_cast<float>(pin.radius);
-        if (radius <= 0.0f) {
-            radius = 6.5f; // Default radius similar to XZZPCBFile
+    // Part outlines and pin/nail circles are independent per item: each block
+    // fills its own slots, so the order matches a serial pass
+    constexpr size_t kGeometryBlock = 4096;
+
+    // Generate part outline segments from parts, four per part
+    part_outline_segments.resize(parts.size() * 4);
+    Utils::ParallelForBlocks(parts.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& part = parts[n];
+            auto* segments = &part_outline_segments[n * 4];
+            bool is_bottom_side = (part.mounting_side == BRDPartMountingSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
+
+            // Use p1 and p2 points to create part outline
+            if (part.p1 != part.p2) {
+                // Create rectangle from p1 and p2, mirror Y coordinates if bottom side
+                float p1_y = is_bottom_side ? -part.p1.y : part.p1.y;
+                float p2_y = is_bottom_side ? -part.p2.y : part.p2.y;
+
+                BRDPoint top_left = {std::min(part.p1.x, part.p2.x) + offset_x, std::max(p1_y, p2_y) + offset_y};
+                BRDPoint top_right = {std::max(part.p1.x, part.p2.x) + offset_x, std::max(p1_y, p2_y) + offset_y};
+                BRDPoint bottom_right = {std::max(part.p1.x, part.p2.x) + offset_x, std::min(p1_y, p2_y) + offset_y};
+                BRDPoint bottom_left = {std::min(part.p1.x, part.p2.x) + offset_x, std::min(p1_y, p2_y) + offset_y};
+
+                segments[0] = {top_left, top_right};
+                segments[1] = {top_right, bottom_right};
+                segments[2] = {bottom_right, bottom_left};
+                segments[3] = {bottom_left, top_left};
+            } else {
+                // Create a small square around the point, mirror Y coordinate if bottom side
+                float part_size = 10.0f;
+                float center_y = is_bottom_side ? -part.p1.y : part.p1.y;
+                BRDPoint center = {part.p1.x + offset_x, center_y + offset_y};
+                BRDPoint top_left = {center.x - part_size/2, center.y + part_size/2};
+                BRDPoint top_right = {center.x + part_size/2, center.y + part_size/2};
+                BRDPoint bottom_right = {center.x + part_size/2, center.y - part_size/2};
+                BRDPoint bottom_left = {center.x - part_size/2, center.y - part_size/2};
+
+                segments[0] = {top_left, top_right};
+                segments[1] = {top_right, bottom_right};
+                segments[2] = {bottom_right, bottom_left};
+                segments[3] = {bottom_left, top_left};
+            }
         }
-        
-        // Apply offset to pin position, mirror Y coordinate if bottom side
-        float pin_y = is_bottom_side ? -pin.pos.y : pin.pos.y;
-        BRDPoint pin_pos = {pin.pos.x + offset_x, pin_y + offset_y};
-        
-        // Create circle for pin with red color (top) or blue color (bottom)
-        float r = is_bottom_side ? 0.0f : 0.7f; // Blue for bottom, red for top
-        float g = 0.0f;
-        float b = is_bottom_side ? 0.7f : 0.0f;
-        BRDCircle circle(pin_pos, radius, r, g, b, 1.0f);
-        circles.push_back(circle);
-    }
-    
-    // Generate circles for nails (test points) with different color
-    for (const auto& nail : nails) {
-        bool is_bottom_side = (nail.side == BRDPartMountingSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        float radius = 4.0f; // Fixed radius for test points
-        
-        // Apply offset to nail position, mirror Y coordinate if bottom side
-        float nail_y = is_bottom_side ? -nail.pos.y : nail.pos.y;
-        BRDPoint nail_pos = {nail.pos.x + offset_x, nail_y + offset_y};
-        
-        // Create circle for nail with green color (top) or cyan color (bottom)
-        float r = 0.0f;
-        float g = 0.7f;
-        float b = is_bottom_side ? 0.7f : 0.0f;
-        BRDCircle circle(nail_pos, radius, r, g, b, 1.0f);
-        circles.push_back(circle);
-    }
-}
+    });
+
+    // Circles for pins, then for nails
+    circles.resize(pins.size() + nails.size());
+    Utils::ParallelForBlocks(pins.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& pin = pins[n];
+            bool is_bottom_side = (pin.side == BRDPinSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
+
+            // Use pin radius if available, otherwise use a default radius
+            float radius = static_cast<float>(pin.radius);
+            if (radius <= 0.0f) {
+                radius = 6.5f; // Default radius similar to XZZPCBFile
+            }
 
-BRD2File::~BRD2File() {
-    if (file_buf) {
-        free(file_buf);
-        file_buf = nullptr;
-    }
+            // Apply offset to pin position, mirror Y coordinate if bottom side
+            float pin_y = is_bottom_side ? -pin.pos.y : pin.pos.y;
+            BRDPoint pin_pos = {pin.pos.x + offset_x, pin_y + offset_y};
+
+            // Create circle for pin with red color (top) or blue color (bottom)
+            float r = is_bottom_side ? 0.0f : 0.7f; // Blue for bottom, red for top
+            float g = 0.0f;
+            float b = is_bottom_side ? 0.7f : 0.0f;
+            circles[n] = BRDCircle(pin_pos, radius, r, g, b, 1.0f);
+        }
+    });
+    Utils::ParallelForBlocks(nails.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& nail = nails[n];
+            bool is_bottom_side = (nail.side == BRDPartMountingSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
+
+            float radius = 4.0f; // Fixed radius for test points
+
+            // Apply offset to nail position, mirror Y coordinate if bottom side
+            float nail_y = is_bottom_side ? -nail.pos.y : nail.pos.y;
+            BRDPoint nail_pos = {nail.pos.x + offset_x, nail_y + offset_y};
+
+            // Create circle for nail with green color (top) or cyan color (bottom)
+            float r = 0.0f;
+            float g = 0.7f;
+            float b = is_bottom_side ? 0.7f : 0.0f;
+            circles[pins.size() + n] = BRDCircle(nail_pos, radius, r, g, b, 1.0f);
+        }
+    });
 }
@@ -5,18 +5,16 @@
 class BRD2File : public BRDFileBase {
 public:
     BRD2File() = default;
-    ~BRD2File();
+    ~BRD2File() = default;
 
     // Implementation of pure virtual methods
-    bool Load(const std::vector<char>& buffer, const std::string& filepath = "") override;
-    bool VerifyFormat(const std::vector<char>& buffer) override;
+    bool Load(ByteView buffer, const std::string& filepath = "") override;
+    bool VerifyFormat(ByteView buffer) override;
 
     // Static factory method
     static std::unique_ptr<BRD2File> LoadFromFile(const std::string& filepath);
 
 private:
-    char *file_buf = nullptr;
-    
     // Helper method to generate rendering geometry for pins
     void GenerateRenderingGeometry();
 };
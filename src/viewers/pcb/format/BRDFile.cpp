@@ -1,80 +1,36 @@
 #include "BRDFile.h"
+#include "MappedFile.h"
+#include "TextCursor.h"
 #include "Utils.h"
 #include <cctype>
 #include <stdexcept>
 #include <cstdint>
 #include <cstring>
+#include <new>
 #include <unordered_map>
 #include <fstream>
 #include <iostream>
 #include <algorithm>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BRD_DECODE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BRD_DECODE_SSE2 1
+#endif
+
 // Header for recognizing a BRD file
 decltype(BRDFile::signature) constexpr BRDFile::signature;
 
-// Helper macros for parsing
-#define READ_INT() strtol(p, &p, 10)
-#define READ_UINT() [&]() { \
-    int value = strtol(p, &p, 10); \
-    if (value < 0) { \
-        error_msg = "Negative value where unsigned expected"; \
-        return 0u; \
-    } \
-    return static_cast<unsigned int>(value); \
-}()
-#define READ_DOUBLE() strtod(p, &p)
-#define READ_STR() [&]() { \
-    while ((*p) && (isspace((uint8_t)*p))) ++p; \
-    s = p; \
-    while ((*p) && (!isspace((uint8_t)*p))) ++p; \
-    *p = 0; \
-    p++; \
-    return std::string(s); \
-}()
-
 #define ENSURE_OR_FAIL(condition, error_msg_str, action) \
     if (!(condition)) { \
         this->error_msg = std::string(error_msg_str); \
         action; \
     }
 
-// Helper function to split buffer into lines
-void stringfile(char *buffer, std::vector<char*> &lines) {
-    char *s;
-    size_t count, i;
-
-    // Two passes through: first time count lines, second time set them
-    for (i = 0; i < 2; ++i) {
-        s = buffer;
-        if (i == 1) lines[0] = s;
-        count = 1; // was '1', but C arrays are 0-indexed
-        while (*s) {
-            if (*s == '\n' || *s == '\r') {
-                // If this is the 2nd pass, then terminate the line at the first line break char
-                if (i == 1) *s = 0;
-                s++; // next char
-                // if the termination is a CRLF combo, then jump to the next char
-                if ((*s == '\r') || (*s == '\n')) s++;
-                // if the char is valid (first after line break), set up the next item in the line array
-                if (*s) { // it's not over yet
-                    if (i == 1) {
-                        lines[count] = s;
-                    }
-                    ++count;
-                }
-            }
-            s++;
-        } // while s
-
-        // Generate the required array to hold all the line starting points
-        if (i == 0) {
-            lines.resize(count);
-        }
-    }
-}
-
 // Helper function to find string in buffer
-bool find_str_in_buf(const std::string& needle, const std::vector<char>& buf) {
+bool find_str_in_buf(const std::string& needle, ByteView buf) {
     if (needle.length() > buf.size()) return false;
     auto it = std::search(buf.begin(), buf.end(), needle.begin(), needle.end());
     return it != buf.end();
@@ -82,24 +38,16 @@ bool find_str_in_buf(const std::string& needle, const std::vector<char>& buf) {
 
 std::unique_ptr<BRDFile> BRDFile::LoadFromFile(const std::string& filepath) {
     std::cout << "LoadFromFile: Opening BRD file " << filepath << std::endl;
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
         std::cerr << "Error: Cannot open BRD file " << filepath << std::endl;
         return nullptr;
     }
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(fileSize);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
     std::cout << "LoadFromFile: Creating BRDFile object" << std::endl;
     auto brdFile = std::make_unique<BRDFile>();
     std::cout << "LoadFromFile: Calling Load() method" << std::endl;
-    if (brdFile->Load(buffer, filepath)) {
+    if (brdFile->Load(ByteView(file.data(), file.size()), filepath)) {
         std::cout << "LoadFromFile: Load() succeeded, returning brdFile" << std::endl;
         return brdFile;
     }
@@ -107,7 +55,7 @@ std::unique_ptr<BRDFile> BRDFile::LoadFromFile(const std::string& filepath) {
     return nullptr;
 }
 
-bool BRDFile::VerifyFormat(const std::vector<char>& buffer) {
+bool BRDFile::VerifyFormat(ByteView buffer) {
     if (buffer.size() < signature.size()) return false;
     if (std::equal(signature.begin(), signature.end(), buffer.begin(), 
                    [](const uint8_t &i, const char &j) {
@@ -117,128 +65,194 @@ bool BRDFile::VerifyFormat(const std::vector<char>& buffer) {
     return find_str_in_buf("str_length:", buffer) && find_str_in_buf("var_data:", buffer);
 }
 
-bool BRDFile::Load(const std::vector<char>& buf, const std::string& /*filepath*/) {
+// Encoded files store each byte c as ~rotl8(c, 2), except CR, LF and NUL
+static uint8_t DecodeByte(uint8_t c) {
+    if (c == '\r' || c == '\n' || c == 0) return c;
+    return static_cast<uint8_t>(~((c >> 6) | (c << 2)));
+}
+
+void BRDFile::Decode(const char* src, char* dst, size_t size) {
+    size_t i = 0;
+#if defined(BRD_DECODE_AVX2)
+    const __m256i low6 = _mm256_set1_epi8(static_cast<char>(0xFC));
+    const __m256i high2 = _mm256_set1_epi8(0x03);
+    const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+    const __m256i cr = _mm256_set1_epi8('\r'), lf = _mm256_set1_epi8('\n'), zero = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // 16-bit shifts move bits across byte lanes; the masks drop them
+        const __m256i rotated = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(v, 2), low6),
+                                                _mm256_and_si256(_mm256_srli_epi16(v, 6), high2));
+        const __m256i keep = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)),
+                                             _mm256_cmpeq_epi8(v, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(_mm256_xor_si256(rotated, ones), v, keep));
+    }
+#elif defined(BRD_DECODE_SSE2)
+    const __m128i low6 = _mm_set1_epi8(static_cast<char>(0xFC));
+    const __m128i high2 = _mm_set1_epi8(0x03);
+    const __m128i ones = _mm_set1_epi8(static_cast<char>(0xFF));
+    const __m128i cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n'), zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // 16-bit shifts move bits across byte lanes; the masks drop them
+        const __m128i rotated = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 2), low6),
+                                             _mm_and_si128(_mm_srli_epi16(v, 6), high2));
+        const __m128i keep = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)), _mm_cmpeq_epi8(v, zero));
+        const __m128i decoded = _mm_xor_si128(rotated, ones);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_or_si128(_mm_and_si128(keep, v), _mm_andnot_si128(keep, decoded)));
+    }
+#endif
+    // Tail (or everything, without SSE2) through a 256-entry table
+    static const auto table = [] {
+        std::array<uint8_t, 256> t{};
+        for (int c = 0; c < 256; ++c) t[c] = DecodeByte(static_cast<uint8_t>(c));
+        return t;
+    }();
+    for (; i < size; ++i) dst[i] = static_cast<char>(table[static_cast<uint8_t>(src[i])]);
+}
+
+bool BRDFile::Load(ByteView buf, const std::string& /*filepath*/) {
+    if (!Parse(buf)) return false;
+
+    // Generate rendering geometry for pins
+    GenerateRenderingGeometry();
+    BuildIndices();
+
+    std::cout << "BRD file parsed successfully:" << std::endl;
+    std::cout << "  Parts: " << parts.size() << std::endl;
+    std::cout << "  Pins: " << pins.size() << std::endl;
+    std::cout << "  Nails: " << nails.size() << std::endl;
+    std::cout << "  Format points: " << format.size() << std::endl;
+    std::cout << "  Circles: " << circles.size() << std::endl;
+    std::cout << "  Outline segments: " << outline_segments.size() << std::endl;
+    std::cout << "  Part outline segments: " << part_outline_segments.size() << std::endl;
+
+    return true;
+}
+
+bool BRDFile::Parse(ByteView buf) {
     auto buffer_size = buf.size();
     ENSURE_OR_FAIL(buffer_size > 4, "Buffer too small", return false);
-    
-    size_t file_buf_size = 3 * (1 + buffer_size);
-    file_buf = (char *)calloc(1, file_buf_size);
-    ENSURE_OR_FAIL(file_buf != nullptr, "Memory allocation failed", return false);
-
-    std::copy(buf.begin(), buf.end(), file_buf);
-    file_buf[buffer_size] = 0;
-    // This is for fixing degenerate utf8
-    char *arena = &file_buf[buffer_size + 1];
-    char *arena_end = file_buf + file_buf_size - 1;
-    *arena_end = 0;
-    
-    // Suppress unused variable warning
-    (void)arena;
-
-    // Decode the file if it appears to be encoded:
-    static const uint8_t encoded_header[] = {0x23, 0xe2, 0x63, 0x28};
-    if (!memcmp(file_buf, encoded_header, 4)) {
-        for (size_t i = 0; i < buffer_size; i++) {
-            char x = file_buf[i];
-            if (!(x == '\r' || x == '\n' || !x)) {
-                int c = x;
-                x = ~(((c >> 6) & 3) | (c << 2));
-            }
-            file_buf[i] = x;
-        }
+
+    // Plain files are parsed straight from the caller's buffer; encoded ones
+    // are decoded once into a buffer of the same size
+    std::unique_ptr<char[]> decoded;
+    std::string_view text(buf.data(), buffer_size);
+    if (std::equal(signature.begin(), signature.end(), reinterpret_cast<const uint8_t*>(buf.data()))) {
+        decoded.reset(new (std::nothrow) char[buffer_size]);
+        ENSURE_OR_FAIL(decoded != nullptr, "Memory allocation failed", return false);
+        Decode(buf.data(), decoded.get(), buffer_size);
+        text = std::string_view(decoded.get(), buffer_size);
     }
 
-    int current_block = 0;
-    std::vector<char*> lines;
-    stringfile(file_buf, lines);
+    // Section headers are found in one pass; pins and nails, the bulk of a
+    // large file, are then parsed in parallel chunks
+    const std::vector<TextSection> sections = SplitTextSections(text, [](std::string_view line) {
+        if (line == "str_length:") return 1;
+        if (line == "var_data:") return 2;
+        if (line == "Format:" || line == "format:") return 3;
+        if (line == "Parts:" || line == "Pins1:") return 4;
+        if (line == "Pins:" || line == "Pins2:") return 5;
+        if (line == "Nails:") return 6;
+        return 0;
+    });
 
-    for (char *line : lines) {
-        while (isspace((uint8_t)*line)) line++;
-        if (!line[0]) continue;
-        if (!strcmp(line, "str_length:")) {
-            current_block = 1;
-            continue;
-        }
-        if (!strcmp(line, "var_data:")) {
-            current_block = 2;
-            continue;
-        }
-        if (!strcmp(line, "Format:") || !strcmp(line, "format:")) {
-            current_block = 3;
-            continue;
-        }
-        if (!strcmp(line, "Parts:") || !strcmp(line, "Pins1:")) {
-            current_block = 4;
-            continue;
-        }
-        if (!strcmp(line, "Pins:") || !strcmp(line, "Pins2:")) {
-            current_block = 5;
-            continue;
-        }
-        if (!strcmp(line, "Nails:")) {
-            current_block = 6;
-            continue;
-        }
+    bool negative = false; // an unsigned field held a negative number
+    auto note_negative = [&](size_t, bool) { negative = true; };
+    // Record counts come from the file; reserve no more than it could hold
+    auto reserve = [&](auto& items, unsigned int count) { items.reserve(std::min<size_t>(count, text.size() / 4)); };
 
-        char *p = line;
-        char *s;
-        unsigned int tmp = 0;
-
-        switch (current_block) {
+    for (const TextSection& section : sections) {
+        switch (section.block) {
             case 2: { // var_data
-                num_format = READ_UINT();
-                num_parts = READ_UINT();
-                num_pins = READ_UINT();
-                num_nails = READ_UINT();
+                ForEachTextLine(section.body, [&](std::string_view line) {
+                    TextCursor in(line);
+                    num_format = in.ReadUInt(&negative);
+                    num_parts = in.ReadUInt(&negative);
+                    num_pins = in.ReadUInt(&negative);
+                    num_nails = in.ReadUInt(&negative);
+                    return true;
+                });
+                reserve(format, num_format);
+                reserve(parts, num_parts);
             } break;
             case 3: { // Format
-                if (format.size() >= num_format) break;
-                BRDPoint fmt;
-                fmt.x = strtol(p, &p, 10);
-                fmt.y = strtol(p, &p, 10);
-                format.push_back(fmt);
+                ForEachTextLine(section.body, [&](std::string_view line) {
+                    if (format.size() >= num_format) return true;
+                    TextCursor in(line);
+                    BRDPoint fmt;
+                    fmt.x = in.ReadInt();
+                    fmt.y = in.ReadInt();
+                    format.push_back(fmt);
+                    return true;
+                });
             } break;
             case 4: { // Parts
-                if (parts.size() >= num_parts) break;
-                BRDPart part;
-                part.name = READ_STR();
-                tmp = READ_UINT(); // Type and layer, actually.
-                part.part_type = (tmp & 0xc) ? BRDPartType::SMD : BRDPartType::ThroughHole;
-                if (tmp == 1 || (4 <= tmp && tmp < 8)) part.mounting_side = BRDPartMountingSide::Top;
-                if (tmp == 2 || (8 <= tmp)) part.mounting_side = BRDPartMountingSide::Bottom;
-                part.end_of_pins = READ_UINT();
-                if (part.end_of_pins > num_pins) {
-                    error_msg = "Part end_of_pins exceeds num_pins";
-                    return false;
-                }
-                parts.push_back(part);
+                bool parsed = ForEachTextLine(section.body, [&](std::string_view line) {
+                    if (parts.size() >= num_parts) return true;
+                    TextCursor in(line);
+                    BRDPart part;
+                    part.name = in.ReadStr();
+                    unsigned int tmp = in.ReadUInt(&negative); // Type and layer, actually.
+                    part.part_type = (tmp & 0xc) ? BRDPartType::SMD : BRDPartType::ThroughHole;
+                    if (tmp == 1 || (4 <= tmp && tmp < 8)) part.mounting_side = BRDPartMountingSide::Top;
+                    if (tmp == 2 || (8 <= tmp)) part.mounting_side = BRDPartMountingSide::Bottom;
+                    part.end_of_pins = in.ReadUInt(&negative);
+                    if (part.end_of_pins > num_pins) {
+                        error_msg = "Part end_of_pins exceeds num_pins";
+                        return false;
+                    }
+                    parts.push_back(std::move(part));
+                    return true;
+                });
+                if (!parsed) return false;
             } break;
             case 5: { // Pins
-                if (pins.size() >= num_pins) break;
-                BRDPin pin;
-                pin.pos.x = READ_INT();
-                pin.pos.y = READ_INT();
-                pin.probe = READ_INT(); // Can be negative (-99)
-                pin.part = READ_UINT();
-                if (pin.part > num_parts) {
-                    error_msg = "Pin part exceeds num_parts";
-                    return false;
+                // Workers cannot intern into string_pool, so a pin's net name
+                // comes back in its note and is interned here, in file order
+                struct PinNote {
+                    bool negative = false;
+                    std::string_view net; // points into text
+                    explicit operator bool() const { return negative || !net.empty(); }
+                };
+                const size_t first = pins.size();
+                ParseTextRecords(section.body, num_pins, pins, [](std::string_view line, BRDPin& pin) {
+                    TextCursor in(line);
+                    PinNote note;
+                    pin.pos.x = in.ReadInt();
+                    pin.pos.y = in.ReadInt();
+                    pin.probe = in.ReadInt(); // Can be negative (-99)
+                    pin.part = in.ReadUInt(&note.negative);
+                    pin.net_id = kEmptyStringId;
+                    note.net = in.ReadToken();
+                    return note;
+                }, [&](size_t index, const PinNote& note) {
+                    if (note.negative) negative = true;
+                    if (!note.net.empty()) pins[index].net_id = string_pool.Intern(std::string(note.net));
+                });
+                for (size_t i = first; i < pins.size(); ++i) {
+                    if (pins[i].part > num_parts) {
+                        error_msg = "Pin part exceeds num_parts";
+                        return false;
+                    }
                 }
-                pin.net = READ_STR();
-                pins.push_back(pin);
             } break;
             case 6: { // Nails
-                if (nails.size() >= num_nails) break;
-                BRDNail nail;
-                nail.probe = READ_UINT();
-                nail.pos.x = READ_INT();
-                nail.pos.y = READ_INT();
-                nail.side = READ_UINT() == 1 ? BRDPartMountingSide::Top : BRDPartMountingSide::Bottom;
-                nail.net = READ_STR();
-                nails.push_back(nail);
+                ParseTextRecords(section.body, num_nails, nails, [](std::string_view line, BRDNail& nail) {
+                    TextCursor in(line);
+                    bool negative = false;
+                    nail.probe = in.ReadUInt(&negative);
+                    nail.pos.x = in.ReadInt();
+                    nail.pos.y = in.ReadInt();
+                    nail.side = in.ReadUInt(&negative) == 1 ? BRDPartMountingSide::Top : BRDPartMountingSide::Bottom;
+                    nail.net = in.ReadStr();
+                    return negative;
+                }, note_negative);
             } break;
         }
     }
+    if (negative) error_msg = "Negative value where unsigned expected";
 
     // Lenovo brd variant, find net from nail
     std::unordered_map<int, std::string> nailsToNets; // Map between net id and net name
@@ -247,12 +261,12 @@ bool BRDFile::Load(const std::vector<char>& buf, const std::string& /*filepath*/
     }
 
     for (auto &pin : pins) {
-        if (pin.net.empty()) {
+        if (pin.net_id == kEmptyStringId) {
             auto it = nailsToNets.find(pin.probe);
             if (it != nailsToNets.end()) {
-                pin.net = it->second;
+                SetPinNet(pin, it->second);
             } else {
-                pin.net = "UNCONNECTED";
+                pin.net_id = kUnconnectedNetId;
             }
         }
         if (pin.part > 0 && pin.part <= parts.size()) {
@@ -286,22 +300,7 @@ bool BRDFile::Load(const std::vector<char>& buf, const std::string& /*filepath*/
         }
     }
 
-    valid = current_block != 0;
-    
-    // Generate rendering geometry for pins
-    if (valid) {
-        GenerateRenderingGeometry();
-    }
-    
-    std::cout << "BRD file parsed successfully:" << std::endl;
-    std::cout << "  Parts: " << parts.size() << std::endl;
-    std::cout << "  Pins: " << pins.size() << std::endl;
-    std::cout << "  Nails: " << nails.size() << std::endl;
-    std::cout << "  Format points: " << format.size() << std::endl;
-    std::cout << "  Circles: " << circles.size() << std::endl;
-    std::cout << "  Outline segments: " << outline_segments.size() << std::endl;
-    std::cout << "  Part outline segments: " << part_outline_segments.size() << std::endl;
-    
+    valid = !sections.empty();
     return valid;
 }
 
@@ -313,12 +312,6 @@ void BRDFile::GenerateRenderingGeometry() {
     outline_segments.clear();
     part_outline_segments.clear();
     
-    // Calculate board dimensions for layer separation
-    BRDPoint min_point, max_point;
-    GetBoundingBox(min_point, max_point);
-    float board_width = max_point.x - min_point.x;
-    float board_height = max_point.y - min_point.y;
-    
     // No offset - both sides overlap in the same position
     float bottom_side_offset_x = 0.0f;
     float bottom_side_offset_y = 0.0f;
@@ -340,87 +333,92 @@ void BRDFile::GenerateRenderingGeometry() {
         }
     }
     
-    // Generate part outline segments from parts
-    for (const auto& part : parts) {
-        bool is_bottom_side = (part.mounting_side == BRDPartMountingSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        // Use p1 and p2 points to create part outline
-        // Note: Y coordinates are already mirrored for bottom side parts
-        if (part.p1 != part.p2) {
-            // Create rectangle from p1 and p2
-            BRDPoint top_left = {static_cast<int>(std::min(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::max(part.p1.y, part.p2.y) + offset_y)};
-            BRDPoint top_right = {static_cast<int>(std::max(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::max(part.p1.y, part.p2.y) + offset_y)};
-            BRDPoint bottom_right = {static_cast<int>(std::max(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::min(part.p1.y, part.p2.y) + offset_y)};
-            BRDPoint bottom_left = {static_cast<int>(std::min(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::min(part.p1.y, part.p2.y) + offset_y)};
-            
-            part_outline_segments.push_back({top_left, top_right});
-            part_outline_segments.push_back({top_right, bottom_right});
-            part_outline_segments.push_back({bottom_right, bottom_left});
-            part_outline_segments.push_back({bottom_left, top_left});
-        } else {
-            // Create a small square around the point
-            float part_size = 10.0f;
-            BRDPoint center = {static_cast<int>(part.p1.x + offset_x), static_cast<int>(part.p1.y + offset_y)};
-            BRDPoint top_left = {static_cast<int>(center.x - part_size/2), static_cast<int>(center.y + part_size/2)};
-            BRDPoint top_right = {static_cast<int>(center.x + part_size/2), static_cast<int>(center.y + part_size/2)};
-            BRDPoint bottom_right = {static_cast<int>(center.x + part_size/2), static_cast<int>(center.y - part_size/2)};
-            BRDPoint bottom_left = {static_cast<int>(center.x - part_size/2), static_cast<int>(center.y - part_size/2)};
-            
-            part_outline_segments.push_back({top_left, top_right});
-            part_outline_segments.push_back({top_right, bottom_right});
-            part_outline_segments.push_back({bottom_right, bottom_left});
-            part_outline_segments.push_back({bottom_left, top_left});
+    // Part outlines and pin/nail circles are independent per item: each block
+    // fills its own slots, so the order matches a serial pass
+    constexpr size_t kGeometryBlock = 4096;
+
+    // Generate part outline segments from parts, four per part
+    part_outline_segments.resize(parts.size() * 4);
+    Utils::ParallelForBlocks(parts.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& part = parts[n];
+            auto* segments = &part_outline_segments[n * 4];
+            bool is_bottom_side = (part.mounting_side == BRDPartMountingSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
+
+            // Use p1 and p2 points to create part outline
+            // Note: Y coordinates are already mirrored for bottom side parts
+            if (part.p1 != part.p2) {
+                // Create rectangle from p1 and p2
+                BRDPoint top_left = {static_cast<int>(std::min(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::max(part.p1.y, part.p2.y) + offset_y)};
+                BRDPoint top_right = {static_cast<int>(std::max(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::max(part.p1.y, part.p2.y) + offset_y)};
+                BRDPoint bottom_right = {static_cast<int>(std::max(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::min(part.p1.y, part.p2.y) + offset_y)};
+                BRDPoint bottom_left = {static_cast<int>(std::min(part.p1.x, part.p2.x) + offset_x), static_cast<int>(std::min(part.p1.y, part.p2.y) + offset_y)};
+
+                segments[0] = {top_left, top_right};
+                segments[1] = {top_right, bottom_right};
+                segments[2] = {bottom_right, bottom_left};
+                segments[3] = {bottom_left, top_left};
+            } else {
+                // Create a small square around the point
+                float part_size = 10.0f;
+                BRDPoint center = {static_cast<int>(part.p1.x + offset_x), static_cast<int>(part.p1.y + offset_y)};
+                BRDPoint top_left = {static_cast<int>(center.x - part_size/2), static_cast<int>(center.y + part_size/2)};
+                BRDPoint top_right = {static_cast<int>(center.x + part_size/2), static_cast<int>(center.y + part_size/2)};
+                BRDPoint bottom_right = {static_cast<int>(center.x + part_size/2), static_cast<int>(center.y - part_size/2)};
+                BRDPoint bottom_left = {static_cast<int>(center.x - part_size/2), static_cast<int>(center.y - part_size/2)};
+
+                segments[0] = {top_left, top_right};
+                segments[1] = {top_right, bottom_right};
+                segments[2] = {bottom_right, bottom_left};
+                segments[3] = {bottom_left, top_left};
+            }
         }
-    }
-    
-    // Generate circles for pins
-    for (const auto& pin : pins) {
-        bool is_bottom_side = (pin.side == BRDPinSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        // Use pin radius if available, otherwise use a default radius
-        float radius = static_cast<float>(pin.radius);
-        if (radius <= 0.0f) {
-            radius = 6.5f; // Default radius similar to XZZPCBFile
+    });
+
+    // Circles for pins, then for nails
+    circles.resize(pins.size() + nails.size());
+    Utils::ParallelForBlocks(pins.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& pin = pins[n];
+            bool is_bottom_side = (pin.side == BRDPinSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
+
+            // Use pin radius if available, otherwise use a default radius
+            float radius = static_cast<float>(pin.radius);
+            if (radius <= 0.0f) {
+                radius = 6.5f; // Default radius similar to XZZPCBFile
+            }
+
+            // Apply offset to pin position (Y coordinates are already mirrored for bottom side)
+            BRDPoint pin_pos = {static_cast<int>(pin.pos.x + offset_x), static_cast<int>(pin.pos.y + offset_y)};
+
+            // Create circle for pin with red color (top) or blue color (bottom)
+            float r = is_bottom_side ? 0.0f : 0.7f; // Blue for bottom, red for top
+            float g = 0.0f;
+            float b = is_bottom_side ? 0.7f : 0.0f;
+            circles[n] = BRDCircle(pin_pos, radius, r, g, b, 1.0f);
         }
-        
-        // Apply offset to pin position (Y coordinates are already mirrored for bottom side)
-        BRDPoint pin_pos = {static_cast<int>(pin.pos.x + offset_x), static_cast<int>(pin.pos.y + offset_y)};
-        
-        // Create circle for pin with red color (top) or blue color (bottom)
-        float r = is_bottom_side ? 0.0f : 0.7f; // Blue for bottom, red for top
-        float g = 0.0f;
-        float b = is_bottom_side ? 0.7f : 0.0f;
-        BRDCircle circle(pin_pos, radius, r, g, b, 1.0f);
-        circles.push_back(circle);
-    }
-    
-    // Generate circles for nails (test points) with different color
-    for (const auto& nail : nails) {
-        bool is_bottom_side = (nail.side == BRDPartMountingSide::Bottom);
-        float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
-        float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
-        
-        float radius = 4.0f; // Fixed radius for test points
-        
-        // Apply offset to nail position (Y coordinates are already mirrored for bottom side)
-        BRDPoint nail_pos = {static_cast<int>(nail.pos.x + offset_x), static_cast<int>(nail.pos.y + offset_y)};
-        
-        // Create circle for nail with green color (top) or cyan color (bottom)
-        float r = 0.0f;
-        float g = 0.7f;
-        float b = is_bottom_side ? 0.7f : 0.0f;
-        BRDCircle circle(nail_pos, radius, r, g, b, 1.0f);
-        circles.push_back(circle);
-    }
-}
+    });
+    Utils::ParallelForBlocks(nails.size(), kGeometryBlock, [&](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const auto& nail = nails[n];
+            bool is_bottom_side = (nail.side == BRDPartMountingSide::Bottom);
+            float offset_x = is_bottom_side ? bottom_side_offset_x : 0.0f;
+            float offset_y = is_bottom_side ? bottom_side_offset_y : 0.0f;
 
-BRDFile::~BRDFile() {
-    if (file_buf) {
-        free(file_buf);
-        file_buf = nullptr;
-    }
+            float radius = 4.0f; // Fixed radius for test points
+
+            // Apply offset to nail position (Y coordinates are already mirrored for bottom side)
+            BRDPoint nail_pos = {static_cast<int>(nail.pos.x + offset_x), static_cast<int>(nail.pos.y + offset_y)};
+
+            // Create circle for nail with green color (top) or cyan color (bottom)
+            float r = 0.0f;
+            float g = 0.7f;
+            float b = is_bottom_side ? 0.7f : 0.0f;
+            circles[pins.size() + n] = BRDCircle(nail_pos, radius, r, g, b, 1.0f);
+        }
+    });
 }
@@ -10,19 +10,25 @@
 class BRDFile : public BRDFileBase {
 public:
     BRDFile() = default;
-    ~BRDFile();
+    ~BRDFile() = default;
 
     // Implementation of pure virtual methods
-    bool Load(const std::vector<char>& buffer, const std::string& filepath = "") override;
-    bool VerifyFormat(const std::vector<char>& buffer) override;
+    bool Load(ByteView buffer, const std::string& filepath = "") override;
+    bool VerifyFormat(ByteView buffer) override;
 
     // Static factory method
     static std::unique_ptr<BRDFile> LoadFromFile(const std::string& filepath);
 
+    // Decodes the body of a file that starts with the encoded signature
+    // (CR, LF and NUL are stored as-is); src and dst may be the same buffer
+    static void Decode(const char* src, char* dst, size_t size);
+
+    // Load() is Parse(), then GenerateRenderingGeometry() and BuildIndices();
+    // the stages are public so they can be timed apart. Parse() decodes and
+    // reads the records and returns valid
+    bool Parse(ByteView buffer);
+    void GenerateRenderingGeometry();
+
 private:
     static constexpr std::array<uint8_t, 4> signature = {{0x23, 0xe2, 0x63, 0x28}};
-    char *file_buf = nullptr;
-    
-    // Helper method to generate rendering geometry for pins
-    void GenerateRenderingGeometry();
 };
@@ -1,6 +1,7 @@
 #include "BRDFileBase.h"
 #include <limits>
 #include <algorithm>
+#include <unordered_map>
 
 void BRDFileBase::GetBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const {
     if (pins.empty() && parts.empty() && format.empty()) {
@@ -43,7 +44,7 @@ void BRDFileBase::GetBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const
 }
 
 void BRDFileBase::GetRenderingBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const {
-    if (circles.empty() && outline_segments.empty() && part_outline_segments.empty()) {
+    if (circles.empty() && outline_segments.empty() && outline_arcs.empty() && part_outline_segments.empty()) {
         // Fallback to original bounding box if no rendering geometry
         GetBoundingBox(min_point, max_point);
         return;
@@ -74,6 +75,15 @@ void BRDFileBase::GetRenderingBoundingBox(BRDPoint& min_point, BRDPoint& max_poi
         max_y = std::max({max_y, static_cast<float>(segment.first.y), static_cast<float>(segment.second.y)});
     }
 
+    for (const auto& arc : outline_arcs) {
+        float lo_x, lo_y, hi_x, hi_y;
+        arc.GetBounds(lo_x, lo_y, hi_x, hi_y);
+        min_x = std::min(min_x, lo_x);
+        max_x = std::max(max_x, hi_x);
+        min_y = std::min(min_y, lo_y);
+        max_y = std::max(max_y, hi_y);
+    }
+
     // Check part outline segments
     for (const auto& segment : part_outline_segments) {
         min_x = std::min({min_x, static_cast<float>(segment.first.x), static_cast<float>(segment.second.x)});
@@ -99,6 +109,7 @@ BRDPoint BRDFileBase::GetCenter() const {
 void BRDFileBase::ClearData() {
     format.clear();
     outline_segments.clear();
+    outline_arcs.clear();
     part_outline_segments.clear();
     parts.clear();
     pins.clear();
@@ -106,6 +117,14 @@ void BRDFileBase::ClearData() {
     circles.clear();
     rectangles.clear();
     ovals.clear();
+    trace_layers.clear();
+    trace_nets.clear();
+    trace_net_ids.clear();
+    pin_columns.clear();
+    net_index.clear();
+    part_index.clear();
+    pad_links.clear();
+    ResetStringPool();
     
     num_format = 0;
     num_parts = 0;
@@ -131,3 +150,264 @@ bool BRDFileBase::ValidateData() {
 
     return true;
 }
+
+BRDFileBase::TraceLayer& BRDFileBase::GetTraceLayer(int layer) {
+    auto it = std::lower_bound(trace_layers.begin(), trace_layers.end(), layer,
+                               [](const TraceLayer& entry, int l) { return entry.layer < l; });
+    if (it == trace_layers.end() || it->layer != layer) {
+        it = trace_layers.insert(it, TraceLayer());
+        it->layer = layer;
+    }
+    return *it;
+}
+
+size_t BRDFileBase::TraceSegmentCount() const {
+    size_t count = 0;
+    for (const auto& layer : trace_layers) count += layer.segments.size() + layer.arcs.size();
+    return count;
+}
+
+void BRDFileBase::PinColumns::clear() {
+    x.clear();
+    y.clear();
+    part.clear();
+    side.clear();
+    net.clear();
+}
+
+void BRDFileBase::ResetStringPool() {
+    string_pool.Clear();
+    string_pool.Intern("UNCONNECTED"); // kUnconnectedNetId, the BRDPin default
+}
+
+void BRDFileBase::BuildIndices() {
+    pin_columns.clear();
+
+    const size_t count = pins.size();
+    pin_columns.x.reserve(count);
+    pin_columns.y.reserve(count);
+    pin_columns.part.reserve(count);
+    pin_columns.side.reserve(count);
+    pin_columns.net.reserve(count);
+
+    for (const auto& pin : pins) {
+        pin_columns.x.push_back(pin.pos.x);
+        pin_columns.y.push_back(pin.pos.y);
+        pin_columns.part.push_back(pin.part);
+        pin_columns.side.push_back(pin.side);
+        pin_columns.net.push_back(pin.net_id < string_pool.size() ? pin.net_id : kEmptyStringId);
+    }
+
+    // Pin strings were interned while parsing, so their ids do not depend on
+    // whether a board has traces
+    trace_net_ids.clear();
+    trace_net_ids.reserve(trace_nets.size());
+    for (const auto& net : trace_nets) trace_net_ids.push_back(string_pool.Intern(net));
+
+    BuildNetIndex();
+    BuildPartIndex();
+    BuildPadLinks();
+}
+
+void BRDFileBase::NetIndex::clear() {
+    offsets.clear();
+    pin_indices.clear();
+    bbox_min.clear();
+    bbox_max.clear();
+    flags.clear();
+    named_nets.clear();
+}
+
+void BRDFileBase::BuildNetIndex() {
+    net_index.clear();
+
+    // Counting sort of pin indices by net id (ids span nets and pin names)
+    const size_t id_count = string_pool.size();
+    const auto& pin_nets = pin_columns.net;
+    net_index.offsets.assign(id_count + 1, 0);
+    for (uint32_t net : pin_nets) net_index.offsets[net + 1]++;
+    for (size_t i = 0; i < id_count; ++i) net_index.offsets[i + 1] += net_index.offsets[i];
+
+    net_index.pin_indices.resize(pin_nets.size());
+    std::vector<uint32_t> cursor(net_index.offsets.begin(), net_index.offsets.end() - 1);
+    for (size_t i = 0; i < pin_nets.size(); ++i) {
+        net_index.pin_indices[cursor[pin_nets[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    net_index.bbox_min.assign(id_count, BRDPoint(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()));
+    net_index.bbox_max.assign(id_count, BRDPoint(std::numeric_limits<int>::min(), std::numeric_limits<int>::min()));
+    for (size_t i = 0; i < pin_nets.size(); ++i) {
+        BRDPoint& lo = net_index.bbox_min[pin_nets[i]];
+        BRDPoint& hi = net_index.bbox_max[pin_nets[i]];
+        lo.x = std::min(lo.x, pin_columns.x[i]);
+        lo.y = std::min(lo.y, pin_columns.y[i]);
+        hi.x = std::max(hi.x, pin_columns.x[i]);
+        hi.y = std::max(hi.y, pin_columns.y[i]);
+    }
+
+    // Classify each net once instead of upper-casing names per pin
+    net_index.flags.assign(id_count, 0);
+    for (uint32_t id = 0; id < id_count; ++id) {
+        if (net_index.offsets[id] == net_index.offsets[id + 1]) continue;
+        const std::string& name = string_pool.Get(id);
+        uint8_t flags = 0;
+        if (name.empty() || name == "UNCONNECTED") flags |= kNetUnconnected;
+        if (IsGroundNetName(name)) flags |= kNetGround;
+        if (IsNoConnectNetName(name)) flags |= kNetNoConnect;
+        net_index.flags[id] = flags;
+        if (!(flags & (kNetUnconnected | kNetGround))) net_index.named_nets.push_back(id);
+    }
+    std::sort(net_index.named_nets.begin(), net_index.named_nets.end(), [this](uint32_t a, uint32_t b) {
+        return string_pool.Get(a) < string_pool.Get(b);
+    });
+}
+
+void BRDFileBase::PartIndex::clear() {
+    offsets.clear();
+    pin_indices.clear();
+    bbox_min.clear();
+    bbox_max.clear();
+}
+
+void BRDFileBase::BuildPartIndex() {
+    part_index.clear();
+
+    // Counting sort of pin indices by part; pins without a valid part are left out
+    const size_t part_count = parts.size();
+    const auto& pin_parts = pin_columns.part;
+    part_index.offsets.assign(part_count + 1, 0);
+    for (unsigned int part : pin_parts) {
+        if (part >= 1 && part <= part_count) part_index.offsets[part]++;
+    }
+    for (size_t i = 0; i < part_count; ++i) part_index.offsets[i + 1] += part_index.offsets[i];
+
+    part_index.pin_indices.resize(part_index.offsets[part_count]);
+    std::vector<uint32_t> cursor(part_index.offsets.begin(), part_index.offsets.end() - 1);
+    part_index.bbox_min.assign(part_count, BRDPoint(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()));
+    part_index.bbox_max.assign(part_count, BRDPoint(std::numeric_limits<int>::min(), std::numeric_limits<int>::min()));
+    for (size_t i = 0; i < pin_parts.size(); ++i) {
+        unsigned int part = pin_parts[i];
+        if (part < 1 || part > part_count) continue;
+        part_index.pin_indices[cursor[part - 1]++] = static_cast<uint32_t>(i);
+
+        BRDPoint& lo = part_index.bbox_min[part - 1];
+        BRDPoint& hi = part_index.bbox_max[part - 1];
+        lo.x = std::min(lo.x, pin_columns.x[i]);
+        lo.y = std::min(lo.y, pin_columns.y[i]);
+        hi.x = std::max(hi.x, pin_columns.x[i]);
+        hi.y = std::max(hi.y, pin_columns.y[i]);
+    }
+}
+
+void BRDFileBase::PadLinks::clear() {
+    pin_shape.clear();
+    pin_shape_index.clear();
+    circle_pin.clear();
+    rectangle_pin.clear();
+    oval_pin.clear();
+}
+
+void BRDFileBase::BuildPadLinks() {
+    pad_links.clear();
+
+    auto key = [](int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    };
+    // First shape at each center; emplace keeps the earliest index
+    auto index_centers = [&](const auto& shapes) {
+        std::unordered_map<uint64_t, uint32_t> centers;
+        centers.reserve(shapes.size());
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            centers.emplace(key(shapes[i].center.x, shapes[i].center.y), static_cast<uint32_t>(i));
+        }
+        return centers;
+    };
+    const auto circle_at = index_centers(circles);
+    const auto rectangle_at = index_centers(rectangles);
+    const auto oval_at = index_centers(ovals);
+
+    pad_links.pin_shape.assign(pins.size(), PadShape::None);
+    pad_links.pin_shape_index.assign(pins.size(), kNoIndex);
+    pad_links.circle_pin.assign(circles.size(), kNoIndex);
+    pad_links.rectangle_pin.assign(rectangles.size(), kNoIndex);
+    pad_links.oval_pin.assign(ovals.size(), kNoIndex);
+
+    for (size_t i = 0; i < pins.size(); ++i) {
+        const uint64_t k = key(pins[i].pos.x, pins[i].pos.y);
+        const uint32_t pin = static_cast<uint32_t>(i);
+        std::unordered_map<uint64_t, uint32_t>::const_iterator it;
+        std::vector<uint32_t>* shape_pin = nullptr;
+        if ((it = circle_at.find(k)) != circle_at.end()) {
+            pad_links.pin_shape[i] = PadShape::Circle;
+            shape_pin = &pad_links.circle_pin;
+        } else if ((it = rectangle_at.find(k)) != rectangle_at.end()) {
+            pad_links.pin_shape[i] = PadShape::Rectangle;
+            shape_pin = &pad_links.rectangle_pin;
+        } else if ((it = oval_at.find(k)) != oval_at.end()) {
+            pad_links.pin_shape[i] = PadShape::Oval;
+            shape_pin = &pad_links.oval_pin;
+        } else {
+            continue;
+        }
+        pad_links.pin_shape_index[i] = it->second;
+        uint32_t& owner = (*shape_pin)[it->second];
+        if (owner == kNoIndex) owner = pin;
+    }
+}
+
+IndexRange BRDFileBase::PinsOfPart(size_t part) const {
+    IndexRange range;
+    if (part + 1 >= part_index.offsets.size()) return range;
+    range.first = part_index.pin_indices.data() + part_index.offsets[part];
+    range.last = part_index.pin_indices.data() + part_index.offsets[part + 1];
+    return range;
+}
+
+bool BRDFileBase::GetPartPinBoundingBox(size_t part, BRDPoint& min_point, BRDPoint& max_point) const {
+    if (PinsOfPart(part).empty()) return false;
+    min_point = part_index.bbox_min[part];
+    max_point = part_index.bbox_max[part];
+    return true;
+}
+
+IndexRange BRDFileBase::PinsOnNet(uint32_t net_id) const {
+    IndexRange range;
+    if (net_id + 1 >= net_index.offsets.size()) return range;
+    range.first = net_index.pin_indices.data() + net_index.offsets[net_id];
+    range.last = net_index.pin_indices.data() + net_index.offsets[net_id + 1];
+    return range;
+}
+
+bool BRDFileBase::GetNetBoundingBox(uint32_t net_id, BRDPoint& min_point, BRDPoint& max_point) const {
+    if (PinsOnNet(net_id).empty()) return false;
+    min_point = net_index.bbox_min[net_id];
+    max_point = net_index.bbox_max[net_id];
+    return true;
+}
+
+bool BRDFileBase::IsGroundNetName(const std::string& net) {
+    if (net.empty()) return false;
+    std::string upper = net;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    return (upper == "GND" ||
+            upper == "GROUND" ||
+            upper == "VSS" ||
+            upper == "AGND" ||
+            upper == "DGND" ||
+            upper == "PGND" ||
+            upper == "SGND" ||
+            upper.rfind("GND", 0) == 0 ||
+            upper.rfind("GROUND", 0) == 0);
+}
+
+bool BRDFileBase::IsNoConnectNetName(const std::string& net) {
+    if (net.empty()) return false;
+    std::string upper = net;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    return (upper == "NC" ||
+            upper == "NO_CONNECT" ||
+            upper == "NOCONNECT" ||
+            upper == "N/C" ||
+            upper == "N.C." ||
+            upper.rfind("NC", 0) == 0);  // Starts with NC (NC1, NC2, etc.)
+}
@@ -2,10 +2,23 @@
 
 #include "BRDTypes.h"
 #include "Utils.h"
+#include "ByteView.h"
+#include "StringPool.h"
 #include <vector>
 #include <string>
 #include <memory>
 
+// Contiguous run of indices inside one of the board's index lists
+struct IndexRange {
+    const uint32_t* first = nullptr;
+    const uint32_t* last = nullptr;
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
 // Base class for all PCB file formats
 class BRDFileBase {
 public:
@@ -18,6 +31,7 @@ public:
     // PCB data
     std::vector<BRDPoint> format;                                    // Board outline
     std::vector<std::pair<BRDPoint, BRDPoint>> outline_segments;    // Board outline segments
+    std::vector<BRDArc> outline_arcs;                               // Board outline arcs (analytic)
     std::vector<std::pair<BRDPoint, BRDPoint>> part_outline_segments; // Part outline segments
     std::vector<BRDPart> parts;                                     // Components
     std::vector<BRDPin> pins;                                       // Pins/pads
@@ -26,17 +40,98 @@ public:
     std::vector<BRDRectangle> rectangles;                           // Rectangles for rendering
     std::vector<BRDOval> ovals;                                     // Ovals for rendering
 
+    // Copper traces grouped by layer, in ascending layer number (only layers
+    // that have traces). Segments and arcs name their net by index into
+    // trace_nets; trace_net_ids maps those to string_pool ids and is rebuilt
+    // by BuildIndices()
+    struct TraceLayer {
+        int layer = 0; // format's layer number
+        std::vector<BRDTrace> segments;
+        std::vector<BRDArc> arcs;
+    };
+    std::vector<TraceLayer> trace_layers;
+    std::vector<std::string> trace_nets;
+    std::vector<uint32_t> trace_net_ids;
+
+    // Owns every pin's net, name and pin number string (BRDPin holds ids).
+    // Besides "" (id 0) it always holds "UNCONNECTED" (kUnconnectedNetId);
+    // parsers intern as they go, so it is only reset by ClearData().
+    StringPool string_pool;
+
+    // Struct-of-arrays copy of the pin fields hot loops touch, index-aligned
+    // with pins; "same net" is an integer compare. Rebuilt by BuildIndices().
+    struct PinColumns {
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<unsigned int> part;
+        std::vector<BRDPinSide> side;
+        std::vector<uint32_t> net;   // string_pool id
+
+        size_t size() const { return net.size(); }
+        void clear();
+    };
+    PinColumns pin_columns;
+
+    // Net -> pins index keyed by string_pool net id, rebuilt by BuildIndices().
+    // Pins of net n are pin_indices[offsets[n] .. offsets[n + 1]).
+    enum NetFlags : uint8_t {
+        kNetUnconnected = 1 << 0, // empty or "UNCONNECTED"
+        kNetGround = 1 << 1,      // GND family
+        kNetNoConnect = 1 << 2,   // NC family
+    };
+    struct NetIndex {
+        std::vector<uint32_t> offsets;     // string_pool.size() + 1 entries
+        std::vector<uint32_t> pin_indices;
+        std::vector<BRDPoint> bbox_min;    // per net id, pin positions only
+        std::vector<BRDPoint> bbox_max;
+        std::vector<uint8_t> flags;        // NetFlags per net id
+        std::vector<uint32_t> named_nets;  // ids with pins, not unconnected/ground, sorted by name
+
+        void clear();
+    };
+    NetIndex net_index;
+
+    // Part -> pins index keyed by 0-based part index (pins store part + 1),
+    // rebuilt by BuildIndices(). Pins of part p are
+    // pin_indices[offsets[p] .. offsets[p + 1]), in pin order.
+    struct PartIndex {
+        std::vector<uint32_t> offsets;     // parts.size() + 1 entries
+        std::vector<uint32_t> pin_indices;
+        std::vector<BRDPoint> bbox_min;    // per part, pin positions only
+        std::vector<BRDPoint> bbox_max;
+
+        void clear();
+    };
+    PartIndex part_index;
+
+    // Pin <-> pad shape links, resolved by exact center match in BuildIndices().
+    // A pin takes the first circle at its position, else the first rectangle,
+    // else the first oval; a shape maps back to the lowest-index pin using it.
+    static constexpr uint32_t kNoIndex = UINT32_MAX;
+    enum class PadShape : uint8_t { None, Circle, Rectangle, Oval };
+    struct PadLinks {
+        std::vector<PadShape> pin_shape;        // per pin
+        std::vector<uint32_t> pin_shape_index;  // per pin, index into the shape's vector
+        std::vector<uint32_t> circle_pin;       // per circle, pin index or kNoIndex
+        std::vector<uint32_t> rectangle_pin;    // per rectangle
+        std::vector<uint32_t> oval_pin;         // per oval
+
+        void clear();
+    };
+    PadLinks pad_links;
+
     // Status
     bool valid = false;
     std::string error_msg = "";
 
     // Constructor/Destructor
-    BRDFileBase() = default;
+    BRDFileBase() { ResetStringPool(); }
     virtual ~BRDFileBase() = default;
 
     // Pure virtual methods to be implemented by derived classes
-    virtual bool Load(const std::vector<char>& buffer, const std::string& filepath = "") = 0;
-    virtual bool VerifyFormat(const std::vector<char>& buffer) = 0;    // Helper methods
+    // buffer is only borrowed for the duration of the call (may be a file mapping)
+    virtual bool Load(ByteView buffer, const std::string& filepath = "") = 0;
+    virtual bool VerifyFormat(ByteView buffer) = 0;    // Helper methods
     bool IsValid() const { return valid; }
     const std::string& GetErrorMessage() const { return error_msg; }
     void SetValid(bool v) { valid = v; }
@@ -50,8 +145,52 @@ public:
     // Get center point of the PCB
     BRDPoint GetCenter() const;
 
+    // (Re)build derived lookup data from the AoS vectors. Loaders call this
+    // after a successful parse; call it again after editing pins by hand.
+    void BuildIndices();
+    bool HasIndices() const { return pin_columns.size() == pins.size() && !pins.empty(); }
+
+    // Interned id of a net name, or StringPool::kInvalid if the name never occurs
+    uint32_t FindNetId(const std::string& net) const { return string_pool.Find(net); }
+    const std::string& NetName(uint32_t net_id) const { return string_pool.Get(net_id); }
+
+    // Pin strings, stored in string_pool
+    const std::string& PinNet(const BRDPin& pin) const { return string_pool.Get(pin.net_id); }
+    const std::string& PinName(const BRDPin& pin) const { return string_pool.Get(pin.name_id); }
+    const std::string& PinSnum(const BRDPin& pin) const { return string_pool.Get(pin.snum_id); }
+    void SetPinNet(BRDPin& pin, const std::string& net) { pin.net_id = string_pool.Intern(net); }
+    void SetPinName(BRDPin& pin, const std::string& name) { pin.name_id = string_pool.Intern(name); }
+    void SetPinSnum(BRDPin& pin, const std::string& snum) { pin.snum_id = string_pool.Intern(snum); }
+
+    // Indices into pins of every pin on net_id (empty for unknown ids)
+    IndexRange PinsOnNet(uint32_t net_id) const;
+    uint8_t NetFlagsOf(uint32_t net_id) const {
+        return net_id < net_index.flags.size() ? net_index.flags[net_id] : static_cast<uint8_t>(kNetUnconnected);
+    }
+    // Bounding box of the pins on net_id; false if the net has no pins
+    bool GetNetBoundingBox(uint32_t net_id, BRDPoint& min_point, BRDPoint& max_point) const;
+
+    // Indices into pins of every pin of the 0-based part (empty if out of range)
+    IndexRange PinsOfPart(size_t part) const;
+    // Bounding box of the part's pin positions; false if the part has no pins
+    bool GetPartPinBoundingBox(size_t part, BRDPoint& min_point, BRDPoint& max_point) const;
+
+    // Layer entry for layer, inserted in layer order if the board has none yet
+    TraceLayer& GetTraceLayer(int layer);
+    size_t TraceSegmentCount() const; // segments and arcs over all layers
+
+    // Net name classification shared by renderers and UI (case-insensitive)
+    static bool IsGroundNetName(const std::string& net);
+    static bool IsNoConnectNetName(const std::string& net);
+
 protected:
     // Helper functions for derived classes
     void ClearData();
     bool ValidateData();
+
+private:
+    void ResetStringPool();
+    void BuildNetIndex();
+    void BuildPartIndex();
+    void BuildPadLinks();
 };
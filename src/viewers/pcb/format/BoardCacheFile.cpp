@@ -0,0 +1,560 @@
+#include "BoardCacheFile.h"
+#include "../core/MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+// Snapshot layout (all integers little-endian):
+//   header   magic "PCBSNAP\0", version, source hash, source size, parse ms,
+//            num_format/parts/pins/nails, valid
+//   strings  deduplicated table; records below refer to strings by index
+//   sections format, outline_segments, part_outline_segments, parts, pins,
+//            nails, circles, rectangles, ovals (each a u32 count + records),
+//            outline arcs, trace nets (string ids), trace layers (layer,
+//            segment records, arc records)
+//   trailer  kTrailer, so a truncated write is never accepted
+namespace {
+
+const char kMagic[8] = {'P', 'C', 'B', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t kTrailer = 0x50414E53; // "SNAP"
+
+class SnapshotWriter {
+public:
+    std::vector<char> out;
+
+    void u8(uint8_t v) { out.push_back(static_cast<char>(v)); }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (i * 8)) & 0xFF));
+    }
+    void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+    void u64(uint64_t v) {
+        u32(static_cast<uint32_t>(v));
+        u32(static_cast<uint32_t>(v >> 32));
+    }
+    void f32(float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    void f64(double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u64(bits);
+    }
+    void point(const BRDPoint& p) {
+        i32(p.x);
+        i32(p.y);
+    }
+    void arc(const BRDArc& a) {
+        point(a.center);
+        f32(a.radius);
+        f32(a.start_angle);
+        f32(a.sweep_angle);
+        f32(a.width);
+        u32(a.net);
+    }
+    void raw(const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        out.insert(out.end(), p, p + size);
+    }
+};
+
+// Collects every distinct string once; pin nets and names repeat heavily
+class StringTable {
+public:
+    uint32_t Add(const std::string& s) {
+        auto inserted = index.emplace(s, static_cast<uint32_t>(strings.size()));
+        if (inserted.second) strings.push_back(&inserted.first->first);
+        return inserted.first->second;
+    }
+    uint32_t Get(const std::string& s) const { return index.at(s); }
+
+    std::vector<const std::string*> strings; // in id order; keys are stable in the map
+
+private:
+    std::unordered_map<std::string, uint32_t> index;
+};
+
+float ReadF32(ByteReader& r) {
+    uint32_t bits = r.u32();
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+double ReadF64(ByteReader& r) {
+    uint64_t bits = r.u64();
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+BRDPoint ReadPoint(ByteReader& r) {
+    int x = r.i32();
+    int y = r.i32();
+    return BRDPoint(x, y);
+}
+
+const size_t kArcRecordSize = 28;
+
+BRDArc ReadArc(ByteReader& r) {
+    BRDArc arc;
+    arc.center = ReadPoint(r);
+    arc.radius = ReadF32(r);
+    arc.start_angle = ReadF32(r);
+    arc.sweep_angle = ReadF32(r);
+    arc.width = ReadF32(r);
+    arc.net = r.u32();
+    return arc;
+}
+
+// Element count for a section, rejecting counts the remaining bytes cannot hold
+bool ReadCount(ByteReader& r, size_t min_record_size, uint32_t& count) {
+    count = r.u32();
+    return r.ok() && static_cast<uint64_t>(count) * min_record_size <= r.remaining();
+}
+
+} // namespace
+
+bool BoardCacheFile::VerifyFormat(ByteView buffer) {
+    if (buffer.size() < sizeof(kMagic) + 4) return false;
+    if (std::memcmp(buffer.data(), kMagic, sizeof(kMagic)) != 0) return false;
+    return ByteReader::LoadU32(buffer.data() + sizeof(kMagic)) == kVersion;
+}
+
+bool BoardCacheFile::Load(ByteView buffer, const std::string& filepath) {
+    ClearData();
+    if (!VerifyFormat(buffer)) {
+        error_msg = "Not a board cache snapshot (or wrong version): " + filepath;
+        return false;
+    }
+
+    auto damaged = [&]() {
+        ClearData();
+        error_msg = "Board cache snapshot is damaged: " + filepath;
+        return false;
+    };
+
+    ByteReader r(buffer, sizeof(kMagic) + 4);
+    source_hash = r.u64();
+    source_size = r.u64();
+    source_parse_ms = ReadF64(r);
+    num_format = r.u32();
+    num_parts = r.u32();
+    num_pins = r.u32();
+    num_nails = r.u32();
+    bool snapshot_valid = r.u8() != 0;
+
+    uint32_t count = 0;
+    std::vector<std::string> strings;
+    if (!ReadCount(r, 4, count)) return damaged();
+    strings.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t len = r.u32();
+        strings.push_back(r.string(len));
+    }
+    if (!r.ok()) return damaged();
+
+    bool strings_ok = true;
+    auto str = [&](ByteReader& reader) -> const std::string& {
+        uint32_t id = reader.u32();
+        if (id < strings.size()) return strings[id];
+        strings_ok = false;
+        static const std::string empty;
+        return empty;
+    };
+    // Pin strings go into string_pool; each table entry is interned once
+    std::vector<uint32_t> pool_ids(strings.size(), StringPool::kInvalid);
+    auto pool_id = [&](ByteReader& reader) {
+        uint32_t id = reader.u32();
+        if (id >= strings.size()) {
+            strings_ok = false;
+            return kEmptyStringId;
+        }
+        if (pool_ids[id] == StringPool::kInvalid) pool_ids[id] = string_pool.Intern(strings[id]);
+        return pool_ids[id];
+    };
+
+    if (!ReadCount(r, 8, count)) return damaged();
+    format.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) format.push_back(ReadPoint(r));
+
+    for (auto* segments : {&outline_segments, &part_outline_segments}) {
+        if (!ReadCount(r, 16, count)) return damaged();
+        segments->reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            BRDPoint a = ReadPoint(r);
+            BRDPoint b = ReadPoint(r);
+            segments->emplace_back(a, b);
+        }
+    }
+
+    if (!ReadCount(r, 30, count)) return damaged();
+    parts.resize(count);
+    for (auto& part : parts) {
+        part.name = str(r);
+        part.mfgcode = str(r);
+        part.mounting_side = static_cast<BRDPartMountingSide>(r.u8());
+        part.part_type = static_cast<BRDPartType>(r.u8());
+        part.end_of_pins = r.u32();
+        part.p1 = ReadPoint(r);
+        part.p2 = ReadPoint(r);
+    }
+
+    if (!ReadCount(r, 41, count)) return damaged();
+    pins.resize(count);
+    for (auto& pin : pins) {
+        pin.pos = ReadPoint(r);
+        pin.probe = r.i32();
+        pin.part = r.u32();
+        pin.side = static_cast<BRDPinSide>(r.u8());
+        pin.radius = ReadF64(r);
+        pin.net_id = pool_id(r);
+        pin.snum_id = pool_id(r);
+        pin.name_id = pool_id(r);
+        pin.comment = str(r);
+    }
+
+    if (!ReadCount(r, 17, count)) return damaged();
+    nails.resize(count);
+    for (auto& nail : nails) {
+        nail.probe = r.u32();
+        nail.pos = ReadPoint(r);
+        nail.side = static_cast<BRDPartMountingSide>(r.u8());
+        nail.net = str(r);
+    }
+
+    if (!ReadCount(r, 28, count)) return damaged();
+    circles.resize(count);
+    for (auto& c : circles) {
+        c.center = ReadPoint(r);
+        c.radius = ReadF32(r);
+        c.r = ReadF32(r);
+        c.g = ReadF32(r);
+        c.b = ReadF32(r);
+        c.a = ReadF32(r);
+    }
+
+    if (!ReadCount(r, 36, count)) return damaged();
+    rectangles.resize(count);
+    for (auto& rect : rectangles) {
+        rect.center = ReadPoint(r);
+        rect.width = ReadF32(r);
+        rect.height = ReadF32(r);
+        rect.rotation = ReadF32(r);
+        rect.r = ReadF32(r);
+        rect.g = ReadF32(r);
+        rect.b = ReadF32(r);
+        rect.a = ReadF32(r);
+    }
+
+    if (!ReadCount(r, 36, count)) return damaged();
+    ovals.resize(count);
+    for (auto& oval : ovals) {
+        oval.center = ReadPoint(r);
+        oval.width = ReadF32(r);
+        oval.height = ReadF32(r);
+        oval.rotation = ReadF32(r);
+        oval.r = ReadF32(r);
+        oval.g = ReadF32(r);
+        oval.b = ReadF32(r);
+        oval.a = ReadF32(r);
+    }
+
+    if (!ReadCount(r, kArcRecordSize, count)) return damaged();
+    outline_arcs.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) outline_arcs.push_back(ReadArc(r));
+
+    if (!ReadCount(r, 4, count)) return damaged();
+    trace_nets.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) trace_nets.push_back(str(r));
+
+    if (!ReadCount(r, 12, count)) return damaged();
+    trace_layers.resize(count);
+    bool traces_ok = true;
+    for (auto& layer : trace_layers) {
+        layer.layer = r.i32();
+        uint32_t segment_count = 0;
+        if (!ReadCount(r, 24, segment_count)) return damaged();
+        layer.segments.resize(segment_count);
+        for (auto& trace : layer.segments) {
+            trace.a = ReadPoint(r);
+            trace.b = ReadPoint(r);
+            trace.width = ReadF32(r);
+            trace.net = r.u32();
+            if (trace.net >= trace_nets.size()) traces_ok = false;
+        }
+        uint32_t arc_count = 0;
+        if (!ReadCount(r, kArcRecordSize, arc_count)) return damaged();
+        layer.arcs.reserve(arc_count);
+        for (uint32_t i = 0; i < arc_count; ++i) {
+            layer.arcs.push_back(ReadArc(r));
+            if (layer.arcs.back().net >= trace_nets.size()) traces_ok = false;
+        }
+    }
+
+    if (r.u32() != kTrailer || !r.ok() || !strings_ok || !traces_ok) return damaged();
+
+    BuildIndices();
+    valid = snapshot_valid;
+    return valid;
+}
+
+std::unique_ptr<BoardCacheFile> BoardCacheFile::LoadFromCache(const std::string& cache_dir, uint64_t source_hash, uint64_t source_size) {
+    if (cache_dir.empty()) return nullptr;
+
+    std::string path = CachePath(cache_dir, source_hash);
+    std::error_code ec;
+    if (!std::filesystem::exists(std::filesystem::u8path(path), ec)) return nullptr;
+
+    MappedFile file;
+    if (!file.Open(path)) return nullptr;
+
+    auto board = std::make_unique<BoardCacheFile>();
+    if (!board->Load(ByteView(file.data(), file.size()), path)) {
+        LOG_INFO("Ignoring board cache entry " + path + ": " + board->error_msg);
+        return nullptr;
+    }
+    // A different source with the same hash name (or a stale entry) is a miss
+    if (board->source_hash != source_hash || board->source_size != source_size) return nullptr;
+    return board;
+}
+
+bool BoardCacheFile::Store(const std::string& cache_dir, uint64_t source_hash, uint64_t source_size,
+                           const BRDFileBase& board, double parse_ms) {
+    if (cache_dir.empty() || !board.IsValid()) return false;
+
+    StringTable table;
+    for (const auto& part : board.parts) {
+        table.Add(part.name);
+        table.Add(part.mfgcode);
+    }
+    for (const auto& pin : board.pins) {
+        table.Add(board.PinNet(pin));
+        table.Add(board.PinSnum(pin));
+        table.Add(board.PinName(pin));
+        table.Add(pin.comment);
+    }
+    for (const auto& nail : board.nails) table.Add(nail.net);
+    for (const auto& net : board.trace_nets) table.Add(net);
+
+    SnapshotWriter w;
+    w.raw(kMagic, sizeof(kMagic));
+    w.u32(kVersion);
+    w.u64(source_hash);
+    w.u64(source_size);
+    w.f64(parse_ms);
+    w.u32(board.num_format);
+    w.u32(board.num_parts);
+    w.u32(board.num_pins);
+    w.u32(board.num_nails);
+    w.u8(board.valid ? 1 : 0);
+
+    w.u32(static_cast<uint32_t>(table.strings.size()));
+    for (const std::string* s : table.strings) {
+        w.u32(static_cast<uint32_t>(s->size()));
+        w.raw(s->data(), s->size());
+    }
+
+    w.u32(static_cast<uint32_t>(board.format.size()));
+    for (const auto& p : board.format) w.point(p);
+
+    for (const auto* segments : {&board.outline_segments, &board.part_outline_segments}) {
+        w.u32(static_cast<uint32_t>(segments->size()));
+        for (const auto& seg : *segments) {
+            w.point(seg.first);
+            w.point(seg.second);
+        }
+    }
+
+    w.u32(static_cast<uint32_t>(board.parts.size()));
+    for (const auto& part : board.parts) {
+        w.u32(table.Get(part.name));
+        w.u32(table.Get(part.mfgcode));
+        w.u8(static_cast<uint8_t>(part.mounting_side));
+        w.u8(static_cast<uint8_t>(part.part_type));
+        w.u32(part.end_of_pins);
+        w.point(part.p1);
+        w.point(part.p2);
+    }
+
+    w.u32(static_cast<uint32_t>(board.pins.size()));
+    for (const auto& pin : board.pins) {
+        w.point(pin.pos);
+        w.i32(pin.probe);
+        w.u32(pin.part);
+        w.u8(static_cast<uint8_t>(pin.side));
+        w.f64(pin.radius);
+        w.u32(table.Get(board.PinNet(pin)));
+        w.u32(table.Get(board.PinSnum(pin)));
+        w.u32(table.Get(board.PinName(pin)));
+        w.u32(table.Get(pin.comment));
+    }
+
+    w.u32(static_cast<uint32_t>(board.nails.size()));
+    for (const auto& nail : board.nails) {
+        w.u32(nail.probe);
+        w.point(nail.pos);
+        w.u8(static_cast<uint8_t>(nail.side));
+        w.u32(table.Get(nail.net));
+    }
+
+    w.u32(static_cast<uint32_t>(board.circles.size()));
+    for (const auto& c : board.circles) {
+        w.point(c.center);
+        w.f32(c.radius);
+        w.f32(c.r);
+        w.f32(c.g);
+        w.f32(c.b);
+        w.f32(c.a);
+    }
+
+    w.u32(static_cast<uint32_t>(board.rectangles.size()));
+    for (const auto& rect : board.rectangles) {
+        w.point(rect.center);
+        w.f32(rect.width);
+        w.f32(rect.height);
+        w.f32(rect.rotation);
+        w.f32(rect.r);
+        w.f32(rect.g);
+        w.f32(rect.b);
+        w.f32(rect.a);
+    }
+
+    w.u32(static_cast<uint32_t>(board.ovals.size()));
+    for (const auto& oval : board.ovals) {
+        w.point(oval.center);
+        w.f32(oval.width);
+        w.f32(oval.height);
+        w.f32(oval.rotation);
+        w.f32(oval.r);
+        w.f32(oval.g);
+        w.f32(oval.b);
+        w.f32(oval.a);
+    }
+
+    w.u32(static_cast<uint32_t>(board.outline_arcs.size()));
+    for (const auto& arc : board.outline_arcs) w.arc(arc);
+
+    w.u32(static_cast<uint32_t>(board.trace_nets.size()));
+    for (const auto& net : board.trace_nets) w.u32(table.Get(net));
+
+    w.u32(static_cast<uint32_t>(board.trace_layers.size()));
+    for (const auto& layer : board.trace_layers) {
+        w.i32(layer.layer);
+        w.u32(static_cast<uint32_t>(layer.segments.size()));
+        for (const auto& trace : layer.segments) {
+            w.point(trace.a);
+            w.point(trace.b);
+            w.f32(trace.width);
+            w.u32(trace.net);
+        }
+        w.u32(static_cast<uint32_t>(layer.arcs.size()));
+        for (const auto& arc : layer.arcs) w.arc(arc);
+    }
+
+    w.u32(kTrailer);
+
+    // Write next to the final name and rename, so readers never map a partial file
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::u8path(cache_dir), ec);
+    std::string path = CachePath(cache_dir, source_hash);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(std::filesystem::u8path(tmp_path), std::ios::binary | std::ios::trunc);
+        if (!out.write(w.out.data(), static_cast<std::streamsize>(w.out.size()))) {
+            LOG_ERROR("Failed to write board cache entry " + tmp_path);
+            return false;
+        }
+    }
+    std::filesystem::rename(std::filesystem::u8path(tmp_path), std::filesystem::u8path(path), ec);
+    if (ec) {
+        LOG_ERROR("Failed to store board cache entry " + path + ": " + ec.message());
+        std::filesystem::remove(std::filesystem::u8path(tmp_path), ec);
+        return false;
+    }
+    return true;
+}
+
+uint64_t BoardCacheFile::ContentHash(ByteView data) {
+    // XXH64 with seed 0: fast enough to run on every open of a multi-MB board
+    const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t P3 = 0x165667B19E3779F9ULL;
+    const uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+    auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    auto load64 = [](const char* p) {
+        return static_cast<uint64_t>(ByteReader::LoadU32(p)) | (static_cast<uint64_t>(ByteReader::LoadU32(p + 4)) << 32);
+    };
+    auto round = [&](uint64_t acc, uint64_t input) {
+        acc += input * P2;
+        acc = rotl(acc, 31);
+        return acc * P1;
+    };
+    auto merge = [&](uint64_t acc, uint64_t val) {
+        acc ^= round(0, val);
+        return acc * P1 + P4;
+    };
+
+    const char* p = data.data();
+    const char* end = data.end();
+    const size_t len = data.size();
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = P1 + P2, v2 = P2, v3 = 0, v4 = 0 - P1;
+        const char* limit = end - 32;
+        do {
+            v1 = round(v1, load64(p));
+            v2 = round(v2, load64(p + 8));
+            v3 = round(v3, load64(p + 16));
+            v4 = round(v4, load64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge(h, v1);
+        h = merge(h, v2);
+        h = merge(h, v3);
+        h = merge(h, v4);
+    } else {
+        h = P5;
+    }
+    h += static_cast<uint64_t>(len);
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= round(0, load64(p));
+        h = rotl(h, 27) * P1 + P4;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(ByteReader::LoadU32(p)) * P1;
+        h = rotl(h, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= static_cast<uint64_t>(static_cast<unsigned char>(*p)) * P5;
+        h = rotl(h, 11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string BoardCacheFile::CachePath(const std::string& cache_dir, uint64_t source_hash) {
+    static const char hex[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        name[i] = hex[source_hash & 0xF];
+        source_hash >>= 4;
+    }
+    std::string path = cache_dir;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') path += '/';
+    return path + name + ".pcbcache";
+}
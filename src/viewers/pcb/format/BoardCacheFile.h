@@ -0,0 +1,49 @@
+#pragma once
+
+#include "BRDFileBase.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Versioned binary snapshot of a fully parsed board.
+//
+// A snapshot stores everything BRDFileBase exposes (parts, pins, nails,
+// outlines, pad geometry, traces) after all format-specific decoding, aliasing
+// and diode-reading resolution has been applied, so reopening the same source
+// skips XOR/DES/JSON decoding and translation entirely. Entries are keyed
+// by a hash of the source bytes; any version or key mismatch is a miss.
+class BoardCacheFile : public BRDFileBase {
+public:
+    // Bump whenever the snapshot layout or the parsers' output changes
+    static constexpr uint32_t kVersion = 4;
+
+    BoardCacheFile() = default;
+    ~BoardCacheFile() = default;
+
+    // Load a snapshot image (not a source board file)
+    bool Load(ByteView buffer, const std::string& filepath = "") override;
+    bool VerifyFormat(ByteView buffer) override;
+
+    // Returns the cached board for a source with this hash/size, or nullptr on
+    // a miss, version mismatch or damaged entry
+    static std::unique_ptr<BoardCacheFile> LoadFromCache(const std::string& cache_dir, uint64_t source_hash, uint64_t source_size);
+
+    // Writes a snapshot of board (replacing any existing entry). parse_ms is
+    // the cold parse time, reported back on later warm opens.
+    static bool Store(const std::string& cache_dir, uint64_t source_hash, uint64_t source_size,
+                      const BRDFileBase& board, double parse_ms);
+
+    // 64-bit content hash (XXH64) used as the cache key
+    static uint64_t ContentHash(ByteView data);
+
+    static std::string CachePath(const std::string& cache_dir, uint64_t source_hash);
+
+    uint64_t SourceHash() const { return source_hash; }
+    uint64_t SourceSize() const { return source_size; }
+    double SourceParseMs() const { return source_parse_ms; }
+
+private:
+    uint64_t source_hash = 0;
+    uint64_t source_size = 0;
+    double source_parse_ms = 0.0;
+};
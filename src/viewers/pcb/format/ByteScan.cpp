@@ -0,0 +1,185 @@
+#include "ByteScan.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BYTESCAN_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BYTESCAN_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// CandidateMask sets bit i when p[i] and p[i + size - 1] match the needle's
+// first and last byte; XorLanes decodes kLanes bytes
+#if defined(BYTESCAN_AVX2)
+constexpr size_t kLanes = 32;
+
+inline uint32_t CandidateMask(const char* p, const ByteScan::Needle& n) {
+    const __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),
+                                            _mm256_set1_epi8(static_cast<char>(n.bytes[0])));
+    const __m256i last = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n.size - 1)),
+                                           _mm256_set1_epi8(static_cast<char>(n.bytes[n.size - 1])));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first, last)));
+}
+
+inline void XorLanes(char* p, uint8_t key) {
+    __m256i* v = reinterpret_cast<__m256i*>(p);
+    _mm256_storeu_si256(v, _mm256_xor_si256(_mm256_loadu_si256(v), _mm256_set1_epi8(static_cast<char>(key))));
+}
+#elif defined(BYTESCAN_SSE2)
+constexpr size_t kLanes = 32; // two vectors per step
+
+inline uint32_t CandidateMask16(const char* p, __m128i first_byte, __m128i last_byte, size_t last) {
+    const __m128i first = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), first_byte);
+    const __m128i tail = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + last)), last_byte);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first, tail)));
+}
+
+inline uint32_t CandidateMask(const char* p, const ByteScan::Needle& n) {
+    const __m128i first_byte = _mm_set1_epi8(static_cast<char>(n.bytes[0]));
+    const __m128i last_byte = _mm_set1_epi8(static_cast<char>(n.bytes[n.size - 1]));
+    return CandidateMask16(p, first_byte, last_byte, n.size - 1) |
+           (CandidateMask16(p + 16, first_byte, last_byte, n.size - 1) << 16);
+}
+
+inline void XorLanes(char* p, uint8_t key) {
+    const __m128i k = _mm_set1_epi8(static_cast<char>(key));
+    __m128i* v = reinterpret_cast<__m128i*>(p);
+    _mm_storeu_si128(v, _mm_xor_si128(_mm_loadu_si128(v), k));
+    _mm_storeu_si128(v + 1, _mm_xor_si128(_mm_loadu_si128(v + 1), k));
+}
+#else
+constexpr size_t kLanes = 8;
+
+inline uint32_t CandidateMask(const char* p, const ByteScan::Needle& n) {
+    const char first = static_cast<char>(n.bytes[0]), last = static_cast<char>(n.bytes[n.size - 1]);
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kLanes; ++i) {
+        if (p[i] == first && p[i + n.size - 1] == last) mask |= 1u << i;
+    }
+    return mask;
+}
+
+inline void XorLanes(char* p, uint8_t key) {
+    for (size_t i = 0; i < kLanes; ++i) p[i] ^= static_cast<char>(key);
+}
+#endif
+
+inline unsigned LowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+inline bool Active(const ByteScan::Needle& n) {
+    return n.pos == ByteView::npos && !(n.unless && *n.unless != ByteView::npos);
+}
+
+inline bool MatchAt(const char* data, size_t pos, const ByteScan::Needle& n) {
+    return std::memcmp(data + pos, n.bytes, n.size) == 0;
+}
+
+} // namespace
+
+size_t ByteScan::Find(char* data, size_t size, size_t from, Needle* needles, size_t count, int stop, uint8_t xor_key) {
+    size_t end = size; // shrinks to the stop match
+    size_t longest = 1;
+    for (size_t i = 0; i < count; ++i) {
+        if (needles[i].size == 0 || needles[i].size > kMaxNeedle) return size;
+        longest = std::max(longest, needles[i].size);
+    }
+    Needle* stop_needle = stop >= 0 && static_cast<size_t>(stop) < count && Active(needles[stop]) ? &needles[stop] : nullptr;
+    auto any_active = [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            if (Active(needles[i])) return true;
+        }
+        return false;
+    };
+
+    size_t b = std::min(from, size);
+    // Whole blocks while every needle's last-byte load stays inside the buffer.
+    // The stop needle is resolved first so the others can be clipped to it,
+    // and a block is decoded only after it has been searched
+    while (b < end && size - b >= kLanes + longest - 1) {
+        if (stop_needle) {
+            for (uint32_t m = CandidateMask(data + b, *stop_needle); m; m &= m - 1) {
+                const size_t p = b + LowestBit(m);
+                if (MatchAt(data, p, *stop_needle)) {
+                    stop_needle->pos = end = p;
+                    stop_needle = nullptr;
+                    break;
+                }
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            Needle& n = needles[i];
+            if (!Active(n) || &n == stop_needle) continue;
+            for (uint32_t m = CandidateMask(data + b, n); m; m &= m - 1) {
+                const size_t p = b + LowestBit(m);
+                if (p >= end) break;
+                if (MatchAt(data, p, n)) {
+                    n.pos = p;
+                    break;
+                }
+            }
+        }
+        if (xor_key) {
+            if (end - b >= kLanes) {
+                XorLanes(data + b, xor_key);
+            } else {
+                for (size_t p = b; p < end; ++p) data[p] ^= static_cast<char>(xor_key);
+            }
+        } else if (!any_active()) {
+            b = end; // nothing left to find or decode
+            break;
+        }
+        b = std::min(b + kLanes, end);
+    }
+
+    // Tail, one position at a time
+    for (; b < end; ++b) {
+        if (stop_needle && size - b >= stop_needle->size && MatchAt(data, b, *stop_needle)) {
+            stop_needle->pos = end = b;
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            Needle& n = needles[i];
+            if (Active(n) && &n != stop_needle && size - b >= n.size && MatchAt(data, b, n)) n.pos = b;
+        }
+        if (xor_key) data[b] ^= static_cast<char>(xor_key);
+    }
+
+    // Matches that run into the stop match are not inside the scanned range
+    for (size_t i = 0; i < count; ++i) {
+        Needle& n = needles[i];
+        if (static_cast<int>(i) != stop && n.pos != ByteView::npos && n.pos >= from && n.pos + n.size > end) {
+            n.pos = ByteView::npos;
+        }
+    }
+    return end;
+}
+
+size_t ByteScan::Find(const char* data, size_t size, size_t from, Needle* needles, size_t count, int stop) {
+    // Nothing is written without an XOR key
+    return Find(const_cast<char*>(data), size, from, needles, count, stop, 0);
+}
+
+const char* ByteScan::Isa() {
+#if defined(BYTESCAN_AVX2)
+    return "AVX2";
+#elif defined(BYTESCAN_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
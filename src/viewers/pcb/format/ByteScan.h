@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ByteView.h"
+#include <cstddef>
+#include <cstdint>
+
+// Multi-pattern search over a byte buffer, optionally XOR-decoding it in the
+// same pass. Candidates are found 32 positions at a time (one AVX2 or two SSE2
+// compares) by matching each pattern's first and last byte, then confirmed
+// with memcmp; builds without either fall back to a scalar loop.
+class ByteScan {
+public:
+    struct Needle {
+        const uint8_t* bytes = nullptr; // as the pattern appears in the scanned (undecoded) bytes
+        size_t size = 0;                // 1..kMaxNeedle
+        size_t pos = ByteView::npos;    // first match, filled in by Find
+        const size_t* unless = nullptr; // stop looking once *unless is set (optional)
+    };
+
+    static constexpr size_t kMaxNeedle = 32;
+
+    // Fills in pos for every needle still at npos with its first match at or
+    // after from. If stop is a needle index, scanning ends at that needle's
+    // first match and other needles only match if they end before it. With a
+    // non-zero xor_key the scanned range [from, end) is XORed in place after
+    // being searched, so needles must be given in their encoded form.
+    // Returns the end of the scanned range (stop match or size).
+    static size_t Find(char* data, size_t size, size_t from, Needle* needles, size_t count, int stop = -1,
+                       uint8_t xor_key = 0);
+    // Search only, for read-only buffers
+    static size_t Find(const char* data, size_t size, size_t from, Needle* needles, size_t count, int stop = -1);
+
+    // Instruction set the scan was built for ("AVX2", "SSE2" or "scalar")
+    static const char* Isa();
+};
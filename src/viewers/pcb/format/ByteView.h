@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Non-owning view over a range of bytes (file buffer, block, decrypted data).
+// The viewed memory must outlive the view.
+class ByteView {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    ByteView() = default;
+    ByteView(const char* data, size_t size) : data_(data), size_(size) {}
+    ByteView(const std::vector<char>& v) : data_(v.data()), size_(v.size()) {}
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    char operator[](size_t i) const { return data_[i]; }
+
+    // Sub-range clamped to the view
+    ByteView subview(size_t offset, size_t count = npos) const {
+        if (offset >= size_) return ByteView(end(), 0);
+        return ByteView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    // Offset of the first occurrence of pattern at or after from, or npos
+    size_t find(const void* pattern, size_t pattern_size, size_t from = 0) const {
+        if (from >= size_) return npos;
+        const char* p = static_cast<const char*>(pattern);
+        const char* it = std::search(data_ + from, end(), p, p + pattern_size);
+        return it == end() ? npos : static_cast<size_t>(it - data_);
+    }
+    size_t find(const char* cstr, size_t from = 0) const {
+        return find(cstr, std::char_traits<char>::length(cstr), from);
+    }
+
+    // Offset of the last occurrence of c at or before pos, or npos
+    size_t rfind(char c, size_t pos) const {
+        if (size_ == 0) return npos;
+        for (size_t i = std::min(pos, size_ - 1) + 1; i-- > 0;) {
+            if (data_[i] == c) return i;
+        }
+        return npos;
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Bounds-checked little-endian cursor over a ByteView. A read that would run
+// past the end returns zero/empty, leaves the position at the end and clears
+// ok(), so parsers can check once after a group of fields.
+class ByteReader {
+public:
+    explicit ByteReader(ByteView view, size_t pos = 0) : view_(view), pos_(std::min(pos, view.size())) {}
+
+    size_t pos() const { return pos_; }
+    size_t size() const { return view_.size(); }
+    size_t remaining() const { return view_.size() - pos_; }
+    bool ok() const { return ok_; }
+    bool can_read(size_t n) const { return n <= remaining(); }
+
+    void seek(size_t pos) {
+        if (pos > view_.size()) {
+            ok_ = false;
+            pos = view_.size();
+        }
+        pos_ = pos;
+    }
+    void skip(size_t n) { seek(n <= remaining() ? pos_ + n : view_.size() + 1); }
+
+    uint8_t u8() {
+        if (!can_read(1)) return fail<uint8_t>();
+        return static_cast<uint8_t>(view_.data()[pos_++]);
+    }
+    uint32_t u32() {
+        if (!can_read(4)) return fail<uint32_t>();
+        uint32_t v = LoadU32(view_.data() + pos_);
+        pos_ += 4;
+        return v;
+    }
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+    uint64_t u64() {
+        uint64_t lo = u32();
+        uint64_t hi = u32();
+        return lo | (hi << 32);
+    }
+
+    // Value at an absolute offset without moving the cursor (0 if out of range)
+    uint32_t peek_u32(size_t offset) const {
+        return offset <= view_.size() && view_.size() - offset >= 4 ? LoadU32(view_.data() + offset) : 0;
+    }
+
+    ByteView bytes(size_t n) {
+        if (!can_read(n)) return fail<ByteView>();
+        ByteView v(view_.data() + pos_, n);
+        pos_ += n;
+        return v;
+    }
+    std::string string(size_t n) {
+        ByteView v = bytes(n);
+        return std::string(v.data() ? v.data() : "", v.size());
+    }
+
+    static uint32_t LoadU32(const char* p) {
+        const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+        return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+               (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+    }
+
+private:
+    template <typename T>
+    T fail() {
+        ok_ = false;
+        pos_ = view_.size();
+        return T{};
+    }
+
+    ByteView view_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
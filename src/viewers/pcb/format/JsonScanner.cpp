@@ -0,0 +1,175 @@
+#include "JsonScanner.h"
+#include <cstring>
+
+void JsonScanner::SkipSpace() {
+    while (pos < size) {
+        char c = data[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        pos++;
+    }
+}
+
+void JsonScanner::ValueDone() {
+    if (depth == 0) {
+        done = true;
+        return;
+    }
+    need_comma = true;
+    expect_key = in_object[depth - 1];
+}
+
+JsonScanner::Token JsonScanner::Next() {
+    if (done) return Token::End;
+    SkipSpace();
+    if (pos >= size) return Fail(); // truncated
+
+    char c = data[pos];
+    if (c == '}' || c == ']') {
+        const bool object = c == '}';
+        if (depth == 0 || in_object[depth - 1] != object) return Fail();
+        if (object && !expect_key) return Fail(); // a key still waiting for its value
+        pos++;
+        depth--;
+        need_comma = false;
+        ValueDone();
+        return object ? Token::ObjectEnd : Token::ArrayEnd;
+    }
+
+    if (need_comma) {
+        if (c != ',') return Fail();
+        pos++;
+        need_comma = false;
+        SkipSpace();
+        if (pos >= size) return Fail();
+        c = data[pos];
+        if (c == '}' || c == ']') return Fail(); // trailing comma
+    }
+
+    if (depth > 0 && in_object[depth - 1] && expect_key) {
+        if (c != '"' || ScanString(true) == Token::Error) return Fail();
+        SkipSpace();
+        if (pos >= size || data[pos] != ':') return Fail();
+        pos++;
+        expect_key = false;
+        return Token::Key;
+    }
+
+    switch (c) {
+        case '{':
+        case '[':
+            if (depth == kMaxDepth) return Fail();
+            in_object[depth++] = c == '{';
+            expect_key = c == '{';
+            need_comma = false;
+            pos++;
+            return c == '{' ? Token::ObjectBegin : Token::ArrayBegin;
+        case '"':
+            if (ScanString(false) == Token::Error) return Fail();
+            ValueDone();
+            return Token::String;
+        case 't': return ScanLiteral("true", 4, Token::True);
+        case 'f': return ScanLiteral("false", 5, Token::False);
+        case 'n': return ScanLiteral("null", 4, Token::Null);
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) return ScanNumber();
+            return Fail();
+    }
+}
+
+JsonScanner::Token JsonScanner::ScanString(bool is_key) {
+    const size_t begin = ++pos; // past the opening quote
+    // Fast path: no escapes, the text is a view into the input
+    while (pos < size && data[pos] != '"' && data[pos] != '\\') pos++;
+    if (pos >= size) return Token::Error;
+    if (data[pos] == '"') {
+        text = std::string_view(data + begin, pos - begin);
+        pos++;
+        return is_key ? Token::Key : Token::String;
+    }
+
+    scratch.assign(data + begin, pos - begin);
+    while (pos < size && data[pos] != '"') {
+        char c = data[pos++];
+        if (c != '\\') {
+            scratch.push_back(c);
+            continue;
+        }
+        if (pos >= size) return Token::Error;
+        char e = data[pos++];
+        switch (e) {
+            case '"': case '\\': case '/': scratch.push_back(e); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u': {
+                if (size - pos < 4) return Token::Error;
+                uint32_t cp = 0;
+                for (int i = 0; i < 4; ++i) {
+                    char h = data[pos++];
+                    cp <<= 4;
+                    if (h >= '0' && h <= '9') cp |= h - '0';
+                    else if (h >= 'a' && h <= 'f') cp |= h - 'a' + 10;
+                    else if (h >= 'A' && h <= 'F') cp |= h - 'A' + 10;
+                    else return Token::Error;
+                }
+                // UTF-8; surrogate halves are passed through as-is
+                if (cp < 0x80) {
+                    scratch.push_back(static_cast<char>(cp));
+                } else if (cp < 0x800) {
+                    scratch.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                    scratch.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                } else {
+                    scratch.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                    scratch.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                    scratch.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                }
+                break;
+            }
+            default: return Token::Error;
+        }
+    }
+    if (pos >= size) return Token::Error;
+    pos++;
+    text = scratch;
+    return is_key ? Token::Key : Token::String;
+}
+
+JsonScanner::Token JsonScanner::ScanNumber() {
+    const size_t begin = pos;
+    if (data[pos] == '-') pos++;
+    bool digits = false;
+    while (pos < size) {
+        char c = data[pos];
+        if (c >= '0' && c <= '9') {
+            digits = true;
+        } else if (c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-') {
+            break;
+        }
+        pos++;
+    }
+    if (!digits) return Fail();
+    text = std::string_view(data + begin, pos - begin);
+    ValueDone();
+    return Token::Number;
+}
+
+JsonScanner::Token JsonScanner::ScanLiteral(const char* word, size_t length, Token token) {
+    if (size - pos < length || std::memcmp(data + pos, word, length) != 0) return Fail();
+    pos += length;
+    ValueDone();
+    return token;
+}
+
+JsonScanner::Token JsonScanner::SkipValue(Token first) {
+    if (first != Token::ObjectBegin && first != Token::ArrayBegin) {
+        return first == Token::Error || first == Token::End ? Token::Error : first;
+    }
+    const int outer = depth - 1;
+    while (depth > outer) {
+        Token t = Next();
+        if (t == Token::Error || t == Token::End) return Token::Error;
+    }
+    return first;
+}
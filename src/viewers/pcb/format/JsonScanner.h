@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ByteView.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Pull tokenizer for JSON over a borrowed byte range. It makes one pass,
+// builds no tree and allocates nothing except when a string contains escapes
+// (decoded into a reused scratch buffer). Object keys are reported as Key
+// tokens, so callers can track where they are with a small state machine and
+// skip what they do not need with SkipValue().
+//
+// Parsing stops at the first malformed byte (Error) or once the outermost
+// value is closed (End); trailing bytes after it are not looked at.
+class JsonScanner {
+public:
+    enum class Token : uint8_t {
+        ObjectBegin, ObjectEnd, ArrayBegin, ArrayEnd,
+        Key, String, Number, True, False, Null,
+        End, Error
+    };
+
+    static constexpr int kMaxDepth = 64;
+
+    explicit JsonScanner(ByteView json) : data(json.data()), size(json.size()) {}
+
+    Token Next();
+    // Text of the last Key, String or Number token; valid until the next call
+    std::string_view Text() const { return text; }
+    // Bytes consumed so far
+    size_t Offset() const { return pos; }
+    // Open containers around the next token
+    int Depth() const { return depth; }
+
+    // Consumes the rest of a value whose first token was just returned (no-op
+    // for scalars). Returns first, or Error if the value is malformed
+    Token SkipValue(Token first);
+
+private:
+    Token Fail() { pos = size; return Token::Error; }
+    Token ScanString(bool is_key);
+    Token ScanNumber();
+    Token ScanLiteral(const char* word, size_t length, Token token);
+    void SkipSpace();
+    // After a complete value: objects expect the next key, done at depth 0
+    void ValueDone();
+
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    int depth = 0;
+    bool in_object[kMaxDepth] = {};
+    bool expect_key = false;   // inside an object, before a key (or its closing brace)
+    bool need_comma = false;   // a value was just completed
+    bool done = false;
+    std::string_view text;
+    std::string scratch; // decoded strings that contained escapes
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Whitespace-separated fields of one line of a text board file, read with
+// std::from_chars: no locale, no allocation, never reads past the line.
+// Numbers follow strtol: leading whitespace and a '+' sign are accepted, and
+// a field that is not a number reads as 0 without consuming anything.
+class TextCursor {
+public:
+    explicit TextCursor(std::string_view line) : p(line.data()), end(line.data() + line.size()) {}
+
+    static bool IsSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    int ReadInt() {
+        const char* start = p;
+        SkipSpace();
+        if (p < end && *p == '+') p++;
+        int value = 0;
+        auto result = std::from_chars(p, end, value);
+        if (result.ptr == p) {
+            p = start;
+            return 0;
+        }
+        p = result.ptr;
+        return result.ec == std::errc() ? value : 0;
+    }
+
+    // Negative values read as 0 and set *negative (for the caller's error message)
+    unsigned int ReadUInt(bool* negative = nullptr) {
+        int value = ReadInt();
+        if (value < 0) {
+            if (negative) *negative = true;
+            return 0u;
+        }
+        return static_cast<unsigned int>(value);
+    }
+
+    // Next run of non-space characters (empty at the end of the line)
+    std::string_view ReadToken() {
+        SkipSpace();
+        const char* start = p;
+        while (p < end && !IsSpace(*p)) p++;
+        std::string_view token(start, static_cast<size_t>(p - start));
+        if (p < end) p++; // the separator
+        return token;
+    }
+    std::string ReadStr() { return std::string(ReadToken()); }
+
+private:
+    void SkipSpace() {
+        while (p < end && IsSpace(*p)) p++;
+    }
+
+    const char* p;
+    const char* end;
+};
+
+// The part of text before its first NUL, or all of it if there is none
+inline std::string_view TextBeforeNul(std::string_view text) {
+    if (const void* nul = std::memchr(text.data(), 0, text.size())) {
+        text = text.substr(0, static_cast<size_t>(static_cast<const char*>(nul) - text.data()));
+    }
+    return text;
+}
+
+// Calls fn(line) for each line of text split at CR/LF, with leading whitespace
+// trimmed and blank lines skipped, until fn returns false. Like the C-string
+// line splitter it replaces, the text ends at the first NUL. Returns false if
+// fn stopped early
+template <typename Fn>
+bool ForEachTextLine(std::string_view text, Fn&& fn) {
+    text = TextBeforeNul(text);
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* line_end = p;
+        while (line_end < end && *line_end != '\n' && *line_end != '\r') line_end++;
+        while (p < line_end && TextCursor::IsSpace(*p)) p++;
+        if (p < line_end && !fn(std::string_view(p, static_cast<size_t>(line_end - p)))) return false;
+        p = line_end + (line_end < end ? 1 : 0);
+    }
+    return true;
+}
+
+// One header line of a text board file and the record lines up to the next
+// header. block is what the caller's header test returned for the line
+struct TextSection {
+    int block = 0;
+    std::string_view header;
+    std::string_view body;
+};
+
+// Finds the section headers in one pass: header_block(line) returns a block
+// number for a header line and 0 for a record line. Lines before the first
+// header belong to no section
+template <typename HeaderFn>
+std::vector<TextSection> SplitTextSections(std::string_view text, HeaderFn&& header_block) {
+    std::vector<TextSection> sections;
+    text = TextBeforeNul(text); // bodies must end where the lines do
+    const char* end = text.data() + text.size();
+    ForEachTextLine(text, [&](std::string_view line) {
+        const int block = header_block(line);
+        if (block == 0) return true;
+        if (!sections.empty()) {
+            TextSection& last = sections.back();
+            last.body = std::string_view(last.body.data(), static_cast<size_t>(line.data() - last.body.data()));
+        }
+        const char* body = line.data() + line.size();
+        sections.push_back({block, line, std::string_view(body, static_cast<size_t>(end - body))});
+        return true;
+    });
+    return sections;
+}
+
+// Splits text into pieces of about chunk_bytes that end at line breaks, so
+// ForEachTextLine over the pieces in order sees the same lines as over text
+inline std::vector<std::string_view> SplitTextChunks(std::string_view text, size_t chunk_bytes) {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t cut = std::min(text.size(), begin + std::max<size_t>(chunk_bytes, 1));
+        while (cut < text.size() && text[cut - 1] != '\n' && text[cut - 1] != '\r') cut++;
+        chunks.push_back(text.substr(begin, cut - begin));
+        begin = cut;
+    }
+    return chunks;
+}
+
+// Parses the record lines of one section into out, in parallel chunks when
+// the section is large. parse(line, record) fills one record per line and
+// returns a note, anything that tests true when there is something to report.
+// Like a serial loop, records stop once out holds limit of them; on_note(index,
+// note) is called in file order, on this thread, for each kept record's note
+template <typename Record, typename ParseFn, typename NoteFn>
+void ParseTextRecords(std::string_view body, size_t limit, std::vector<Record>& out, ParseFn&& parse, NoteFn&& on_note) {
+    using Note = decltype(parse(std::string_view(), std::declval<Record&>()));
+    struct Chunk {
+        std::vector<Record> records;
+        std::vector<std::pair<size_t, Note>> notes; // index within records
+    };
+    constexpr size_t kChunkBytes = 256 * 1024;
+    if (out.size() >= limit) return;
+
+    const std::vector<std::string_view> pieces = SplitTextChunks(body, kChunkBytes);
+    std::vector<Chunk> chunks(pieces.size());
+    Utils::ParallelFor(pieces.size(), [&](size_t c) {
+        Chunk& chunk = chunks[c];
+        ForEachTextLine(pieces[c], [&](std::string_view line) {
+            Record record;
+            Note note = parse(line, record);
+            if (note) chunk.notes.emplace_back(chunk.records.size(), std::move(note));
+            chunk.records.push_back(std::move(record));
+            return true;
+        });
+    });
+
+    size_t total = 0;
+    for (const Chunk& chunk : chunks) total += chunk.records.size();
+    out.reserve(out.size() + std::min(total, limit - out.size()));
+    for (Chunk& chunk : chunks) {
+        const size_t base = out.size();
+        const size_t take = std::min(chunk.records.size(), limit - base);
+        std::move(chunk.records.begin(), chunk.records.begin() + take, std::back_inserter(out));
+        for (auto& note : chunk.notes) {
+            if (note.first < take) on_note(base + note.first, note.second);
+        }
+        if (out.size() >= limit) break;
+    }
+}
@@ -1,5 +1,9 @@
 #include "XZZPCBFile.h"
+#include "ByteScan.h"
+#include "MappedFile.h"
+#include "Utils.h"
 #include "des.h"
+#include "JsonScanner.h"
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
@@ -12,6 +16,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <limits>
 #include <cmath>
 
 /*
@@ -31,26 +36,23 @@ void init_hexconv() {
     }
 }
 
+static const uint8_t kPostV6Marker[] = {0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36}; // v6v6555v6v6
+static const uint8_t kJsonMarker[] = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
+static const uint8_t kPartArrayKey[] = {'"', 'p', 'a', 'r', 't', '"', ':', '['};
+
 std::unique_ptr<XZZPCBFile> XZZPCBFile::LoadFromFile(const std::string& filepath) {
     std::cout << "LoadFromFile: Opening " << filepath << std::endl;
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
         std::cerr << "Error: Cannot open file " << filepath << std::endl;
         return nullptr;
     }
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(fileSize);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
     std::cout << "LoadFromFile: Creating XZZPCBFile object" << std::endl;
     auto pcbFile = std::make_unique<XZZPCBFile>();
     std::cout << "LoadFromFile: Calling Load() method" << std::endl;
-    if (pcbFile->Load(buffer, filepath)) {
+    // Parses straight from the mapping; only obfuscated files get a private decoded copy
+    if (pcbFile->Load(ByteView(file.data(), file.size()), filepath)) {
         std::cout << "LoadFromFile: Load() succeeded, returning pcbFile" << std::endl;
         return pcbFile;
     }
@@ -58,7 +60,24 @@ std::unique_ptr<XZZPCBFile> XZZPCBFile::LoadFromFile(const std::string& filepath
     return nullptr;
 }
 
-bool XZZPCBFile::Load(const std::vector<char>& buffer, const std::string& filepath) {
+bool XZZPCBFile::Load(ByteView buffer, const std::string& filepath) {
+    if (HasXorHeader(buffer)) {
+        // Obfuscated files are decoded in place, which needs a private copy
+        std::vector<char> buf(buffer.begin(), buffer.end());
+        return LoadInPlace(buf, filepath);
+    }
+
+    if (!PrepareLoad(buffer, filepath)) return false;
+    return ParseXZZPCBOriginal(buffer, FindMarkers(buffer));
+}
+
+bool XZZPCBFile::LoadInPlace(std::vector<char>& buf, const std::string& filepath) {
+    if (!PrepareLoad(buf, filepath)) return false;
+    Markers markers = DecodeInPlace(buf);
+    return ParseXZZPCBOriginal(buf, markers);
+}
+
+bool XZZPCBFile::PrepareLoad(ByteView buffer, const std::string& filepath) {
     init_hexconv(); // Initialize hex conversion table
     
     if (!VerifyFormat(buffer)) {
@@ -67,14 +86,57 @@ bool XZZPCBFile::Load(const std::vector<char>& buffer, const std::string& filepa
     }
 
     std::cout << "Loading XZZPCB file: " << filepath << " (size: " << buffer.size() << ")" << std::endl;
+    return true;
+}
 
-    // Create a mutable copy for parsing
-    std::vector<char> buf(buffer);
-    
-    return ParseXZZPCBOriginal(buf);
+bool XZZPCBFile::HasXorHeader(ByteView buf) {
+    return buf.size() > 0x10 && buf[0x10] != 0x00;
 }
 
-bool XZZPCBFile::VerifyFormat(const std::vector<char>& buffer) {
+XZZPCBFile::Markers XZZPCBFile::FindMarkers(ByteView buf) {
+    // Nothing is written without a key
+    return ScanMarkers(const_cast<char*>(buf.data()), buf.size(), 0);
+}
+
+XZZPCBFile::Markers XZZPCBFile::DecodeInPlace(std::vector<char>& buf) {
+    return ScanMarkers(buf.data(), buf.size(), HasXorHeader(buf) ? static_cast<uint8_t>(buf[0x10]) : 0);
+}
+
+XZZPCBFile::Markers XZZPCBFile::ScanMarkers(char* data, size_t size, uint8_t xor_key) {
+    // The post-v6 marker is matched as stored; everything before it is XORed
+    // with xor_key, so the JSON markers are matched in their encoded form there
+    uint8_t json_encoded[sizeof(kJsonMarker)];
+    uint8_t part_encoded[sizeof(kPartArrayKey)];
+    for (size_t i = 0; i < sizeof(kJsonMarker); ++i) json_encoded[i] = kJsonMarker[i] ^ xor_key;
+    for (size_t i = 0; i < sizeof(kPartArrayKey); ++i) part_encoded[i] = kPartArrayKey[i] ^ xor_key;
+
+    ByteScan::Needle needles[3];
+    needles[0].bytes = kPostV6Marker;
+    needles[0].size = sizeof(kPostV6Marker);
+    needles[1].bytes = json_encoded;
+    needles[1].size = sizeof(kJsonMarker);
+    needles[2].bytes = part_encoded;
+    needles[2].size = sizeof(kPartArrayKey);
+    needles[2].unless = &needles[1].pos;
+
+    // Decoding stops at the post-v6 marker; the rest of the file is plain and
+    // searched with the plain markers. Neither JSON marker contains any byte
+    // of v6v6555v6v6, so no match can straddle the boundary
+    ByteScan::Find(data, size, 0, needles, 3, xor_key ? 0 : -1, xor_key);
+    if (xor_key && needles[0].pos != ByteView::npos && needles[1].pos == ByteView::npos) {
+        needles[1].bytes = kJsonMarker;
+        needles[2].bytes = kPartArrayKey;
+        ByteScan::Find(static_cast<const char*>(data), size, needles[0].pos, needles + 1, 2);
+    }
+
+    Markers markers;
+    markers.post_v6 = needles[0].pos;
+    markers.json = needles[1].pos;
+    markers.part_array = needles[2].pos;
+    return markers;
+}
+
+bool XZZPCBFile::VerifyFormat(ByteView buffer) {
     if (buffer.size() < 6) return false;
     
     bool raw = std::string(buffer.begin(), buffer.begin() + 6) == "XZZPCB";
@@ -94,47 +156,21 @@ bool XZZPCBFile::VerifyFormat(const std::vector<char>& buffer) {
     return false;
 }
 
-bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
-    auto v6v6555v6v6 = std::vector<uint8_t>{0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
-    auto v6v6555v6v6_found = std::search(buf.begin(), buf.end(), v6v6555v6v6.begin(), v6v6555v6v6.end());
-
-    if (v6v6555v6v6_found != buf.end()) {
-        if (buf[0x10] != 0x00) {
-            uint8_t xor_key = buf[0x10];
-            for (int i = 0; i < v6v6555v6v6_found - buf.begin(); ++i) {
-                buf[i] ^= xor_key; // XOR the buffer with xor_key until v6v6555v6v6 is reached
-            }
-        }
-        ParsePostV6(v6v6555v6v6_found, buf);
-    } else {
-        if (buf[0x10] != 0) {
-            uint8_t xor_key = buf[0x10];
-            for (int i = 0; i < buf.end() - buf.begin(); ++i) {
-                buf[i] ^= xor_key; // XOR the buffer with xor_key until the end of the buffer as no v6v6555v6v6
-            }
-        }
-        
+bool XZZPCBFile::ParseXZZPCBOriginal(ByteView buf, const Markers& markers) {
+    if (markers.post_v6 != ByteView::npos) {
+        ParsePostV6(markers, buf);
+    } else if (markers.json != ByteView::npos) {
         // Also try to find JSON data in the entire buffer since there's no PostV6 section
-        std::vector<uint8_t> json_pattern = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
-        auto json_pattern_found = std::search(buf.begin(), buf.end(), json_pattern.begin(), json_pattern.end());
-        
-        if (json_pattern_found != buf.end()) {
-            std::cout << "Found JSON pattern in main buffer at position: " << (json_pattern_found - buf.begin()) << std::endl;
-            ParseJsonData(json_pattern_found + json_pattern.size(), buf);
-        } else {
-            // Try to search for JSON-like data by looking for key strings
-            std::string buffer_str(buf.begin(), buf.end());
-            size_t part_pos = buffer_str.find("\"part\":[");
-            
-            if (part_pos != std::string::npos) {
-                std::cout << "Found 'part' array in main buffer at position: " << part_pos << std::endl;
-                // Find the start of the JSON object by looking backwards for '{'
-                size_t json_start = buffer_str.rfind('{', part_pos);
-                if (json_start != std::string::npos) {
-                    std::cout << "Found JSON start in main buffer at position: " << json_start << std::endl;
-                    ParseJsonData(buf.begin() + json_start, buf);
-                }
-            }
+        std::cout << "Found JSON pattern in main buffer at position: " << markers.json << std::endl;
+        ParseJsonData(markers.json + sizeof(kJsonMarker), buf);
+    } else if (markers.part_array != ByteView::npos) {
+        // Try to search for JSON-like data by looking for key strings
+        std::cout << "Found 'part' array in main buffer at position: " << markers.part_array << std::endl;
+        // Find the start of the JSON object by looking backwards for '{'
+        size_t json_start = buf.rfind('{', markers.part_array);
+        if (json_start != ByteView::npos) {
+            std::cout << "Found JSON start in main buffer at position: " << json_start << std::endl;
+            ParseJsonData(json_start, buf);
         }
     }
 
@@ -143,64 +179,98 @@ bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
         return false;
     }
 
-    uint32_t main_data_offset = *reinterpret_cast<uint32_t*>(&buf[0x20]);
-    uint32_t net_data_offset = *reinterpret_cast<uint32_t*>(&buf[0x28]);
+    ByteReader reader(buf);
+    uint32_t main_data_offset = reader.peek_u32(0x20);
+    uint32_t net_data_offset = reader.peek_u32(0x28);
 
-    uint32_t main_data_start = main_data_offset + 0x20;
-    uint32_t net_data_start = net_data_offset + 0x20;
+    size_t main_data_start = static_cast<size_t>(main_data_offset) + 0x20;
+    size_t net_data_start = static_cast<size_t>(net_data_offset) + 0x20;
 
     if (main_data_start >= buf.size() || net_data_start >= buf.size()) {
         std::cerr << "Error: Invalid offsets in XZZPCB file" << std::endl;
         return false;
     }
 
-    uint32_t main_data_blocks_size = *reinterpret_cast<uint32_t*>(&buf[main_data_start]);
-    uint32_t net_block_size = *reinterpret_cast<uint32_t*>(&buf[net_data_start]);
+    uint32_t main_data_blocks_size = reader.peek_u32(main_data_start);
+    uint32_t net_block_size = reader.peek_u32(net_data_start);
 
     if (net_data_start + net_block_size + 4 > buf.size()) {
         std::cerr << "Error: Net block extends beyond buffer" << std::endl;
         return false;
     }
 
-    std::vector<char> net_block_buf(buf.begin() + net_data_start + 4, buf.begin() + net_data_start + net_block_size + 4);
-    ParseNetBlockOriginal(net_block_buf);
-
-    uint32_t current_pointer = main_data_start + 4;
-    while (current_pointer < main_data_start + 4 + main_data_blocks_size) {
-        if (current_pointer >= buf.size()) break;
-        
-        uint8_t block_type = buf[current_pointer];
-        current_pointer += 1;
+    ParseNetBlockOriginal(buf.subview(net_data_start + 4, net_block_size));
+
+    // Phase 1: index block boundaries, noting the board outline blocks (the
+    // layer is the first field of both arc and line blocks)
+    std::vector<BlockRef> blocks;
+    std::vector<BlockRef> outline_blocks;
+    reader.seek(main_data_start + 4);
+    const size_t main_data_end = main_data_start + 4 + main_data_blocks_size;
+    while (reader.pos() < main_data_end) {
+        if (!reader.can_read(1)) break;
+        uint8_t block_type = reader.u8();
         
-        if (current_pointer + 4 > buf.size()) break;
-        uint32_t block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
+        if (!reader.can_read(4)) break;
+        uint32_t block_size = reader.u32();
         
-        if (current_pointer + block_size > buf.size()) break;
-        std::vector<char> block_buf(buf.begin() + current_pointer, buf.begin() + current_pointer + block_size);
-        ProcessBlockOriginal(block_type, block_buf);
-        current_pointer += block_size;
+        if (!reader.can_read(block_size)) break;
+        blocks.push_back({block_type, reader.bytes(block_size)});
+        if ((block_type == 0x01 || block_type == 0x05) && block_size >= 4 &&
+            IsOutlineLayer(static_cast<int>(ByteReader::LoadU32(blocks.back().data.data())))) {
+            outline_blocks.push_back(blocks.back());
+        }
     }
-    
-    FindXYTranslation();
-    TranslateSegments();
-    TranslatePartOutlineSegments();
-    TranslatePins();
-    TranslateCircles();
-    TranslateRectangles();
-    TranslateOvals();
 
+    // The board outline fixes the translation, so every block below can store
+    // its geometry in final coordinates as it is parsed
+    FindXYTranslation(outline_blocks);
+
+    // Phase 2: decrypt and parse part blocks concurrently into per-block results
+    std::vector<size_t> part_blocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].type == 0x07) part_blocks.push_back(i);
+    }
+    std::vector<PartBlockResult> part_results(part_blocks.size());
+    Utils::ParallelFor(part_blocks.size(), [&](size_t n) {
+        ParsePartBlockOriginal(blocks[part_blocks[n]].data, part_results[n]);
+    }, 64);
+
+    // Phase 3: merge in file order so part numbering matches a serial parse.
+    // What the workers noticed is reported here, on this thread
+    size_t next_part_result = 0;
+    size_t part_aliases = 0, net_aliases = 0, json_diodes = 0;
+    for (const BlockRef& block : blocks) {
+        if (block.type == 0x07) {
+            PartBlockResult& result = part_results[next_part_result++];
+            part_aliases += result.part_aliases;
+            net_aliases += result.net_aliases;
+            json_diodes += result.json_diodes;
+            for (const auto& unknown : result.unknown_sub_blocks) {
+                printf("Unknown sub block type: 0x%02X at %zu in %s\n", unknown.first, unknown.second, result.part_name.c_str());
+            }
+            MergePartBlock(result);
+            continue;
+        }
+        ProcessBlockOriginal(block.type, block.data);
+    }
+    if (part_aliases || net_aliases || json_diodes) {
+        std::cout << "Applied " << part_aliases << " part aliases, " << net_aliases << " net aliases and "
+                  << json_diodes << " JSON diode readings" << std::endl;
+    }
+    
     // Update counts
     num_parts = parts.size();
     num_pins = pins.size();
       std::cout << "XZZPCB parsing completed:" << std::endl;
     std::cout << "  Parts: " << num_parts << std::endl;
     std::cout << "  Pins: " << num_pins << std::endl;
-    std::cout << "  Outline segments: " << outline_segments.size() << std::endl;
+    std::cout << "  Outline segments: " << outline_segments.size() << " (+" << outline_arcs.size() << " arcs)" << std::endl;
     std::cout << "  Part outline segments: " << part_outline_segments.size() << std::endl;
     std::cout << "  Circles: " << circles.size() << std::endl;
     std::cout << "  Rectangles: " << rectangles.size() << std::endl;
     std::cout << "  Ovals: " << ovals.size() << std::endl;
+    std::cout << "  Trace segments: " << TraceSegmentCount() << " on " << trace_layers.size() << " layers" << std::endl;
     std::cout << "  Part aliases found: " << part_alias_dict.size() << std::endl;
     std::cout << "  JSON diode readings found: " << json_diode_dict.size() << std::endl;
     
@@ -208,7 +278,7 @@ bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
     if (!pins.empty()) {
         std::cout << "First few pin coordinates:" << std::endl;
         for (size_t i = 0; i < std::min((size_t)5, pins.size()); i++) {
-            std::cout << "  Pin " << i << ": (" << pins[i].pos.x << ", " << pins[i].pos.y << ") " << pins[i].name;
+            std::cout << "  Pin " << i << ": (" << pins[i].pos.x << ", " << pins[i].pos.y << ") " << PinName(pins[i]);
             if (!pins[i].comment.empty()) {
                 std::cout << " [diode: " << pins[i].comment << "]";
             }
@@ -244,6 +314,8 @@ bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
         }
     }
 
+    BuildIndices();
+
     // Set valid flag to indicate successful parsing
     valid = true;
     std::cout << "XZZPCB file parsed successfully - setting valid flag to true" << std::endl;
@@ -251,11 +323,10 @@ bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
     return true;
 }
 
-void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& block_buf) {
+void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, ByteView block) {
     switch (block_type) {
         case 0x01: { // ARC
-            std::vector<uint32_t> arc_data((uint32_t*)(block_buf.data()), (uint32_t*)(block_buf.data() + block_buf.size()));
-            ParseArcBlockOriginal(arc_data);
+            ParseArcBlockOriginal(block);
             break;
         }
         case 0x02: { // VIA
@@ -263,9 +334,7 @@ void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& blo
             break;
         }
         case 0x05: { // LINE SEGMENT
-            std::vector<uint32_t> line_segment_data((uint32_t*)(block_buf.data()),
-                                                   (uint32_t*)(block_buf.data() + block_buf.size()));
-            ParseLineSegmentBlockOriginal(line_segment_data);
+            ParseLineSegmentBlockOriginal(block);
             break;
         }
         case 0x06: { // TEXT
@@ -273,13 +342,11 @@ void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& blo
             break;
         }
         case 0x07: { // PART/PIN
-            std::vector<char> part_data(block_buf.begin(), block_buf.end());
-            ParsePartBlockOriginal(part_data);
+            ParsePartBlockOriginal(block);
             break;
         }
         case 0x09: { // TEST PADS/DRILL HOLES
-            std::vector<uint8_t> test_pad_data((uint8_t*)(block_buf.data()), (uint8_t*)(block_buf.data() + block_buf.size()));
-            ParseTestPadBlockOriginal(test_pad_data);
+            ParseTestPadBlockOriginal(block);
             break;
         }
         default:
@@ -287,183 +354,224 @@ void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& blo
     }
 }
 
-void XZZPCBFile::des_decrypt(std::vector<char>& buf) {
-    std::vector<uint16_t> byteList = {0xE0, 0xCF, 0x2E, 0x9F, 0x3C, 0x33, 0x3C, 0x33};
-
-    std::ostringstream a;
-    for (size_t i = 0; i < byteList.size(); i += 2) {
-        uint16_t value = (byteList[i] << 8) | byteList[i + 1];
-        value ^= 0x3C33; // <3
-        a << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << value;
-    }
-    std::string b = a.str();
-    char* c = new char[b.length() + 1];
-    std::copy(b.begin(), b.end(), c);
-    c[b.length()] = '\0';
-
-    std::vector<uint8_t> buf_uint8(buf.begin(), buf.end());
-    uint8_t* p = buf_uint8.data();
-    uint8_t* ep = p + buf_uint8.size();
-
-    uint64_t k = 0x0000000000000000;
-    const char* kp = c;
-    for (int i = 0; i < 8; i++) {
-        uint64_t v = hexconv[(int)*kp] * 16 + hexconv[(int)*(kp + 1)];
-        k |= (v << ((7 - i) * 8));
-        kp += 2;
-    }
-
-    std::vector<uint8_t> decrypted_buf;
-    while (p < ep) {
-        unsigned char e[8];
-        unsigned char d[8];
-        uint64_t d64;
-        uint64_t e64;
-
-        // Build encrypted block
-        for (int i = 0; i < 8; i++) {
-            e[7 - i] = *p;
-            p++;
+// Key schedule for the fixed XZZ part-block key, expanded once and shared by every block
+static const des_ctx& xzz_des_ctx() {
+    static const des_ctx ctx = [] {
+        init_hexconv();
+        std::vector<uint16_t> byteList = {0xE0, 0xCF, 0x2E, 0x9F, 0x3C, 0x33, 0x3C, 0x33};
+
+        std::ostringstream a;
+        for (size_t i = 0; i < byteList.size(); i += 2) {
+            uint16_t value = (byteList[i] << 8) | byteList[i + 1];
+            value ^= 0x3C33; // <3
+            a << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << value;
         }
-        memcpy(&e64, e, 8);
-
-        // Decode/decrypt
-        d64 = des(e64, k, 'd');
+        std::string b = a.str();
 
-        // Reverse d64 and append to decrypted_buf
+        uint64_t k = 0x0000000000000000;
+        const char* kp = b.c_str();
         for (int i = 0; i < 8; i++) {
-            d[i] = (d64 >> (i * 8)) & 0xff; // Extract each byte
+            uint64_t v = hexconv[(int)*kp] * 16 + hexconv[(int)*(kp + 1)];
+            k |= (v << ((7 - i) * 8));
+            kp += 2;
         }
-        for (int i = 7; i >= 0; i--) {
-            decrypted_buf.push_back(d[i]); // Append in reverse order
-        }
-    }
-    buf = std::vector<char>(decrypted_buf.begin(), decrypted_buf.end());
-    delete[] c;
+
+        des_ctx c;
+        des_set_key(&c, k);
+        return c;
+    }();
+    return ctx;
 }
 
-std::vector<std::pair<BRDPoint, BRDPoint>> XZZPCBFile::xzz_arc_to_segments(int startAngle, int endAngle, int r, BRDPoint pc) {
-    const int numPoints = 10;
-    std::vector<std::pair<BRDPoint, BRDPoint>> arc_segments{};
+std::vector<char> XZZPCBFile::des_decrypt(ByteView encrypted) {
+    // Blocks are stored byte-reversed relative to des(); des_decrypt_buffer
+    // reads/writes each block big-endian which undoes that in place.
+    // A trailing partial block (not produced by the format) is left as-is.
+    std::vector<char> buf(encrypted.begin(), encrypted.end());
+    des_decrypt_buffer(&xzz_des_ctx(), reinterpret_cast<unsigned char*>(buf.data()), buf.size());
+    return buf;
+}
 
+BRDArc XZZPCBFile::xzz_arc(float startAngle, float endAngle, float r, BRDPoint pc) {
+    // The file gives two end angles; the arc is the shorter way between them
     if (startAngle > endAngle) {
         std::swap(startAngle, endAngle);
     }
 
-    if (endAngle - startAngle > 180) {
-        startAngle += 360;
+    if (endAngle - startAngle > 180.0f) {
+        startAngle += 360.0f;
     }
 
-    double startAngleD = static_cast<double>(startAngle);
-    double endAngleD = static_cast<double>(endAngle);
-    double rD = static_cast<double>(r);
-    double pc_xD = static_cast<double>(pc.x);
-    double pc_yD = static_cast<double>(pc.y);
-
-    const double degToRad = 3.14159265358979323846 / 180.0;
-    startAngleD *= degToRad;
-    endAngleD *= degToRad;
-
-    double angleStep = (endAngleD - startAngleD) / (numPoints - 1);
-
-    BRDPoint pold = {static_cast<int>(static_cast<float>(pc_xD + rD * std::cos(startAngleD))),
-                     static_cast<int>(static_cast<float>(pc_yD + rD * std::sin(startAngleD)))};
-    for (int i = 1; i < numPoints; ++i) {
-        double angle = startAngleD + i * angleStep;
-        BRDPoint p = {static_cast<int>(pc_xD + rD * std::cos(angle)), static_cast<int>(pc_yD + rD * std::sin(angle))};
-        arc_segments.push_back({pold, p});
-        pold = p;
+    return BRDArc(pc, r, startAngle, endAngle - startAngle);
+}
+
+bool XZZPCBFile::IsCopperLayer(int layer) {
+    // 1 = top .. 16 = bottom; 17 and 28 carry the board outline
+    return layer >= 1 && layer <= 16;
+}
+
+bool XZZPCBFile::IsOutlineLayer(int layer) {
+    return layer == 28 || layer == 17;
+}
+
+uint32_t XZZPCBFile::TraceNetSlot(uint32_t net_index) {
+    auto slot = trace_net_slots.find(net_index);
+    if (slot != trace_net_slots.end()) return slot->second;
+
+    // Same naming as pins: JSON aliases apply to everything but NC
+    auto net_it = net_dict.find(net_index);
+    std::string net = net_it != net_dict.end() ? net_it->second : std::string();
+    if (net != "NC") {
+        auto net_alias_it = net_alias_dict.find(net);
+        if (net_alias_it != net_alias_dict.end()) net = net_alias_it->second;
     }
+    uint32_t id = static_cast<uint32_t>(trace_nets.size());
+    trace_nets.push_back(std::move(net));
+    trace_net_slots.emplace(net_index, id);
+    return id;
+}
+
+XZZPCBFile::ArcRecord XZZPCBFile::ReadArcBlock(ByteView block) {
+    ByteReader reader(block);
+    ArcRecord record;
+    record.layer = static_cast<int>(reader.u32());
+    uint32_t x = reader.u32();
+    uint32_t y = reader.u32();
+    int32_t r = reader.i32();
+    int32_t angle_start = reader.i32();
+    int32_t angle_end = reader.i32();
+    int32_t width = reader.i32();
+    record.net = reader.can_read(4) ? reader.u32() : 0;
+    const int32_t scale = 10000;
+
+    BRDPoint centre = {static_cast<int>(x / scale), static_cast<int>(y / scale)};
+    record.arc = xzz_arc(static_cast<float>(angle_start) / scale, static_cast<float>(angle_end) / scale,
+                         static_cast<float>(r) / scale, centre);
+    record.arc.width = width > 0 ? static_cast<float>(width) / scale : 0.0f;
+    return record;
+}
 
-    return arc_segments;
+XZZPCBFile::LineRecord XZZPCBFile::ReadLineBlock(ByteView block) {
+    ByteReader reader(block);
+    LineRecord record;
+    record.layer = reader.i32();
+    int32_t x1 = reader.i32();
+    int32_t y1 = reader.i32();
+    int32_t x2 = reader.i32();
+    int32_t y2 = reader.i32();
+    int32_t width = reader.i32();
+    record.net = reader.can_read(4) ? reader.u32() : 0;
+    const int32_t scale = 10000;
+
+    record.a.x = static_cast<int>(static_cast<double>(x1) / static_cast<double>(scale));
+    record.a.y = static_cast<int>(static_cast<double>(y1) / static_cast<double>(scale));
+    record.b.x = static_cast<int>(static_cast<double>(x2) / static_cast<double>(scale));
+    record.b.y = static_cast<int>(static_cast<double>(y2) / static_cast<double>(scale));
+    record.width = width > 0 ? static_cast<float>(width) / scale : 0.0f;
+    return record;
 }
 
-void XZZPCBFile::ParseArcBlockOriginal(std::vector<uint32_t>& buf) {
-    uint32_t layer = buf[0];
-    uint32_t x = buf[1];
-    uint32_t y = buf[2];
-    int32_t r = buf[3];
-    int32_t angle_start = buf[4];
-    int32_t angle_end = buf[5];
-    int32_t scale = buf[6];
-    // int32_t unknown_arc = buf[7];
-    scale = 10000;
-    if (layer != 28 && layer != 17) {
+void XZZPCBFile::ParseArcBlockOriginal(ByteView block) {
+    ArcRecord record = ReadArcBlock(block);
+    const bool copper = IsCopperLayer(record.layer);
+    if (!IsOutlineLayer(record.layer) && !copper) {
         return;
     }
 
-    int point_x = static_cast<int>(x / scale);
-    int point_y = static_cast<int>(y / scale);
-    r = r / scale;
-    angle_start = angle_start / scale;
-    angle_end = angle_end / scale;
-    BRDPoint centre = {point_x, point_y};
-
-    std::vector<std::pair<BRDPoint, BRDPoint>> segments = xzz_arc_to_segments(angle_start, angle_end, r, centre);
-    std::move(segments.begin(), segments.end(), std::back_inserter(outline_segments));
+    TranslatePoints(record.arc.center);
+    if (copper) {
+        record.arc.net = TraceNetSlot(record.net);
+        GetTraceLayer(record.layer).arcs.push_back(record.arc);
+        return;
+    }
+    record.arc.width = 0.0f;
+    outline_arcs.push_back(record.arc);
 }
 
-void XZZPCBFile::ParseLineSegmentBlockOriginal(std::vector<uint32_t>& buf) {
-    int32_t layer = buf[0];
-    int32_t x1 = buf[1];
-    int32_t y1 = buf[2];
-    int32_t x2 = buf[3];
-    int32_t y2 = buf[4];
-    int32_t scale = buf[5];
-    scale = 10000;
-    // int32_t trace_net_index = buf[6];	/* unused */
-    if (layer != 28 && layer != 17) {
+void XZZPCBFile::ParseLineSegmentBlockOriginal(ByteView block) {
+    LineRecord record = ReadLineBlock(block);
+    const bool copper = IsCopperLayer(record.layer);
+    if (!IsOutlineLayer(record.layer) && !copper) {
         return;
     }
 
-    BRDPoint point;
-    point.x = static_cast<int>(static_cast<double>(x1) / static_cast<double>(scale));
-    point.y = static_cast<int>(static_cast<double>(y1) / static_cast<double>(scale));
-    BRDPoint point2;
-    point2.x = static_cast<int>(static_cast<double>(x2) / static_cast<double>(scale));
-    point2.y = static_cast<int>(static_cast<double>(y2) / static_cast<double>(scale));
-    outline_segments.push_back({point, point2});
+    TranslatePoints(record.a);
+    TranslatePoints(record.b);
+    if (copper) {
+        GetTraceLayer(record.layer).segments.emplace_back(record.a, record.b, record.width, TraceNetSlot(record.net));
+        return;
+    }
+    outline_segments.push_back({record.a, record.b});
 }
 
-void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
-    BRDPart blank_part;
+void XZZPCBFile::ParsePartBlockOriginal(ByteView block) {
+    PartBlockResult result;
+    ParsePartBlockOriginal(block, result);
+    MergePartBlock(result);
+}
+
+// Appends one part block's output. pin.part and end_of_pins depend on how many
+// parts/pins precede the block, so they are only known at merge time.
+void XZZPCBFile::MergePartBlock(PartBlockResult& result) {
+    const int part_number = static_cast<int>(parts.size()) + 1;
+    for (size_t i = 0; i < result.pins.size(); ++i) {
+        BRDPin& pin = result.pins[i];
+        pin.part = part_number;
+        SetPinNet(pin, result.pin_strings[i].net);
+        SetPinName(pin, result.pin_strings[i].name);
+        pin.snum_id = pin.name_id;
+        pins.push_back(std::move(pin));
+    }
+    part_outline_segments.insert(part_outline_segments.end(), result.outline_segments.begin(), result.outline_segments.end());
+    circles.insert(circles.end(), result.circles.begin(), result.circles.end());
+    rectangles.insert(rectangles.end(), result.rectangles.begin(), result.rectangles.end());
+    ovals.insert(ovals.end(), result.ovals.begin(), result.ovals.end());
+
+    if (result.has_part) {
+        result.part.end_of_pins = pins.size();
+        parts.push_back(std::move(result.part));
+    }
+}
+
+// Decrypts and parses a part block into result without touching shared state,
+// so independent blocks can be handled concurrently. Only reads the lookup
+// dictionaries filled before the block loop (nets, aliases, diode readings).
+void XZZPCBFile::ParsePartBlockOriginal(ByteView block, PartBlockResult& result) const {
     BRDPin blank_pin;
     BRDPart part;
     BRDPin pin;
 
-    des_decrypt(buf);
+    const std::vector<char> buf = des_decrypt(block);
+    ByteReader reader(buf);
 
-    uint32_t current_pointer = 0;
     if (buf.size() < 4) return;
-    uint32_t part_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += 18;
+    uint32_t part_size = reader.u32();
+    reader.skip(18);
     
-    if (current_pointer + 4 > buf.size()) return;
-    uint32_t part_group_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += part_group_name_size;
+    if (!reader.can_read(4)) return;
+    uint32_t part_group_name_size = reader.u32();
+    reader.skip(part_group_name_size);
 
     // So far 0x06 sub blocks have been first always
     // Also contains part name so needed before pins
-    if (current_pointer >= buf.size() || buf[current_pointer] != 0x06) {
+    if (reader.pos() >= buf.size() || buf[reader.pos()] != 0x06) {
         return;
     }
 
-    current_pointer += 31;
-    if (current_pointer + 4 > buf.size()) return;
-    uint32_t part_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    if (current_pointer + part_name_size > buf.size()) return;
-    std::string part_name(reinterpret_cast<char*>(&buf[current_pointer]), part_name_size);
-    current_pointer += part_name_size;
+    reader.skip(31);
+    if (!reader.can_read(4)) return;
+    uint32_t part_name_size = reader.u32();
+    if (!reader.can_read(part_name_size)) return;
+    std::string part_name = reader.string(part_name_size);
 
     part.name = part_name;
+    result.part_name = part_name;
     
     // Check if we have an alias for this part from the JSON data
-    if (part_alias_dict.find(part_name) != part_alias_dict.end()) {
-        std::string alias = part_alias_dict[part_name];
-        std::cout << "Using alias for part " << part_name << " -> " << alias << std::endl;
+    auto alias_it = part_alias_dict.find(part_name);
+    if (alias_it != part_alias_dict.end()) {
+        const std::string& alias = alias_it->second;
+        result.part_aliases++;
         part.name = alias;
     }
     
@@ -471,33 +579,31 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
     part.part_type = BRDPartType::SMD;
 
     // uint32_t pin_count = 0; /* currently unused */
-    while (current_pointer <= part_size && current_pointer < buf.size()) {
-        uint8_t sub_type_identifier = buf[current_pointer];
-        current_pointer += 1;
+    while (reader.pos() <= part_size && reader.pos() < buf.size()) {
+        uint8_t sub_type_identifier = reader.u8();
 
         switch (sub_type_identifier) {
             case 0x01: {
                 // Currently unsure what this is
-                if (current_pointer + 4 > buf.size()) return;
-                current_pointer += *reinterpret_cast<uint32_t*>(&buf[current_pointer]) + 4; // Skip the block
+                if (!reader.can_read(4)) return;
+                reader.skip(reader.u32()); // Skip the block
                 break;
             }
             case 0x05: { // Line Segment - Part outline
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t line_block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer += 4;
+                if (!reader.can_read(4)) return;
+                uint32_t line_block_size = reader.u32();
                 
                 // Process line segment data (expected format: similar to main line segments)
-                if (line_block_size >= 24 && current_pointer + line_block_size <= buf.size()) { // 6 uint32_t values = 24 bytes minimum
-                    uint32_t* line_data = reinterpret_cast<uint32_t*>(&buf[current_pointer]);
+                if (line_block_size >= 24 && reader.can_read(line_block_size)) { // 6 uint32_t values = 24 bytes minimum
+                    ByteReader line_data(ByteView(buf).subview(reader.pos(), line_block_size));
                     
                     // Extract line segment data (assuming similar format to ParseLineSegmentBlockOriginal)
-                    // int32_t layer = line_data[0];  // Layer - may not be relevant for part outlines
-                    int32_t x1 = line_data[1];
-                    int32_t y1 = line_data[2]; 
-                    int32_t x2 = line_data[3];
-                    int32_t y2 = line_data[4];
-                    int32_t scale = line_data[5];
+                    line_data.skip(4); // Layer - may not be relevant for part outlines
+                    int32_t x1 = line_data.i32();
+                    int32_t y1 = line_data.i32(); 
+                    int32_t x2 = line_data.i32();
+                    int32_t y2 = line_data.i32();
+                    int32_t scale = line_data.i32();
                     
                     // Use consistent scaling
                     scale = 10000;
@@ -509,21 +615,23 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                     BRDPoint point2;
                     point2.x = static_cast<int>(static_cast<double>(x2) / static_cast<double>(scale));
                     point2.y = static_cast<int>(static_cast<double>(y2) / static_cast<double>(scale));
+                    TranslatePoints(point1);
+                    TranslatePoints(point2);
                     
                     // Add to part outline segments for rendering (these are part outlines, not board outlines)
-                    part_outline_segments.push_back({point1, point2});
+                    result.outline_segments.push_back({point1, point2});
                     
                     //std::cout << "DEBUG: Added part outline segment from (" << point1.x << ", " << point1.y 
                              //<< ") to (" << point2.x << ", " << point2.y << ") for part: " << part_name << std::endl;
                 }
                 
-                current_pointer += line_block_size;
+                reader.skip(line_block_size);
                 break;
             }
             case 0x06: { // Labels/Part Names
                 // Not currently relevant for BRDPin
-                if (current_pointer + 4 > buf.size()) return;
-                current_pointer += *reinterpret_cast<uint32_t*>(&buf[current_pointer]) + 4; // Skip the block
+                if (!reader.can_read(4)) return;
+                reader.skip(reader.u32()); // Skip the block
                 break;
             }
             case 0x09: { // Pins
@@ -531,50 +639,40 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                 pin.side = BRDPinSide::Top;
 
                 // Block size
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t pin_block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                uint32_t pin_block_end = current_pointer + pin_block_size + 4;
-                current_pointer += 4;
-                current_pointer += 4; // currently unknown
-
-                if (current_pointer + 16 > buf.size()) return;
-                pin.pos.x = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-                current_pointer += 4;
-                pin.pos.y = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-                current_pointer += 4;
+                if (!reader.can_read(4)) return;
+                uint32_t pin_block_size = reader.u32();
+                size_t pin_block_end = reader.pos() + pin_block_size;
+                reader.skip(4); // currently unknown
+
+                if (!reader.can_read(16)) return;
+                pin.pos.x = reader.u32() / 10000;
+                pin.pos.y = reader.u32() / 10000;
+                TranslatePoints(pin.pos); // pad shapes below are placed at pin.pos
                 
-                current_pointer += 4; // currently unknown
-                uint32_t pin_rotation = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000; // Rotation in degrees
+                reader.skip(4); // currently unknown
+                uint32_t pin_rotation = reader.u32() / 10000; // Rotation in degrees
                 //pin_rotation = pin_rotation + 90; // Adjust to match BRD coordinate system (0 degrees is right, 90 degrees is up)
-                current_pointer += 4;
-
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t pin_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer += 4;
-                if (current_pointer + pin_name_size > buf.size()) return;
-                std::string pin_name(reinterpret_cast<char*>(&buf[current_pointer]), pin_name_size);
-                pin.name = pin_name;
-                pin.snum = pin_name;
+
+                if (!reader.can_read(4)) return;
+                uint32_t pin_name_size = reader.u32();
+                if (!reader.can_read(pin_name_size)) return;
+                std::string pin_name = reader.string(pin_name_size);
                 
                 // Debug: Log pin data loading
-                //std::cout << "DEBUG: Loaded pin - name: '" << pin_name << "', setting snum to: '" << pin.snum << "'" << std::endl;
+                //std::cout << "DEBUG: Loaded pin - name: '" << pin_name << "'" << std::endl;
                 //std::cout << "Pin rotation: '" << pin_rotation << "'" << std::endl;
 
 
-                current_pointer += pin_name_size;
-                uint32_t height_radius_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); // Height for rectangular pins, radius for circular pins
-                current_pointer += 4;
-                uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); // Width for rectangular pins
-                current_pointer += 22;
-                uint8_t pin_shape = *reinterpret_cast<uint8_t*>(&buf[current_pointer]); // Shape for pins
+                uint32_t height_radius_raw = reader.u32(); // Height for rectangular pins, radius for circular pins
+                uint32_t width_raw = reader.u32(); // Width for rectangular pins
+                reader.skip(18);
+                uint8_t pin_shape = reader.can_read(1) ? static_cast<uint8_t>(buf[reader.pos()]) : 0; // Shape for pins
 
 
 
                 
                 // Extract shape data based on pin_rotation
-                if (current_pointer + 4 <= buf.size()) {
-                    //uint32_t height_radius_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                    //current_pointer += 4;
+                if (reader.can_read(4)) {
                     
                     if (pin_shape == 1) {
                         // Check if it's circular (height == width) or oval (height != width)
@@ -585,7 +683,7 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                             
                             // Create circle with red fill color at pin position
                             BRDCircle circle(pin.pos, radius, 0.7f, 0.0f, 0.0f, 1.0f); // Red color (R=1.0, G=0.0, B=0.0, A=1.0)
-                            circles.push_back(circle);
+                            result.circles.push_back(circle);
                             
                             //std::cout << "DEBUG: Added circle for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
                                      //<< ") with diameter " << diameter << " (radius " << radius << ")" << std::endl;
@@ -602,7 +700,7 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                             
                             // Create oval with red fill color at pin position
                             BRDOval oval(pin.pos, width, height, static_cast<float>(pin_rotation), 0.7f, 0.0f, 0.0f, 1.0f); // Red color
-                            ovals.push_back(oval);
+                            result.ovals.push_back(oval);
                             
                             //std::cout << "DEBUG: Added oval for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
                                      //<< ") with width " << width << ", height " << height << std::endl;
@@ -618,13 +716,12 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                         float height = static_cast<float>(height_radius_raw) / 10000.0f; // Apply same scaling as coordinates
                         
                         // Get width (next 4 bytes)
-                        if (current_pointer + 4 <= buf.size()) {
-                            //uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
+                        if (reader.can_read(4)) {
                             float width = static_cast<float>(width_raw) / 10000.0f;
                             
                             // Create rectangle with red fill color at pin position
                             BRDRectangle rectangle(pin.pos, width, height, static_cast<float>(pin_rotation), 0.7f, 0.0f, 0.0f, 1.0f); // Red color
-                            rectangles.push_back(rectangle);
+                            result.rectangles.push_back(rectangle);
                             
                             //std::cout << "DEBUG: Added rectangle for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
                                      //<< ") with width " << width << ", height " << height << ", rotation " << pin_rotation << "°" << "shape: " << pin_shape <<std::endl;
@@ -632,100 +729,90 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
                     }
                 }
                 
-                current_pointer += 6;
+                reader.skip(6);
 
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer = pin_block_end;
+                if (!reader.can_read(4)) return;
+                uint32_t net_index = reader.u32();
+                reader.seek(pin_block_end);
 
                 std::string diode_reading;
-                std::string pin_net = net_dict[net_index];
+                auto net_it = net_dict.find(net_index);
+                std::string pin_net = net_it != net_dict.end() ? net_it->second : std::string();
 
-                if (pin_net == "NC") {
-                    pin.net = "NC";
-                } else {
+                if (pin_net != "NC") {
                     // Check if we have an alias for this net from the JSON data
-                    if (net_alias_dict.find(pin_net) != net_alias_dict.end()) {
-                        std::string net_alias = net_alias_dict[pin_net];
-                        std::cout << "Using alias for net " << pin_net << " -> " << net_alias << std::endl;
-                        pin.net = net_alias;
-                    } else {
-                        pin.net = pin_net;
+                    auto net_alias_it = net_alias_dict.find(pin_net);
+                    if (net_alias_it != net_alias_dict.end()) {
+                        result.net_aliases++;
+                        pin_net = net_alias_it->second;
                     }
-                }                pin.part = parts.size() + 1;
+                }
+
 
                 if (!diode_reading.empty()) {
                     pin.comment = diode_reading;
-                } else if (json_diode_dict.find(part_name) != json_diode_dict.end() &&
-                          json_diode_dict[part_name].find(pin.name) != json_diode_dict[part_name].end()) {
+                } else if (json_diode_dict.count(part_name) &&
+                          json_diode_dict.at(part_name).count(pin_name)) {
                     // Use JSON diode reading (prioritize this over other methods)
-                    pin.comment = json_diode_dict[part_name][pin.name];
-                    std::cout << "Using JSON diode reading for " << part_name << " pin " << pin.name << ": " << pin.comment << std::endl;
+                    pin.comment = json_diode_dict.at(part_name).at(pin_name);
+                    result.json_diodes++;
                 } else if (diode_readings_type == 1) {
-                    if (diode_dict.find(part.name) != diode_dict.end() &&
-                        diode_dict[part.name].find(pin.name) != diode_dict[part.name].end()) {
-                        pin.comment = diode_dict[part.name][pin.name];
+                    if (diode_dict.count(part.name) &&
+                        diode_dict.at(part.name).count(pin_name)) {
+                        pin.comment = diode_dict.at(part.name).at(pin_name);
                     }
                 } else if (diode_readings_type == 2) {
-                    if (diode_dict.find(pin.net) != diode_dict.end()) {
-                        pin.comment = diode_dict[pin.net]["0"];
+                    if (diode_dict.count(pin_net) && diode_dict.at(pin_net).count("0")) {
+                        pin.comment = diode_dict.at(pin_net).at("0");
                     }
                 }
 
-                pins.push_back(pin);
+                result.pins.push_back(pin);
+                result.pin_strings.push_back({std::move(pin_net), std::move(pin_name)});
                 pin = blank_pin;
                 break;
             }
             default:
                 if (sub_type_identifier != 0x00) {
-                    printf("Unknown sub block type: 0x%02X at %d in %s\n", sub_type_identifier, current_pointer, part_name.c_str());
+                    result.unknown_sub_blocks.emplace_back(sub_type_identifier, reader.pos());
                 }
                 break;
         }
     }
 
-    part.end_of_pins = pins.size();
-    parts.push_back(part);
-    part = blank_part;
+    result.part = part;
+    result.has_part = true;
 }
 
-void XZZPCBFile::ParseTestPadBlockOriginal(std::vector<uint8_t>& buf) {
+void XZZPCBFile::ParseTestPadBlockOriginal(ByteView buf) {
     BRDPart blank_part;
     BRDPin blank_pin;
     BRDPart part;
     BRDPin pin;
 
-    uint32_t current_pointer = 0;
+    ByteReader reader(buf);
     if (buf.size() < 20) return;
-    // uint32_t pad_number = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); /* unused */
-    current_pointer += 4;
-    uint32_t x_origin = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint32_t y_origin = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += 4; // inner_diameter
-
-    uint32_t pin_rotation = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-
-    current_pointer += 4; // rotation
-    uint32_t name_length = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    if (current_pointer + name_length > buf.size()) return;
-    std::string name(reinterpret_cast<char*>(&buf[current_pointer]), name_length);
-    current_pointer += name_length;
-    if (current_pointer + 8 > buf.size()) return;
-    uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint32_t height_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint8_t pin_shape = *reinterpret_cast<uint8_t*>(&buf[current_pointer]);
+    reader.skip(4); // pad_number, unused
+    uint32_t x_origin = reader.u32();
+    uint32_t y_origin = reader.u32();
+    reader.skip(4); // inner_diameter
+
+    uint32_t pin_rotation = reader.u32() / 10000;
+
+    uint32_t name_length = reader.u32();
+    if (!reader.can_read(name_length)) return;
+    std::string name = reader.string(name_length);
+    if (!reader.can_read(8)) return;
+    uint32_t width_raw = reader.u32();
+    uint32_t height_raw = reader.u32();
+    uint8_t pin_shape = reader.can_read(1) ? static_cast<uint8_t>(buf[reader.pos()]) : 0;
 
     // Optionally, store or use width_raw and height_raw for rendering test pad shapes
-    current_pointer = buf.size() - 12;
+    size_t current_pointer = buf.size() - 12;
     std::cout << "Buffer Size '" << buf.size() << "'" << std::endl;
     std::cout << "Current Pointer After '" << current_pointer << "'" << std::endl;
     if (current_pointer >= buf.size()) return;
-    uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
+    uint32_t net_index = reader.peek_u32(current_pointer);
     std::cout << "Net index '" << net_index << "'" << std::endl;
 
     // Create test pad shapes based on width and height
@@ -737,6 +824,7 @@ void XZZPCBFile::ParseTestPadBlockOriginal(std::vector<uint8_t>& buf) {
     BRDPoint test_pad_pos;
     test_pad_pos.x = static_cast<int>(static_cast<double>(x_origin / 10000.0));
     test_pad_pos.y = static_cast<int>(static_cast<double>(y_origin / 10000.0));
+    TranslatePoints(test_pad_pos);
     
     if (pin_shape == 1) {
         // Create circle for test pad when width equals height
@@ -759,24 +847,23 @@ void XZZPCBFile::ParseTestPadBlockOriginal(std::vector<uint8_t>& buf) {
     part.mounting_side = BRDPartMountingSide::Top;
     part.part_type = BRDPartType::SMD;
 
-    pin.snum = name;
+    SetPinSnum(pin, name);
     
     // Debug: Log pin data loading for test pad
-    //std::cout << "DEBUG: Loaded test pad pin - name: '" << name << "', setting snum to: '" << pin.snum << "'" << std::endl;
+    //std::cout << "DEBUG: Loaded test pad pin - name: '" << name << "'" << std::endl;
 
     pin.side = BRDPinSide::Top;
-    pin.pos.x = static_cast<int>(static_cast<double>(x_origin / 10000.0));
-    pin.pos.y = static_cast<int>(static_cast<double>(y_origin / 10000.0));
+    pin.pos = test_pad_pos;
     if (net_dict.find(net_index) != net_dict.end()) {
         if (net_dict[net_index] == "UNCONNECTED" || net_dict[net_index] == "NC") {
-            pin.net = ""; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed
-                          // to kPinTypeNotConnected
+            pin.net_id = kEmptyStringId; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed
+                                         // to kPinTypeNotConnected
         } else {
-            pin.net = net_dict[net_index];
+            SetPinNet(pin, net_dict[net_index]);
         }
     } else {
-        pin.net = ""; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed to
-                      // kPinTypeNotConnected
+        pin.net_id = kEmptyStringId; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed to
+                                     // kPinTypeNotConnected
     }
     pin.part = parts.size() + 1;
     pins.push_back(pin);
@@ -786,17 +873,14 @@ void XZZPCBFile::ParseTestPadBlockOriginal(std::vector<uint8_t>& buf) {
     part = blank_part;
 }
 
-void XZZPCBFile::ParseNetBlockOriginal(std::vector<char>& buf) {
-    uint32_t current_pointer = 0;
-    while (current_pointer < buf.size()) {
-        if (current_pointer + 8 > buf.size()) break;
-        uint32_t net_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
-        uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
-        if (current_pointer + net_size - 8 > buf.size()) break;
-        std::string net_name(&buf[current_pointer], net_size - 8);
-        current_pointer += net_size - 8;
+void XZZPCBFile::ParseNetBlockOriginal(ByteView buf) {
+    ByteReader reader(buf);
+    while (reader.pos() < buf.size()) {
+        if (!reader.can_read(8)) break;
+        uint32_t net_size = reader.u32();
+        uint32_t net_index = reader.u32();
+        if (net_size < 8 || !reader.can_read(net_size - 8)) break;
+        std::string net_name = reader.string(net_size - 8);
 
         net_dict[net_index] = net_name;
     }
@@ -830,46 +914,43 @@ std::string XZZPCBFile::read_cb2312_string(const std::string& str) {
 }
 
 // atm some diode readings aren't processed properly
-void XZZPCBFile::ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<char>& buf) {
-    unsigned int current_pointer = v6_pos - buf.begin() + 11;
+void XZZPCBFile::ParsePostV6(const Markers& markers, ByteView buf) {
+    size_t current_pointer = markers.post_v6 + sizeof(kPostV6Marker);
     
     // First, look for JSON data after the specific hex pattern: 3D 3D 3D 50 43 42 B8 BD BC D3 0A
-    std::vector<uint8_t> json_pattern = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
-    auto json_pattern_found = std::search(buf.begin(), buf.end(), json_pattern.begin(), json_pattern.end());
-    
-    if (json_pattern_found != buf.end()) {
-        std::cout << "Found JSON pattern at position: " << (json_pattern_found - buf.begin()) << std::endl;
-        ParseJsonData(json_pattern_found + json_pattern.size(), buf);
+    if (markers.json != ByteView::npos) {
+        std::cout << "Found JSON pattern at position: " << markers.json << std::endl;
+        ParseJsonData(markers.json + sizeof(kJsonMarker), buf);
     } else {
         std::cout << "JSON pattern not found in buffer" << std::endl;
         
         // Try to search for JSON-like data by looking for key strings
-        std::string buffer_str(buf.begin(), buf.end());
-        size_t part_pos = buffer_str.find("\"part\":[");
-        size_t reference_pos = buffer_str.find("\"reference\":");
-        size_t alias_pos = buffer_str.find("\"alias\":");
-        
-        if (part_pos != std::string::npos) {
-            std::cout << "Found 'part' array at position: " << part_pos << std::endl;
-            DumpHexAroundPosition(buf, part_pos, 30);
+        if (markers.part_array != ByteView::npos) {
+            std::cout << "Found 'part' array at position: " << markers.part_array << std::endl;
+            DumpHexAroundPosition(buf, markers.part_array, 30);
             // Find the start of the JSON object by looking backwards for '{'
-            size_t json_start = buffer_str.rfind('{', part_pos);
-            if (json_start != std::string::npos) {
+            size_t json_start = buf.rfind('{', markers.part_array);
+            if (json_start != ByteView::npos) {
                 std::cout << "Found JSON start at position: " << json_start << std::endl;
                 DumpHexAroundPosition(buf, json_start, 30);
-                ParseJsonData(buf.begin() + json_start, buf);
-            }
-        } else if (reference_pos != std::string::npos || alias_pos != std::string::npos) {
-            std::cout << "Found JSON-like strings but no 'part' array" << std::endl;
-            std::cout << "reference at: " << reference_pos << ", alias at: " << alias_pos << std::endl;
-            if (reference_pos != std::string::npos) {
-                DumpHexAroundPosition(buf, reference_pos, 30);
-            }
-            if (alias_pos != std::string::npos) {
-                DumpHexAroundPosition(buf, alias_pos, 30);
+                ParseJsonData(json_start, buf);
             }
         } else {
-            std::cout << "No JSON-like data found in buffer" << std::endl;
+            // Diagnostics only; these extra searches run just for files without either marker
+            size_t reference_pos = buf.find("\"reference\":");
+            size_t alias_pos = buf.find("\"alias\":");
+            if (reference_pos != ByteView::npos || alias_pos != ByteView::npos) {
+                std::cout << "Found JSON-like strings but no 'part' array" << std::endl;
+                std::cout << "reference at: " << reference_pos << ", alias at: " << alias_pos << std::endl;
+                if (reference_pos != ByteView::npos) {
+                    DumpHexAroundPosition(buf, reference_pos, 30);
+                }
+                if (alias_pos != ByteView::npos) {
+                    DumpHexAroundPosition(buf, alias_pos, 30);
+                }
+            } else {
+                std::cout << "No JSON-like data found in buffer" << std::endl;
+            }
         }
     }
     
@@ -973,263 +1054,124 @@ void XZZPCBFile::ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<cha
     }
 }
 
-void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vector<char>& buf) {
-    // Convert to string for easier parsing
-    std::string json_str(json_start, buf.end());
-    
-    // Debug: Print first 200 characters after the pattern
-    std::cout << "First 200 chars after pattern: ";
-    for (size_t i = 0; i < std::min((size_t)200, json_str.length()); i++) {
-        char c = json_str[i];
-        if (c >= 32 && c <= 126) {  // Printable ASCII
-            std::cout << c;
-        } else {
-            std::cout << "[0x" << std::hex << (unsigned char)c << std::dec << "]";
-        }
-    }
-    std::cout << std::endl;
-    
-    // Find the start of the JSON object (first '{')
-    size_t json_begin = json_str.find('{');
-    if (json_begin == std::string::npos) {
+void XZZPCBFile::ParseJsonData(size_t json_start, ByteView buf) {
+    // The object starts at the first '{' after the marker
+    size_t json_begin = buf.find("{", json_start);
+    if (json_begin == ByteView::npos) {
         std::cout << "No JSON object found after pattern" << std::endl;
         return;
     }
-    
-    std::cout << "JSON starts at offset " << json_begin << " after pattern" << std::endl;
-    
-    // Find the end of the JSON object by counting braces
-    size_t json_end = json_begin;
-    int brace_count = 0;
-    for (size_t i = json_begin; i < json_str.length(); i++) {
-        if (json_str[i] == '{') {
-            brace_count++;
-        } else if (json_str[i] == '}') {
-            brace_count--;
-            if (brace_count == 0) {
-                json_end = i;
-                break;
-            }
-        }
-    }
-    
-    if (brace_count != 0) {
-        std::cout << "Incomplete JSON object found" << std::endl;
-        return;
-    }
-    
-    // Extract the JSON substring
-    std::string json_data = json_str.substr(json_begin, json_end - json_begin + 1);
-    std::cout << "Found JSON data: " << json_data.substr(0, 100) << "..." << std::endl;
-    
-    // Simple JSON parsing for the specific structure
-    // Looking for: {"part":[{"reference":"N752","alias":"J11100","pad":[...]},...], "net":[{"name":"Net665","alias":"PP_VDD_BOOST"},...]}
-    
-    size_t part_array_start = json_data.find("\"part\":[");
-    if (part_array_start == std::string::npos) {
-        std::cout << "No 'part' array found in JSON" << std::endl;
-        return;
+
+    if (!ParseJsonTables(buf.subview(json_begin), part_alias_dict, net_alias_dict, json_diode_dict)) {
+        std::cout << "Malformed or incomplete JSON object at offset " << json_begin << "; kept the entries before the error" << std::endl;
     }
-    
-    // Start parsing from the opening bracket of the part array
-    size_t pos = part_array_start + 8; // Skip "\"part\":["
-    
-    while (pos < json_data.length()) {
-        // Find next part object
-        size_t part_start = json_data.find("{", pos);
-        if (part_start == std::string::npos) break;
-        
-        // Find the end of this part object
-        size_t part_end = part_start;
-        int part_brace_count = 0;
-        for (size_t i = part_start; i < json_data.length(); i++) {
-            if (json_data[i] == '{') {
-                part_brace_count++;
-            } else if (json_data[i] == '}') {
-                part_brace_count--;
-                if (part_brace_count == 0) {
-                    part_end = i;
-                    break;
-                }
-            }
-        }
-        
-        if (part_brace_count != 0) break;
-        
-        // Extract part object
-        std::string part_obj = json_data.substr(part_start, part_end - part_start + 1);
-        
-        // Parse reference and alias
-        std::string reference, alias;
-        
-        // Extract reference
-        size_t ref_start = part_obj.find("\"reference\":\"");
-        if (ref_start != std::string::npos) {
-            ref_start += 13; // Skip "\"reference\":\""
-            size_t ref_end = part_obj.find("\"", ref_start);
-            if (ref_end != std::string::npos) {
-                reference = part_obj.substr(ref_start, ref_end - ref_start);
-            }
-        }
-        
-        // Extract alias
-        size_t alias_start = part_obj.find("\"alias\":\"");
-        if (alias_start != std::string::npos) {
-            alias_start += 9; // Skip "\"alias\":\""
-            size_t alias_end = part_obj.find("\"", alias_start);
-            if (alias_end != std::string::npos) {
-                alias = part_obj.substr(alias_start, alias_end - alias_start);
+
+    size_t diode_count = 0;
+    for (const auto& part : json_diode_dict) diode_count += part.second.size();
+    std::cout << "Parsed " << part_alias_dict.size() << " part aliases, " << net_alias_dict.size() << " net aliases and "
+              << diode_count << " diode readings" << std::endl;
+}
+
+bool XZZPCBFile::ParseJsonTables(ByteView json, std::unordered_map<std::string, std::string>& part_aliases,
+                                 std::unordered_map<std::string, std::string>& net_aliases,
+                                 std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& diodes) {
+    // Structure: {"part":[{"reference":"N752","alias":"J11100","pad":[{"name":"1","diode":"0.512"},...]},...],
+    //             "net":[{"name":"Net665","alias":"PP_VDD_BOOST"},...]}
+    // Entries are stored as each object closes; anything else is skipped
+    using Token = JsonScanner::Token;
+    JsonScanner scanner(json);
+    auto scalar = [](Token t) { return t == Token::String || t == Token::Number; };
+
+    // Reused across objects so steady state parsing does not allocate
+    std::string reference, alias, name, diode;
+    std::vector<std::pair<std::string, std::string>> pads; // (name, diode); reference may follow the pad array
+    size_t pad_count = 0;
+
+    // Parses an array of flat objects, calling field(key, value_token) per
+    // member and close() after each object
+    auto parse_objects = [&](auto&& field, auto&& close) {
+        Token t;
+        while ((t = scanner.Next()) == Token::ObjectBegin) {
+            while ((t = scanner.Next()) == Token::Key) {
+                if (!field(scanner.Text(), scanner)) return false;
             }
+            if (t != Token::ObjectEnd) return false;
+            close();
         }
-        
-        // Store the alias mapping
-        if (!reference.empty() && !alias.empty()) {
-            part_alias_dict[reference] = alias;
-            std::cout << "Mapping part " << reference << " -> " << alias << std::endl;
-        }
-        
-        // Parse pad array for diode readings
-        size_t pad_array_start = part_obj.find("\"pad\":[");
-        if (pad_array_start != std::string::npos) {
-            pad_array_start += 7; // Skip "\"pad\":["
-            
-            // Find the end of pad array
-            size_t pad_array_end = pad_array_start;
-            int bracket_count = 1; // We already have one opening bracket
-            for (size_t i = pad_array_start; i < part_obj.length(); i++) {
-                if (part_obj[i] == '[') {
-                    bracket_count++;
-                } else if (part_obj[i] == ']') {
-                    bracket_count--;
-                    if (bracket_count == 0) {
-                        pad_array_end = i;
-                        break;
-                    }
-                }
-            }
-            
-            std::string pad_array = part_obj.substr(pad_array_start, pad_array_end - pad_array_start);
-            
-            // Parse individual pads
-            size_t pad_pos = 0;
-            while (pad_pos < pad_array.length()) {
-                size_t pad_start = pad_array.find("{", pad_pos);
-                if (pad_start == std::string::npos) break;
-                
-                size_t pad_end = pad_array.find("}", pad_start);
-                if (pad_end == std::string::npos) break;
-                
-                std::string pad_obj = pad_array.substr(pad_start, pad_end - pad_start + 1);
-                
-                // Extract pin name
-                std::string pin_name;
-                size_t name_start = pad_obj.find("\"name\":\"");
-                if (name_start != std::string::npos) {
-                    name_start += 8; // Skip "\"name\":\""
-                    size_t name_end = pad_obj.find("\"", name_start);
-                    if (name_end != std::string::npos) {
-                        pin_name = pad_obj.substr(name_start, name_end - name_start);
-                    }
-                }
-                
-                // Extract diode reading
-                std::string diode_reading;
-                size_t diode_start = pad_obj.find("\"diode\":\"");
-                if (diode_start != std::string::npos) {
-                    diode_start += 9; // Skip "\"diode\":\""
-                    size_t diode_end = pad_obj.find("\"", diode_start);
-                    if (diode_end != std::string::npos) {
-                        diode_reading = pad_obj.substr(diode_start, diode_end - diode_start);
-                    }
-                }
-                
-                // Store the diode reading for this part and pin
-                if (!reference.empty() && !pin_name.empty() && !diode_reading.empty()) {
-                    json_diode_dict[reference][pin_name] = diode_reading;
-                    std::cout << "Diode reading for " << reference << " pin " << pin_name << ": " << diode_reading << std::endl;
-                }
-                
-                pad_pos = pad_end + 1;
-            }
+        return t == Token::ArrayEnd;
+    };
+
+    auto pad_field = [&](std::string_view key, JsonScanner& s) {
+        const bool is_name = key == "name", is_diode = key == "diode";
+        Token v = s.Next();
+        if (scalar(v) && is_name) name.assign(s.Text());
+        else if (scalar(v) && is_diode) diode.assign(s.Text());
+        else return s.SkipValue(v) != Token::Error;
+        return true;
+    };
+    auto pad_close = [&]() {
+        if (!name.empty() && !diode.empty()) {
+            if (pads.size() <= pad_count) pads.emplace_back();
+            pads[pad_count].first.swap(name);
+            pads[pad_count].second.swap(diode);
+            pad_count++;
         }
-        
-        pos = part_end + 1;
-    }
-    
-    // Now look for net aliases in the JSON data
-    // Looking for: "net":[{"name":"Net665","alias":"PP_VDD_BOOST"},{"name":"Net642","alias":"PP_VDD_MAIN"}]
-    
-    size_t net_array_start = json_data.find("\"net\":[");
-    if (net_array_start != std::string::npos) {
-        std::cout << "Found 'net' array in JSON" << std::endl;
-        
-        // Start parsing from the opening bracket of the net array
-        size_t net_pos = net_array_start + 7; // Skip "\"net\":["
-        
-        while (net_pos < json_data.length()) {
-            // Find next net object
-            size_t net_start = json_data.find("{", net_pos);
-            if (net_start == std::string::npos) break;
-            
-            // Find the end of this net object
-            size_t net_end = net_start;
-            int net_brace_count = 0;
-            for (size_t i = net_start; i < json_data.length(); i++) {
-                if (json_data[i] == '{') {
-                    net_brace_count++;
-                } else if (json_data[i] == '}') {
-                    net_brace_count--;
-                    if (net_brace_count == 0) {
-                        net_end = i;
-                        break;
-                    }
-                }
-            }
-            
-            if (net_brace_count != 0) break;
-            
-            // Extract net object
-            std::string net_obj = json_data.substr(net_start, net_end - net_start + 1);
-            
-            // Parse name and alias
-            std::string net_name, net_alias;
-            
-            // Extract net name
-            size_t name_start = net_obj.find("\"name\":\"");
-            if (name_start != std::string::npos) {
-                name_start += 8; // Skip "\"name\":\""
-                size_t name_end = net_obj.find("\"", name_start);
-                if (name_end != std::string::npos) {
-                    net_name = net_obj.substr(name_start, name_end - name_start);
-                }
-            }
-            
-            // Extract alias
-            size_t alias_start = net_obj.find("\"alias\":\"");
-            if (alias_start != std::string::npos) {
-                alias_start += 9; // Skip "\"alias\":\""
-                size_t alias_end = net_obj.find("\"", alias_start);
-                if (alias_end != std::string::npos) {
-                    net_alias = net_obj.substr(alias_start, alias_end - alias_start);
-                }
-            }
-            
-            // Store the net alias mapping
-            if (!net_name.empty() && !net_alias.empty()) {
-                net_alias_dict[net_name] = net_alias;
-                std::cout << "Mapping net " << net_name << " -> " << net_alias << std::endl;
+        name.clear();
+        diode.clear();
+    };
+
+    auto part_field = [&](std::string_view key, JsonScanner& s) {
+        enum { kOther, kReference, kAlias, kPad } which =
+            key == "reference" ? kReference : key == "alias" ? kAlias : key == "pad" ? kPad : kOther;
+        Token v = s.Next();
+        if (which == kReference && scalar(v)) reference.assign(s.Text());
+        else if (which == kAlias && scalar(v)) alias.assign(s.Text());
+        else if (which == kPad && v == Token::ArrayBegin) return parse_objects(pad_field, pad_close);
+        else return s.SkipValue(v) != Token::Error;
+        return true;
+    };
+    auto part_close = [&]() {
+        if (!reference.empty()) {
+            if (!alias.empty()) part_aliases[reference] = alias;
+            if (pad_count > 0) {
+                auto& readings = diodes[reference];
+                for (size_t i = 0; i < pad_count; ++i) readings[pads[i].first] = pads[i].second;
             }
-            
-            net_pos = net_end + 1;
         }
-    } else {
-        std::cout << "No 'net' array found in JSON" << std::endl;
+        reference.clear();
+        alias.clear();
+        pad_count = 0;
+    };
+
+    auto net_field = [&](std::string_view key, JsonScanner& s) {
+        const bool is_name = key == "name", is_alias = key == "alias";
+        Token v = s.Next();
+        if (scalar(v) && is_name) name.assign(s.Text());
+        else if (scalar(v) && is_alias) alias.assign(s.Text());
+        else return s.SkipValue(v) != Token::Error;
+        return true;
+    };
+    auto net_close = [&]() {
+        if (!name.empty() && !alias.empty()) net_aliases[name] = alias;
+        name.clear();
+        alias.clear();
+    };
+
+    if (scanner.Next() != Token::ObjectBegin) return false;
+    Token t;
+    while ((t = scanner.Next()) == Token::Key) {
+        const bool is_part = scanner.Text() == "part", is_net = scanner.Text() == "net";
+        Token v = scanner.Next();
+        bool ok;
+        if (is_part && v == Token::ArrayBegin) ok = parse_objects(part_field, part_close);
+        else if (is_net && v == Token::ArrayBegin) ok = parse_objects(net_field, net_close);
+        else ok = scanner.SkipValue(v) != Token::Error;
+        if (!ok) return false;
     }
-    
-    std::cout << "Parsed " << part_alias_dict.size() << " part aliases and " << net_alias_dict.size() << " net aliases" << std::endl;
+    return t == Token::ObjectEnd;
 }
 
-void XZZPCBFile::DumpHexAroundPosition(const std::vector<char>& buf, size_t pos, size_t range) {
+void XZZPCBFile::DumpHexAroundPosition(ByteView buf, size_t pos, size_t range) {
     size_t start = (pos > range) ? pos - range : 0;
     size_t end = std::min(pos + range, buf.size());
     
@@ -1263,20 +1205,26 @@ void XZZPCBFile::DumpHexAroundPosition(const std::vector<char>& buf, size_t pos,
 }
 
 // Translation and mirroring functions
-void XZZPCBFile::FindXYTranslation() {
-    // Assuming line segments encompass all parts
-    // Find the min and max x and y values
-
-    if (outline_segments.empty()) {
+void XZZPCBFile::FindXYTranslation(const std::vector<BlockRef>& outline_blocks) {
+    // Assuming the outline encompasses all parts, its minimum x and y become the origin
+    if (outline_blocks.empty()) {
         xy_translation.x = 0;
         xy_translation.y = 0;
         return;
     }
-    xy_translation.x = outline_segments[0].first.x;
-    xy_translation.y = outline_segments[0].first.y;
-    for (auto& segment : outline_segments) {
-        xy_translation.x = std::min({xy_translation.x, segment.first.x, segment.second.x});
-        xy_translation.y = std::min({xy_translation.y, segment.first.y, segment.second.y});
+    xy_translation.x = std::numeric_limits<int>::max();
+    xy_translation.y = std::numeric_limits<int>::max();
+    for (const BlockRef& block : outline_blocks) {
+        if (block.type == 0x05) {
+            LineRecord record = ReadLineBlock(block.data);
+            xy_translation.x = std::min({xy_translation.x, record.a.x, record.b.x});
+            xy_translation.y = std::min({xy_translation.y, record.a.y, record.b.y});
+        } else {
+            float min_x, min_y, max_x, max_y;
+            ReadArcBlock(block.data).arc.GetBounds(min_x, min_y, max_x, max_y);
+            xy_translation.x = std::min(xy_translation.x, static_cast<int>(std::floor(min_x)));
+            xy_translation.y = std::min(xy_translation.y, static_cast<int>(std::floor(min_y)));
+        }
     }
 }
 
@@ -1285,44 +1233,6 @@ void XZZPCBFile::TranslatePoints(BRDPoint& point) const {
     point.y -= xy_translation.y;
 }
 
-void XZZPCBFile::TranslateSegments() {
-    for (auto& segment : outline_segments) {
-        TranslatePoints(segment.first);
-        TranslatePoints(segment.second);
-    }
-}
-
-void XZZPCBFile::TranslatePartOutlineSegments() {
-    for (auto& segment : part_outline_segments) {
-        TranslatePoints(segment.first);
-        TranslatePoints(segment.second);
-    }
-}
-
-void XZZPCBFile::TranslatePins() {
-    for (auto& pin : pins) {
-        TranslatePoints(pin.pos);
-    }
-}
-
-void XZZPCBFile::TranslateCircles() {
-    for (auto& circle : circles) {
-        TranslatePoints(circle.center);
-    }
-}
-
-void XZZPCBFile::TranslateRectangles() {
-    for (auto& rectangle : rectangles) {
-        TranslatePoints(rectangle.center);
-    }
-}
-
-void XZZPCBFile::TranslateOvals() {
-    for (auto& oval : ovals) {
-        TranslatePoints(oval.center);
-    }
-}
-
 // Legacy compatibility methods
 void XZZPCBFile::CreateEnhancedSampleData() {
     // This method is kept for compatibility but not used in the full implementation
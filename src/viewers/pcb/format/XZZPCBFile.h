@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BRDFileBase.h"
+#include "ByteView.h"
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
@@ -13,8 +14,8 @@ public:
     ~XZZPCBFile() = default;
 
     // Implementation of pure virtual methods
-    bool Load(const std::vector<char>& buffer, const std::string& filepath = "") override;
-    bool VerifyFormat(const std::vector<char>& buffer) override;
+    bool Load(ByteView buffer, const std::string& filepath = "") override;
+    bool VerifyFormat(ByteView buffer) override;
 
     // Static factory method
     static std::unique_ptr<XZZPCBFile> LoadFromFile(const std::string& filepath);
@@ -22,8 +23,29 @@ public:
     // Legacy compatibility method
     void CreateEnhancedSampleData();
 
+    // Part aliases, net aliases and per-pin diode readings from the embedded
+    // JSON object at the start of json, in one streaming pass. Entries parsed
+    // before a syntax error are kept; returns false on malformed/truncated input
+    static bool ParseJsonTables(ByteView json, std::unordered_map<std::string, std::string>& part_aliases,
+                                std::unordered_map<std::string, std::string>& net_aliases,
+                                std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& diodes);
+
+    // Offsets of the section markers (npos when absent). part_array, the
+    // fallback for files without a JSON marker, is only searched until one is found
+    struct Markers {
+        size_t post_v6 = ByteView::npos;    // v6v6555v6v6
+        size_t json = ByteView::npos;       // JSON marker
+        size_t part_array = ByteView::npos; // "part":[
+    };
+    // Markers of a plain file, in one pass over the buffer
+    static Markers FindMarkers(ByteView buf);
+    // XOR-decodes an obfuscated file in place (up to the post-v6 marker) and
+    // finds its markers in the same pass; plain files are only scanned
+    static Markers DecodeInPlace(std::vector<char>& buf);
+
 private:
     std::unordered_map<uint32_t, std::string> net_dict;
+    std::unordered_map<uint32_t, uint32_t> trace_net_slots; // <Net index, index into trace_nets>
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> diode_dict; // <Net Name, <Pin Name, Reading>>
     std::unordered_map<std::string, std::string> part_alias_dict; // <Reference (original part name), Alias (new part name)>
     std::unordered_map<std::string, std::string> net_alias_dict; // <Net Name (original), Alias (new net name)>
@@ -31,37 +53,88 @@ private:
     BRDPoint xy_translation = {0, 0};
     int diode_readings_type = 0; // 0 = No readings, 1 = Based on part name and pin name, 2 = Based on net
 
-    // Core parsing method
-    bool ParseXZZPCBOriginal(std::vector<char>& buf);
+    // Geometry produced by a single part block (0x07). Part blocks are parsed
+    // independently (possibly on worker threads) and merged in file order.
+    struct PartBlockResult {
+        bool has_part = false;
+        BRDPart part;
+        std::vector<BRDPin> pins; // pin.part is assigned on merge
+        // Per pin; workers cannot intern, so the ids are assigned on merge
+        struct PinStrings {
+            std::string net;
+            std::string name; // also the pin number
+        };
+        std::vector<PinStrings> pin_strings;
+        std::vector<std::pair<BRDPoint, BRDPoint>> outline_segments;
+        std::vector<BRDCircle> circles;
+        std::vector<BRDRectangle> rectangles;
+        std::vector<BRDOval> ovals;
+        // Logged once after the merge; workers do not write to stdout
+        size_t part_aliases = 0;
+        size_t net_aliases = 0;
+        size_t json_diodes = 0;
+        std::vector<std::pair<uint8_t, size_t>> unknown_sub_blocks; // type, offset in block
+        std::string part_name; // part name before aliasing, for the log
+    };
+
+    // A main-data block: type byte and payload
+    struct BlockRef {
+        uint8_t type;
+        ByteView data;
+    };
+    // Decoded 0x01 / 0x05 blocks (board outline or copper), before translation
+    struct ArcRecord {
+        int layer = 0;
+        BRDArc arc;
+        uint32_t net = 0; // net block index
+    };
+    struct LineRecord {
+        int layer = 0;
+        BRDPoint a, b;
+        float width = 0.0f;
+        uint32_t net = 0; // net block index
+    };
+
+    // Loading helpers. Plain files are parsed straight from the caller's
+    // buffer; obfuscated ones are XOR-decoded in place in an owned buffer.
+    bool PrepareLoad(ByteView buffer, const std::string& filepath);
+    bool LoadInPlace(std::vector<char>& buf, const std::string& filepath);
+    static bool HasXorHeader(ByteView buf);
+    static Markers ScanMarkers(char* data, size_t size, uint8_t xor_key);
+
+    // Core parsing method (buf must already be XOR-decoded)
+    bool ParseXZZPCBOriginal(ByteView buf, const Markers& markers);
     
-    // DES decryption
-    void des_decrypt(std::vector<char>& buf);
+    // DES decryption; the decrypted block is the only copy made while parsing
+    static std::vector<char> des_decrypt(ByteView encrypted);
     
-    // Arc conversion
-    std::vector<std::pair<BRDPoint, BRDPoint>> xzz_arc_to_segments(int startAngle, int endAngle, int r, BRDPoint pc);
+    // Arc conversion (kept analytic; the renderer tessellates per zoom)
+    static BRDArc xzz_arc(float startAngle, float endAngle, float r, BRDPoint pc);
     
     // Block parsing methods
-    void ProcessBlockOriginal(uint8_t block_type, std::vector<char>& block_buf);
-    void ParseArcBlockOriginal(std::vector<uint32_t>& buf);
-    void ParseLineSegmentBlockOriginal(std::vector<uint32_t>& buf);
-    void ParsePartBlockOriginal(std::vector<char>& buf);
-    void ParseTestPadBlockOriginal(std::vector<uint8_t>& buf);
-    void ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<char>& buf);
-    void ParseNetBlockOriginal(std::vector<char>& buf);
-    void ParseJsonData(std::vector<char>::iterator json_start, std::vector<char>& buf);
-    void DumpHexAroundPosition(const std::vector<char>& buf, size_t pos, size_t range = 50);
+    void ProcessBlockOriginal(uint8_t block_type, ByteView block);
+    static ArcRecord ReadArcBlock(ByteView block);
+    static LineRecord ReadLineBlock(ByteView block);
+    void ParseArcBlockOriginal(ByteView block);
+    void ParseLineSegmentBlockOriginal(ByteView block);
+    static bool IsCopperLayer(int layer);
+    static bool IsOutlineLayer(int layer);
+    uint32_t TraceNetSlot(uint32_t net_index); // trace_nets entry for a net block index (aliased like pins)
+    void ParsePartBlockOriginal(ByteView block);
+    void ParsePartBlockOriginal(ByteView block, PartBlockResult& result) const;
+    void MergePartBlock(PartBlockResult& result);
+    void ParseTestPadBlockOriginal(ByteView block);
+    void ParsePostV6(const Markers& markers, ByteView buf);
+    void ParseNetBlockOriginal(ByteView block);
+    void ParseJsonData(size_t json_start, ByteView buf);
+    void DumpHexAroundPosition(ByteView buf, size_t pos, size_t range = 50);
     
     // String handling
     char read_utf8_char(char c) const;
     std::string read_cb2312_string(const std::string& str);
     
-    // Translation functions
-    void FindXYTranslation();
-    void TranslateSegments();
-    void TranslatePartOutlineSegments();
+    // Translation: found from the outline (layer 17/28 arc and line) blocks
+    // before anything else is parsed, then applied to each point as it is stored
+    void FindXYTranslation(const std::vector<BlockRef>& outline_blocks);
     void TranslatePoints(BRDPoint& point) const;
-    void TranslatePins();
-    void TranslateCircles();
-    void TranslateRectangles();
-    void TranslateOvals();
 };
@@ -309,6 +309,179 @@ uint64_t des(uint64_t input, uint64_t key, char mode) {
 
 }
 
+/*
+ * Lookup tables for the context API, derived once from the reference tables
+ * above so both paths share a single definition of the cipher.
+ *
+ * ip/pi: per-byte contributions to the initial/inverse permutations
+ * sp:    S-box output already run through the P permutation, indexed by the
+ *        raw 6-bit S-box input (row and column bits interleaved)
+ */
+struct des_tables {
+    uint64_t ip[8][256];
+    uint64_t pi[8][256];
+    uint32_t sp[8][64];
+};
+
+static uint64_t permute64(uint64_t input, const char* table) {
+
+    uint64_t res = 0;
+
+    for (int i = 0; i < 64; i++) {
+        res <<= 1;
+        res |= (input >> (64-table[i])) & LB64_MASK;
+    }
+
+    return res;
+
+}
+
+static des_tables build_des_tables() {
+
+    des_tables t;
+
+    for (int b = 0; b < 8; b++) {
+        for (int v = 0; v < 256; v++) {
+            uint64_t in = ((uint64_t) v) << (56 - 8*b);
+            t.ip[b][v] = permute64(in, IP);
+            t.pi[b][v] = permute64(in, PI);
+        }
+    }
+
+    for (int j = 0; j < 8; j++) {
+        for (int v = 0; v < 64; v++) {
+            int row = ((v >> 4) & 0x02) | (v & 0x01);
+            int column = (v >> 1) & 0x0f;
+            uint32_t s_output = ((uint32_t) (S[j][16*row + column] & 0x0f)) << (28 - 4*j);
+            uint32_t f = 0;
+            for (int i = 0; i < 32; i++) {
+                f <<= 1;
+                f |= (s_output >> (32 - P[i])) & LB32_MASK;
+            }
+            t.sp[j][v] = f;
+        }
+    }
+
+    return t;
+
+}
+
+static const des_tables& get_des_tables() {
+    static const des_tables tables = build_des_tables();
+    return tables;
+}
+
+static inline uint64_t lookup64(const uint64_t table[8][256], uint64_t x) {
+    return table[0][(x >> 56) & 0xff] | table[1][(x >> 48) & 0xff] |
+           table[2][(x >> 40) & 0xff] | table[3][(x >> 32) & 0xff] |
+           table[4][(x >> 24) & 0xff] | table[5][(x >> 16) & 0xff] |
+           table[6][(x >>  8) & 0xff] | table[7][ x        & 0xff];
+}
+
+static inline uint32_t rotr32(uint32_t x, unsigned n) {
+    n &= 31;
+    return n ? (x >> n) | (x << (32 - n)) : x;
+}
+
+void des_set_key(des_ctx* ctx, uint64_t key) {
+
+    uint64_t permuted_choice_1 = 0;
+    uint32_t C, D;
+
+    for (int i = 0; i < 56; i++) {
+        permuted_choice_1 <<= 1;
+        permuted_choice_1 |= (key >> (64-PC1[i])) & LB64_MASK;
+    }
+
+    C = (uint32_t) ((permuted_choice_1 >> 28) & 0x000000000fffffff);
+    D = (uint32_t) (permuted_choice_1 & 0x000000000fffffff);
+
+    for (int i = 0; i < 16; i++) {
+
+        for (int j = 0; j < iteration_shift[i]; j++) {
+            C = (0x0fffffff & (C << 1)) | (0x00000001 & (C >> 27));
+            D = (0x0fffffff & (D << 1)) | (0x00000001 & (D >> 27));
+        }
+
+        uint64_t permuted_choice_2 = (((uint64_t) C) << 28) | (uint64_t) D;
+        uint64_t sub_key = 0;
+
+        for (int j = 0; j < 48; j++) {
+            sub_key <<= 1;
+            sub_key |= (permuted_choice_2 >> (56-PC2[j])) & LB64_MASK;
+        }
+
+        for (int j = 0; j < 8; j++) {
+            ctx->sub_key[i][j] = (uint8_t) ((sub_key >> (42 - 6*j)) & 0x3f);
+        }
+
+    }
+
+}
+
+uint64_t des_crypt_block(const des_ctx* ctx, uint64_t input, char mode) {
+
+    const des_tables& t = get_des_tables();
+
+    uint64_t init_perm_res = lookup64(t.ip, input);
+    uint32_t L = (uint32_t) (init_perm_res >> 32);
+    uint32_t R = (uint32_t) init_perm_res;
+
+    for (int i = 0; i < 16; i++) {
+
+        const uint8_t* k = ctx->sub_key[mode == 'd' ? 15 - i : i];
+
+        /*
+         * The expansion E takes bits 4j..4j+5 (1-based, wrapping) of R for
+         * S-box j, so each 6-bit chunk is a rotation of R.
+         */
+        uint32_t f = t.sp[0][(rotr32(R, 27) ^ k[0]) & 0x3f]
+                   | t.sp[1][(rotr32(R, 23) ^ k[1]) & 0x3f]
+                   | t.sp[2][(rotr32(R, 19) ^ k[2]) & 0x3f]
+                   | t.sp[3][(rotr32(R, 15) ^ k[3]) & 0x3f]
+                   | t.sp[4][(rotr32(R, 11) ^ k[4]) & 0x3f]
+                   | t.sp[5][(rotr32(R,  7) ^ k[5]) & 0x3f]
+                   | t.sp[6][(rotr32(R,  3) ^ k[6]) & 0x3f]
+                   | t.sp[7][(rotr32(R, 31) ^ k[7]) & 0x3f];
+
+        uint32_t temp = R;
+        R = L ^ f;
+        L = temp;
+
+    }
+
+    uint64_t pre_output = (((uint64_t) R) << 32) | (uint64_t) L;
+
+    return lookup64(t.pi, pre_output);
+
+}
+
+size_t des_decrypt_buffer(const des_ctx* ctx, unsigned char* buf, size_t len) {
+
+    size_t blocks = len / 8;
+
+    for (size_t n = 0; n < blocks; n++) {
+
+        unsigned char* p = buf + n*8;
+        uint64_t e64 = 0;
+
+        for (int i = 0; i < 8; i++) {
+            e64 = (e64 << 8) | p[i];
+        }
+
+        uint64_t d64 = des_crypt_block(ctx, e64, 'd');
+
+        for (int i = 7; i >= 0; i--) {
+            p[i] = (unsigned char) (d64 & 0xff);
+            d64 >>= 8;
+        }
+
+    }
+
+    return blocks;
+
+}
+
 #ifdef TEST_DES_IMPLEMENTATION
 int main(int argc, const char * argv[]) {
 
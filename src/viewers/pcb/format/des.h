@@ -13,6 +13,9 @@
 #ifndef DES_H
 #define DES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +28,33 @@ extern "C" {
  */
 uint64_t des(uint64_t input, uint64_t key, char mode);
 
+/*
+ * Table-driven DES with a precomputed key schedule
+ *
+ * des() above recomputes the 16 subkeys and walks every permutation one bit
+ * at a time on each call. It is kept as the bit-exact reference; bulk
+ * decryption should expand the key once with des_set_key() and reuse the
+ * context for every block.
+ */
+typedef struct des_ctx {
+    /* 6-bit subkey chunks, 8 per round, in encryption order */
+    uint8_t sub_key[16][8];
+} des_ctx;
+
+/* Expand the 16 round subkeys for key into ctx */
+void des_set_key(des_ctx* ctx, uint64_t key);
+
+/* Encrypt ('e') or decrypt ('d') one block; same result as des(input, key, mode) */
+uint64_t des_crypt_block(const des_ctx* ctx, uint64_t input, char mode);
+
+/*
+ * Decrypt a buffer in place. Each 8-byte block is read as a big-endian
+ * 64 bit value (first byte is the most significant) and written back the
+ * same way. Trailing bytes that do not fill a whole block are left
+ * untouched. Returns the number of blocks decrypted.
+ */
+size_t des_decrypt_buffer(const des_ctx* ctx, unsigned char* buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
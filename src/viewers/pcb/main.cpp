@@ -64,6 +64,7 @@ public:
             LOG_ERROR("Failed to initialize ImGui OpenGL3 backend");
             return false;
         }
+        renderer.SetGpuPadsEnabled(true);
 
         // Set the user pointer for the window
         glfwSetWindowUserPointer(window.GetHandle(), this);
@@ -119,6 +120,7 @@ public:
             
             // Render ImGui
             ImGui::Render();
+            renderer.SubmitScene(ImGui::GetDrawData());
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
             
             window.SwapBuffers();
@@ -290,27 +292,27 @@ private:
             BRDPin pin;
             pin.pos = {2000 + i * 250, 2000};
             pin.part = 0;
-            pin.name = std::to_string(i + 1);  // Pin number
-            pin.net = (i < net_names.size()) ? net_names[i] : "NET_" + std::to_string(i);
-            pin.snum = std::to_string(i + 1);
+            sample_pcb->SetPinName(pin, std::to_string(i + 1));  // Pin number
+            sample_pcb->SetPinNet(pin, (i < net_names.size()) ? net_names[i] : "NET_" + std::to_string(i));
+            sample_pcb->SetPinSnum(pin, std::to_string(i + 1));
             pin.radius = 50;
             sample_pcb->pins.push_back(pin);
             
             // Debug log each pin
-            LOG_INFO("Pin " + std::to_string(i+1) + ": name='" + pin.name + "', net='" + pin.net + "', snum='" + pin.snum + "'");
+            LOG_INFO("Pin " + std::to_string(i+1) + ": name='" + sample_pcb->PinName(pin) + "', net='" + sample_pcb->PinNet(pin) + "', snum='" + sample_pcb->PinSnum(pin) + "'");
         }
           for (int i = 0; i < 6; ++i) {
             BRDPin pin;
             pin.pos = {6000 + i * 300, 4000};
             pin.part = 1;
-            pin.name = std::to_string(i + 1);  // Pin number
-            pin.net = (i < net_names2.size()) ? net_names2[i] : "NET_" + std::to_string(i + 8);
-            pin.snum = std::to_string(i + 1);
+            sample_pcb->SetPinName(pin, std::to_string(i + 1));  // Pin number
+            sample_pcb->SetPinNet(pin, (i < net_names2.size()) ? net_names2[i] : "NET_" + std::to_string(i + 8));
+            sample_pcb->SetPinSnum(pin, std::to_string(i + 1));
             pin.radius = 60;
             sample_pcb->pins.push_back(pin);
             
             // Debug log each pin
-            LOG_INFO("Pin " + std::to_string(i+9) + ": name='" + pin.name + "', net='" + pin.net + "', snum='" + pin.snum + "'");
+            LOG_INFO("Pin " + std::to_string(i+9) + ": name='" + sample_pcb->PinName(pin) + "', net='" + sample_pcb->PinNet(pin) + "', snum='" + sample_pcb->PinSnum(pin) + "'");
         }// Validate and set data
         sample_pcb->SetValid(true);  // For demo data, we know it's valid
         
@@ -441,6 +443,9 @@ private:
         
         if (hovered_pin >= 0 && pcb_data && hovered_pin < static_cast<int>(pcb_data->pins.size())) {
             const auto& pin = pcb_data->pins[hovered_pin];
+            const std::string& pin_snum = pcb_data->PinSnum(pin);
+            const std::string& pin_name = pcb_data->PinName(pin);
+            const std::string& pin_net = pcb_data->PinNet(pin);
             
             // Create hover tooltip
             ImGui::SetNextWindowPos(ImVec2(static_cast<float>(mouse_x) + 15, static_cast<float>(mouse_y) + 15));
@@ -455,19 +460,19 @@ private:
                 ImGui::Text("Pin Information:");
                 ImGui::Separator();
                 
-                if (!pin.snum.empty()) {
-                    ImGui::Text("Pin Number: %s", pin.snum.c_str());
-                }                if (!pin.name.empty() && pin.name != pin.snum) {
-                    ImGui::Text("Pin Name: %s", pin.name.c_str());
+                if (!pin_snum.empty()) {
+                    ImGui::Text("Pin Number: %s", pin_snum.c_str());
+                }                if (!pin_name.empty() && pin.name_id != pin.snum_id) {
+                    ImGui::Text("Pin Name: %s", pin_name.c_str());
                 }
-                if (!pin.net.empty()) {
-                    ImGui::Text("Net: %s", pin.net.c_str());
+                if (!pin_net.empty()) {
+                    ImGui::Text("Net: %s", pin_net.c_str());
                     
                     // Count connected pins in the same net
-                    if (pin.net != "UNCONNECTED" && pin.net != "") {
+                    if (pin.net_id != kUnconnectedNetId && pin.net_id != kEmptyStringId) {
                         int connected_pins = 0;
                         for (const auto& other_pin : pcb_data->pins) {
-                            if (other_pin.net == pin.net) {
+                            if (other_pin.net_id == pin.net_id) {
                                 connected_pins++;
                             }
                         }
@@ -496,25 +501,28 @@ private:
             int selected_pin = renderer.GetSelectedPinIndex();
             if (selected_pin >= 0 && selected_pin < static_cast<int>(pcb_data->pins.size())) {
                 const auto& pin = pcb_data->pins[selected_pin];
+                const std::string& pin_snum = pcb_data->PinSnum(pin);
+                const std::string& pin_name = pcb_data->PinName(pin);
+                const std::string& pin_net = pcb_data->PinNet(pin);
                 
                 ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
                 if (ImGui::Begin("Selected Pin Details", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
                     ImGui::Text("Selected Pin:");
                     ImGui::Separator();
                     
-                    if (!pin.snum.empty()) {
-                        ImGui::Text("Pin Number: %s", pin.snum.c_str());
+                    if (!pin_snum.empty()) {
+                        ImGui::Text("Pin Number: %s", pin_snum.c_str());
                     }
-                    if (!pin.name.empty() && pin.name != pin.snum) {
-                        ImGui::Text("Pin Name: %s", pin.name.c_str());
-                    }                    if (!pin.net.empty()) {
-                        ImGui::Text("Net: %s", pin.net.c_str());
+                    if (!pin_name.empty() && pin.name_id != pin.snum_id) {
+                        ImGui::Text("Pin Name: %s", pin_name.c_str());
+                    }                    if (!pin_net.empty()) {
+                        ImGui::Text("Net: %s", pin_net.c_str());
                         
                         // Show connected pins count for selected pin
-                        if (pin.net != "UNCONNECTED" && pin.net != "") {
+                        if (pin.net_id != kUnconnectedNetId && pin.net_id != kEmptyStringId) {
                             int connected_pins = 0;
                             for (const auto& other_pin : pcb_data->pins) {
-                                if (other_pin.net == pin.net) {
+                                if (other_pin.net_id == pin.net_id) {
                                     connected_pins++;
                                 }
                             }
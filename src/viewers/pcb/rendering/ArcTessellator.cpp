@@ -0,0 +1,50 @@
+#include "ArcTessellator.h"
+#include <algorithm>
+#include <cmath>
+
+void ArcTessellator::Reset(size_t arc_count) {
+    first.assign(arc_count, kNone);
+    counts.assign(arc_count, 0);
+    points.clear();
+}
+
+void ArcTessellator::SetZoom(float zoom) {
+    int b = static_cast<int>(std::floor(std::log2(std::max(zoom, 1e-6f)) * kZoomSteps));
+    if (b == bucket) return;
+    bucket = b;
+    bucket_zoom = std::exp2(static_cast<float>(b + 1) / kZoomSteps);
+    Reset(first.size());
+}
+
+int ArcTessellator::SegmentCount(float radius_px, float sweep_degrees) {
+    const double sweep = std::fabs(sweep_degrees) * 3.14159265358979323846 / 180.0;
+    if (radius_px <= kTolerancePx || sweep <= 0.0) return 1;
+    // A chord spanning angle t deviates r * (1 - cos(t / 2)) from the arc
+    const double step = 2.0 * std::acos(1.0 - static_cast<double>(kTolerancePx) / radius_px);
+    if (step * kMaxSegments <= sweep) return kMaxSegments;
+    return std::max(1, static_cast<int>(std::ceil(sweep / step)));
+}
+
+const ArcTessellator::Point* ArcTessellator::Polyline(const BRDArc& arc, size_t index, uint32_t& point_count) {
+    if (index >= first.size()) {
+        point_count = 0;
+        return nullptr;
+    }
+    if (first[index] == kNone) {
+        if (points.size() > kMaxCachedPoints) Reset(first.size());
+
+        const int segments = SegmentCount(arc.radius * bucket_zoom, arc.sweep_angle);
+        const double deg_to_rad = 3.14159265358979323846 / 180.0;
+        const double start = arc.start_angle * deg_to_rad;
+        const double step = arc.sweep_angle * deg_to_rad / segments;
+        first[index] = static_cast<uint32_t>(points.size());
+        counts[index] = static_cast<uint16_t>(segments + 1);
+        for (int i = 0; i <= segments; ++i) {
+            double angle = start + step * i;
+            points.push_back({static_cast<float>(arc.center.x + arc.radius * std::cos(angle)),
+                              static_cast<float>(arc.center.y + arc.radius * std::sin(angle))});
+        }
+    }
+    point_count = counts[index];
+    return &points[first[index]];
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "BRDTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Render-time tessellation of one list of BRDArcs. Each arc is split into as
+// many chords as its on-screen radius needs to stay within kTolerancePx of the
+// true curve, computed for the upper zoom of the current zoom bucket (so the
+// error bound holds for the whole bucket). Polylines are built the first time
+// an arc is drawn and kept until the zoom leaves the bucket.
+class ArcTessellator {
+public:
+    struct Point { float x = 0.f, y = 0.f; };
+
+    static constexpr int kZoomSteps = 4;          // buckets per doubling of zoom
+    static constexpr float kTolerancePx = 0.25f;  // max chord-to-arc distance
+    static constexpr int kMaxSegments = 128;      // per arc
+    static constexpr size_t kMaxCachedPoints = size_t(1) << 21; // dropped and refilled past this
+
+    // Forgets every polyline; arc_count is the size of the list being served
+    void Reset(size_t arc_count);
+    // Selects zoom's bucket, dropping the polylines made for another bucket
+    void SetZoom(float zoom);
+
+    // Polyline of arcs[index] in board units (count + 1 points for count
+    // chords). The pointer is valid until the next Polyline() or Reset() call
+    const Point* Polyline(const BRDArc& arc, size_t index, uint32_t& point_count);
+
+    // Chords needed for a sweep (degrees) at a radius in pixels
+    static int SegmentCount(float radius_px, float sweep_degrees);
+
+    int ZoomBucket() const { return bucket; }
+    size_t CachedPoints() const { return points.size(); }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    int bucket = INT32_MIN;
+    float bucket_zoom = 1.0f; // upper zoom of the bucket
+    std::vector<uint32_t> first;  // per arc, into points, kNone until built
+    std::vector<uint16_t> counts; // per arc, points in its polyline
+    std::vector<Point> points;
+};
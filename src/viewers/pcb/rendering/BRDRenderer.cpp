@@ -48,12 +48,12 @@ void BRDRenderer::Render(int window_width, int window_height) {
     PCBRenderer::Render(window_width, window_height);
 }
 
-void BRDRenderer::RenderBRDPins(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void BRDRenderer::RenderBRDPins(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     // Use the existing pin rendering methods from base class
     // They now include BRD-specific mirroring logic
-    RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y);
+    RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y);
+    RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y);
 }
 
 void BRDRenderer::RenderBRDParts(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
@@ -66,14 +66,14 @@ void BRDRenderer::RenderBRDOutline(ImDrawList* draw_list, float zoom, float offs
     RenderOutlineImGui(draw_list, zoom, offset_x, offset_y);
 }
 
-void BRDRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void BRDRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     // Call base class method - text positioning will be handled by pin geometry which is already mirrored
-    PCBRenderer::RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    PCBRenderer::RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y);
 }
 
-void BRDRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float offset_y) {
+void BRDRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float offset_y, int window_width, int window_height) {
     // Call base class method - part positioning will be handled by part geometry which is already mirrored
-    PCBRenderer::CollectPartNamesForRendering(zoom, offset_x, offset_y);
+    PCBRenderer::CollectPartNamesForRendering(zoom, offset_x, offset_y, window_width, window_height);
 }
 
 bool BRDRenderer::IsPinOnBottomSide(const BRDPin& pin) const {
@@ -23,13 +23,13 @@ public:
     void Render(int window_width, int window_height);
     
     // BRD-specific rendering methods
-    void RenderBRDPins(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void RenderBRDPins(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
     void RenderBRDParts(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
     void RenderBRDOutline(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
     
     // Override text rendering for BRD mirroring support
-    void RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
-    void CollectPartNamesForRendering(float zoom, float offset_x, float offset_y);
+    void RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
+    void CollectPartNamesForRendering(float zoom, float offset_x, float offset_y, int window_width, int window_height);
     
     // BRD-specific features
     void SetBottomSideMirroringEnabled(bool enabled) { mirror_bottom_side = enabled; }
@@ -3,6 +3,7 @@
 #include "Utils.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <vector>
 #include <set>
 #include <unordered_map>
@@ -10,34 +11,7 @@
 #include <cctype>
 #include <GL/glew.h>
 #include <iostream>
-
-// Simple vertex shader - kept for reference but not used in ImGui rendering
-const char* vertex_shader_source = R"(
-#version 330 core
-layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec3 aColor;
-
-uniform mat4 projection;
-out vec3 vertexColor;
-
-void main() {
-    gl_Position = projection * vec4(aPos, 0.0, 1.0);
-    vertexColor = aColor;
-}
-)";
-
-// Simple fragment shader - kept for reference but not used in ImGui rendering
-const char* fragment_shader_source = R"(
-#version 330 core
-in vec3 vertexColor;
-out vec4 FragColor;
-
-uniform float alpha;
-
-void main() {
-    FragColor = vec4(vertexColor, alpha);
-}
-)";
+#include <limits>
 
 PCBRenderer::PCBRenderer() {
 }
@@ -47,61 +21,29 @@ PCBRenderer::~PCBRenderer() {
 }
 
 bool PCBRenderer::Initialize() {
-    // Initialize minimal GL state but don't fail if modern features are missing.
-    // ImGui handles all drawing; these resources are optional.
-
-    bool hasVBO = glewIsSupported("GL_ARB_vertex_buffer_object") || GLEW_VERSION_2_0;
-    bool hasVAO = glewIsSupported("GL_ARB_vertex_array_object") || GLEW_VERSION_3_0;
-    bool hasShaders = glewIsSupported("GL_ARB_shader_objects") || GLEW_VERSION_2_0;
-
-    // Try to create a tiny shader program only if shaders are supported; ignore failure.
-    if (hasShaders) {
-        if (!CreateShaderProgram()) {
-            LOG_ERROR("Shader program unavailable; continuing with ImGui-only rendering");
-            shader_program = 0;
-        }
-    }
-
-    // Create optional VAO/VBO only if supported; skip otherwise.
-    if (hasVBO) {
-        if (hasVAO) {
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-        }
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-        // Position attribute
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        // Color attribute
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        if (hasVAO) glBindVertexArray(0);
-    }
-
-    LOG_INFO("PCB Renderer initialized (optional GL resources: VBO=" + std::string(hasVBO?"Y":"N") + ", VAO=" + std::string(hasVAO?"Y":"N") + ", Shaders=" + std::string(hasShaders?"Y":"N") + ")");
+    // ImGui handles all drawing by default; the instanced pad path is opted
+    // into with SetGpuPadsEnabled once the ImGui backend is known
+    LOG_INFO("PCB Renderer initialized (GL 3.3: " + std::string(GLEW_VERSION_3_3 ? "Y" : "N") + ")");
     // Ensure default theme applied
     SetColorTheme(ColorTheme::Default);
     return true;
 }
 
 void PCBRenderer::Cleanup() {
-    if (vbo) {
-        glDeleteBuffers(1, &vbo);
-        vbo = 0;
-    }
-    if (vao) {
-        glDeleteVertexArrays(1, &vao);
-        vao = 0;
+    pad_batch.Shutdown();
+}
+
+bool PCBRenderer::SetGpuPadsEnabled(bool enabled) {
+    if (!enabled) {
+        pad_batch.Shutdown();
+        return false;
     }
-    if (shader_program) {
-        glDeleteProgram(shader_program);
-        shader_program = 0;
+    scene_dirty = true;
+    if (!pad_batch.IsReady() && pad_batch.Initialize()) {
+        pad_batch_dirty = true;
+        LOG_INFO("Pads use the instanced GPU renderer");
     }
+    return pad_batch.IsReady();
 }
 
 void PCBRenderer::SetPCBData(std::shared_ptr<BRDFileBase> data) {
@@ -111,8 +53,15 @@ void PCBRenderer::SetPCBData(std::shared_ptr<BRDFileBase> data) {
         LOG_INFO("PCB data set: " + std::to_string(pcb_data->parts.size()) + 
                 " parts, " + std::to_string(pcb_data->pins.size()) + " pins");
         
+        // Loaders build these; hand-made boards (sample data) may not have
+        if (!pcb_data->HasIndices()) pcb_data->BuildIndices();
+
         // Build performance optimization cache
         BuildPinGeometryCache();
+        BuildRenderGrids();
+        pad_batch_dirty = true;
+        scene_dirty = true;
+        ResetLabelLayouts();
 
     // Cache board center for rotation pivot
     BRDPoint min_point, max_point;
@@ -123,6 +72,7 @@ void PCBRenderer::SetPCBData(std::shared_ptr<BRDFileBase> data) {
 }
 
 void PCBRenderer::Render(int window_width, int window_height) {
+    scene_pending = false;
     if (!pcb_data || !pcb_data->IsValid()) {
         LOG_INFO("No PCB data to render");
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -141,13 +91,6 @@ void PCBRenderer::Render(int window_width, int window_height) {
         camera_initialized = true;
     }
     
-    // Calculate screen transform from camera
-    float zoom = camera.zoom;
-    float offset_x = window_width * 0.5f - camera.x * zoom;
-    float offset_y = window_height * 0.5f + camera.y * zoom;  // Mirror Y-axis
-    
-    // Apply camera transformation
-
     // Create a fullscreen ImGui window for PCB rendering
     ImGui::SetNextWindowPos(ImVec2(0, 0));
     ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
@@ -163,38 +106,129 @@ void PCBRenderer::Render(int window_width, int window_height) {
         return;
     }
 
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-    if (!draw_list) {
-        LOG_ERROR("Failed to get ImGui draw list");
-        ImGui::End();
-        return;
-    }    // Use structured ImGui rendering methods (like original OpenBoardView)
+    // The board is drawn into a retained draw list that SubmitScene() puts
+    // under this frame's ImGui output; it is re-emitted only when something it
+    // depends on changed, so idle frames cost a key comparison
+    SceneKey key = CurrentSceneKey(window_width, window_height);
+    if (!scene_list) scene_list = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+    if (scene_dirty || !SameScene(key, scene_key)) {
+        EmitScene(scene_list.get(), window_width, window_height);
+        scene_key = std::move(key);
+        scene_dirty = false;
+        scene_builds++;
+    }
+    scene_pending = true;
+
+    ImGui::End();
+}
+
+void PCBRenderer::SubmitScene(ImDrawData* draw_data) {
+    if (!scene_pending || !draw_data || !scene_list || scene_list->CmdBuffer.Size == 0) return;
+    scene_pending = false;
+    // First in the list: drawn before (under) every ImGui window
+    draw_data->CmdLists.push_front(scene_list.get());
+    draw_data->CmdListsCount++;
+    draw_data->TotalVtxCount += scene_list->VtxBuffer.Size;
+    draw_data->TotalIdxCount += scene_list->IdxBuffer.Size;
+}
+
+bool PCBRenderer::NeedsRedraw(int window_width, int window_height) const {
+    if (!pcb_data || !pcb_data->IsValid()) return false;
+    return scene_dirty || !SameScene(CurrentSceneKey(window_width, window_height, false), scene_key);
+}
+
+PCBRenderer::SceneKey PCBRenderer::CurrentSceneKey(int window_width, int window_height, bool with_font) const {
+    SceneKey key;
+    key.width = window_width;
+    key.height = window_height;
+    key.camera = camera;
+    key.selected_pin = selected_pin_index;
+    key.highlighted_part = highlighted_part_index;
+    key.highlighted_net = highlighted_net;
+    key.layer_filter = layer_filter;
+    key.settings = settings;
+    if (with_font) {
+        key.font = ImGui::GetFont();
+        key.font_size = ImGui::GetFontSize();
+        key.font_texture = ImGui::GetIO().Fonts->TexID;
+    } else {
+        key.font = scene_key.font;
+        key.font_size = scene_key.font_size;
+        key.font_texture = scene_key.font_texture;
+    }
+    return key;
+}
+
+bool PCBRenderer::SameScene(const SceneKey& a, const SceneKey& b) {
+    return a.width == b.width && a.height == b.height &&
+           a.camera.x == b.camera.x && a.camera.y == b.camera.y && a.camera.zoom == b.camera.zoom &&
+           a.camera.rotation_steps == b.camera.rotation_steps &&
+           a.camera.flip_horizontal == b.camera.flip_horizontal && a.camera.flip_vertical == b.camera.flip_vertical &&
+           a.selected_pin == b.selected_pin && a.highlighted_part == b.highlighted_part &&
+           a.highlighted_net == b.highlighted_net && a.layer_filter == b.layer_filter &&
+           a.font == b.font && a.font_size == b.font_size && a.font_texture == b.font_texture &&
+           std::memcmp(&a.settings, &b.settings, sizeof(RenderSettings)) == 0;
+}
+
+void PCBRenderer::EmitScene(ImDrawList* draw_list, int window_width, int window_height) {
+    draw_list->_ResetForNewFrame();
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    draw_list->PushClipRect(ImVec2(0, 0), ImVec2(static_cast<float>(window_width), static_cast<float>(window_height)));
+
+    // Calculate screen transform from camera
+    float zoom = camera.zoom;
+    float offset_x = window_width * 0.5f - camera.x * zoom;
+    float offset_y = window_height * 0.5f + camera.y * zoom;  // Mirror Y-axis
+
+    // Visible world rectangle for this frame; the render passes query the culling grids with it
+    UpdateViewWorld(window_width, window_height);
+    BeginLodFrame(window_width, window_height);
+
+    // Use structured ImGui rendering methods (like original OpenBoardView)
     RenderOutlineImGui(draw_list, zoom, offset_x, offset_y);
+    RenderTracesImGui(draw_list, zoom, offset_x, offset_y);
     if (settings.show_part_outlines) {
         RenderPartOutlineImGui(draw_list, zoom, offset_x, offset_y);
     }
-    RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    if (pad_batch.IsReady()) {
+        // GPU pads, drawn by the backend at this point of the draw list so
+        // outlines stay underneath and overlays on top
+        if (pad_batch_dirty) {
+            std::vector<PadBatchRenderer::Instance> instances;
+            PadBatchRenderer::BuildInstances(*pcb_data, board_cx, board_cy, instances);
+            pad_batch.Upload(instances);
+            pad_batch_dirty = false;
+        }
+        UpdatePadFrame(window_width, window_height, zoom, offset_x, offset_y);
+        draw_list->AddCallback(&PCBRenderer::DrawPadBatchCallback, this);
+        draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+    } else {
+        RefreshPinColorClasses();
+        RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y);
+        RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y);
+        RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y);
+    }
 
     // Render ratsnet/airwires if enabled
     if (settings.show_ratsnet) {
         RenderRatsnetImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
     }
 
-    // Collect part names for rendering on top
-    CollectPartNamesForRendering(zoom, offset_x, offset_y);
+    // Place part names for rendering on top
+    CollectPartNamesForRendering(zoom, offset_x, offset_y, window_width, window_height);
 
     // Render part names on top of all other graphics
     RenderPartNamesOnTop(draw_list);
 
     // Render pin numbers as text overlays
-    RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y);
     
     // Render part highlighting on top of everything
     RenderPartHighlighting(draw_list, zoom, offset_x, offset_y);
 
-    ImGui::End();
+    draw_list->PopClipRect();
+    draw_list->PopTextureID();
+    draw_list->_PopUnusedDrawCmd();
 }
 
 void PCBRenderer::SetCamera(float x, float y, float zoom) {
@@ -308,62 +342,6 @@ float PCBRenderer::ComputeFitZoom(int window_width, int window_height) const {
     return z;
 }
 
-// Legacy OpenGL shader functions - kept for reference but not needed for ImGui rendering
-bool PCBRenderer::CreateShaderProgram() {
-    // Creating a minimal shader program to satisfy OpenGL initialization
-    GLuint vertex_shader = CompileShader(vertex_shader_source, GL_VERTEX_SHADER);
-    if (!vertex_shader) return false;
-    
-    GLuint fragment_shader = CompileShader(fragment_shader_source, GL_FRAGMENT_SHADER);
-    if (!fragment_shader) {
-        glDeleteShader(vertex_shader);
-        return false;
-    }
-
-    // Create program
-    shader_program = glCreateProgram();
-    glAttachShader(shader_program, vertex_shader);
-    glAttachShader(shader_program, fragment_shader);
-    glLinkProgram(shader_program);
-
-    // Check for linking errors
-    GLint success;
-    glGetProgramiv(shader_program, GL_LINK_STATUS, &success);
-    if (!success) {
-        char info_log[512];
-        glGetProgramInfoLog(shader_program, 512, nullptr, info_log);
-        LOG_ERROR("Shader program linking failed: " + std::string(info_log));
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-        return false;
-    }
-
-    // Delete shaders (they're linked into the program now)
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
-
-    return true;
-}
-
-GLuint PCBRenderer::CompileShader(const char* source, GLenum type) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    // Check for compilation errors
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char info_log[512];
-        glGetShaderInfoLog(shader, 512, nullptr, info_log);
-        LOG_ERROR("Shader compilation failed: " + std::string(info_log));
-        glDeleteShader(shader);
-        return 0;
-    }
-
-    return shader;
-}
-
 // void PCBRenderer::SetProjectionMatrix(int window_width, int window_height) {
 //     camera.aspect_ratio = static_cast<float>(window_width) / window_height;
     
@@ -459,8 +437,8 @@ GLuint PCBRenderer::CompileShader(const char* source, GLenum type) {
 //     float outline_margin = DeterminePinMargin(part, part_pins, distance);
 // }
 
-float PCBRenderer::DeterminePinMargin(const BRDPart& part, const std::vector<BRDPin>& part_pins, float distance) {
-    int pin_count = part_pins.size();
+float PCBRenderer::DeterminePinMargin(const BRDPart& part, size_t part_pin_count, float distance) {
+    int pin_count = static_cast<int>(part_pin_count);
       // Enhanced component type detection based on OpenBoardView logic - REDUCED MARGINS
     if (pin_count < 4 && !part.name.empty() && part.name[0] != 'U' && part.name[0] != 'Q') {
         // 2-3 pin components - likely passives (reduced margins by ~30-40%)
@@ -668,7 +646,7 @@ float PCBRenderer::DeterminePinSize(const BRDPart& part, const std::vector<BRDPi
 // }
 
 void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
-    if (!pcb_data || pcb_data->outline_segments.empty()) {
+    if (!pcb_data || (pcb_data->outline_segments.empty() && pcb_data->outline_arcs.empty())) {
         LOG_INFO("No outline segments to render");
         return;
     }    // Render board outline
@@ -684,7 +662,9 @@ void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float of
     // Adaptive line thickness based on zoom level
     float line_thickness = std::max(1.0f, std::min(4.0f, zoom * 2.0f));  // Thicker when zoomed in
      
-    for (const auto& segment : pcb_data->outline_segments) {
+    outline_grid.Query(view_world, visible_items);
+    for (uint32_t segment_idx : visible_items) {
+        const auto& segment = pcb_data->outline_segments[segment_idx];
         // Apply global rotation first
         float x1 = segment.first.x, y1 = segment.first.y;
         float x2 = segment.second.x, y2 = segment.second.y;
@@ -696,10 +676,96 @@ void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float of
         // Draw outline segment
         draw_list->AddLine(p1, p2, outline_color, line_thickness);
     }
+
+    outline_arc_tess.SetZoom(zoom);
+    outline_arc_grid.Query(view_world, visible_items);
+    for (uint32_t arc_idx : visible_items) {
+        DrawArc(draw_list, outline_arc_tess, pcb_data->outline_arcs[arc_idx], arc_idx, zoom, offset_x, offset_y, outline_color, line_thickness);
+    }
     
     // Outline rendering complete
 }
 
+void PCBRenderer::RenderTracesImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
+    if (!pcb_data || pcb_data->trace_layers.empty() || trace_grids.size() != pcb_data->trace_layers.size() ||
+        trace_arc_grids.size() != pcb_data->trace_layers.size()) {
+        return;
+    }
+
+    ImU32 trace_color = IM_COL32(
+        static_cast<int>(settings.trace_color.r * 255),
+        static_cast<int>(settings.trace_color.g * 255),
+        static_cast<int>(settings.trace_color.b * 255),
+        static_cast<int>(settings.trace_alpha * 255)
+    );
+    ImU32 same_net_color = IM_COL32(
+        static_cast<int>(settings.pin_same_net_color.r * 255),
+        static_cast<int>(settings.pin_same_net_color.g * 255),
+        static_cast<int>(settings.pin_same_net_color.b * 255),
+        255
+    );
+    auto draw = [&](const BRDTrace& trace, ImU32 color) {
+        float x1 = static_cast<float>(trace.a.x), y1 = static_cast<float>(trace.a.y);
+        float x2 = static_cast<float>(trace.b.x), y2 = static_cast<float>(trace.b.y);
+        ApplyRotation(x1, y1, false);
+        ApplyRotation(x2, y2, false);
+        draw_list->AddLine(ImVec2(x1 * zoom + offset_x, offset_y - y1 * zoom), ImVec2(x2 * zoom + offset_x, offset_y - y2 * zoom),
+                           color, std::max(1.0f, trace.width * zoom));
+    };
+
+    // Net match by trace net slot: one integer compare per segment
+    const uint32_t highlight_net = HighlightNetId();
+    const auto& trace_net_ids = pcb_data->trace_net_ids;
+    auto highlighted = [&](uint32_t net) {
+        return highlight_net != StringPool::kInvalid && net < trace_net_ids.size() && trace_net_ids[net] == highlight_net;
+    };
+    highlighted_traces.clear();
+    highlighted_arcs.clear();
+    for (size_t l = 0; l < pcb_data->trace_layers.size(); ++l) {
+        if (layer_filter > 0 && static_cast<size_t>(layer_filter) != l + 1) continue;
+        const auto& layer = pcb_data->trace_layers[l];
+        trace_grids[l].Query(view_world, visible_items);
+        for (uint32_t segment_idx : visible_items) {
+            const BRDTrace& trace = layer.segments[segment_idx];
+            if (highlighted(trace.net)) {
+                highlighted_traces.push_back(&trace);
+                continue;
+            }
+            draw(trace, trace_color);
+        }
+        trace_arc_tess[l].SetZoom(zoom);
+        trace_arc_grids[l].Query(view_world, visible_items);
+        for (uint32_t arc_idx : visible_items) {
+            const BRDArc& arc = layer.arcs[arc_idx];
+            if (highlighted(arc.net)) {
+                highlighted_arcs.emplace_back(static_cast<uint32_t>(l), arc_idx);
+                continue;
+            }
+            DrawArc(draw_list, trace_arc_tess[l], arc, arc_idx, zoom, offset_x, offset_y, trace_color, std::max(1.0f, arc.width * zoom));
+        }
+    }
+    // The selected net stays visible over traces of other layers
+    for (const BRDTrace* trace : highlighted_traces) draw(*trace, same_net_color);
+    for (const auto& ref : highlighted_arcs) {
+        const BRDArc& arc = pcb_data->trace_layers[ref.first].arcs[ref.second];
+        DrawArc(draw_list, trace_arc_tess[ref.first], arc, ref.second, zoom, offset_x, offset_y, same_net_color, std::max(1.0f, arc.width * zoom));
+    }
+}
+
+void PCBRenderer::DrawArc(ImDrawList* draw_list, ArcTessellator& tess, const BRDArc& arc, size_t index,
+                          float zoom, float offset_x, float offset_y, ImU32 color, float thickness) {
+    uint32_t count = 0;
+    const ArcTessellator::Point* points = tess.Polyline(arc, index, count);
+    if (count < 2) return;
+    arc_screen_points.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        float x = points[i].x, y = points[i].y;
+        ApplyRotation(x, y, false);
+        arc_screen_points[i] = ImVec2(x * zoom + offset_x, offset_y - y * zoom);
+    }
+    draw_list->AddPolyline(arc_screen_points.data(), static_cast<int>(count), color, ImDrawFlags_None, thickness);
+}
+
 void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     if (!pcb_data || pcb_data->part_outline_segments.empty()) {
         return;
@@ -718,16 +784,35 @@ void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, floa
     // Adaptive line thickness based on zoom level (slightly thinner than board outline)
     float line_thickness = std::max(0.5f, std::min(2.0f, zoom * 1.5f));
     
-    for (const auto& segment : pcb_data->part_outline_segments) {
-        float x1 = segment.first.x, y1 = segment.first.y;
-        float x2 = segment.second.x, y2 = segment.second.y;
-        ApplyRotation(x1, y1, false);
-        ApplyRotation(x2, y2, false);
-        ImVec2 p1(x1 * zoom + offset_x, offset_y - y1 * zoom);
-        ImVec2 p2(x2 * zoom + offset_x, offset_y - y2 * zoom);
-        
-        // Draw part outline segment
-        draw_list->AddLine(p1, p2, part_outline_color, line_thickness);
+    part_outline_grid.Query(view_world, visible_items);
+    for (uint32_t group_idx : visible_items) {
+        const OutlineGroup& group = part_outline_groups[group_idx];
+
+        // LOD: a part too small to read is drawn as its bounding box
+        const SpatialGrid::Box& bounds = group.bounds;
+        if (std::max(bounds.max_x - bounds.min_x, bounds.max_y - bounds.min_y) * zoom < settings.lod_part_box_px) {
+            float x1 = bounds.min_x, y1 = bounds.min_y;
+            float x2 = bounds.max_x, y2 = bounds.max_y;
+            ApplyRotation(x1, y1, false);
+            ApplyRotation(x2, y2, false);
+            ImVec2 p1(std::min(x1, x2) * zoom + offset_x, offset_y - std::max(y1, y2) * zoom);
+            ImVec2 p2(std::max(x1, x2) * zoom + offset_x, offset_y - std::min(y1, y2) * zoom);
+            draw_list->AddRect(p1, p2, part_outline_color, 0.0f, 0, line_thickness);
+            continue;
+        }
+
+        for (uint32_t segment_idx = group.first; segment_idx < group.last; ++segment_idx) {
+            const auto& segment = pcb_data->part_outline_segments[segment_idx];
+            float x1 = segment.first.x, y1 = segment.first.y;
+            float x2 = segment.second.x, y2 = segment.second.y;
+            ApplyRotation(x1, y1, false);
+            ApplyRotation(x2, y2, false);
+            ImVec2 p1(x1 * zoom + offset_x, offset_y - y1 * zoom);
+            ImVec2 p2(x2 * zoom + offset_x, offset_y - y2 * zoom);
+            
+            // Draw part outline segment
+            draw_list->AddLine(p1, p2, part_outline_color, line_thickness);
+        }
     }
     
     // Part outline rendering complete
@@ -744,101 +829,22 @@ void PCBRenderer::RenderPartHighlighting(ImDrawList* draw_list, float zoom, floa
     if (highlighted_part_index >= 0) {
         parts_to_highlight.insert(static_cast<unsigned int>(highlighted_part_index + 1)); // pins store 1-based part ids
     } else {
-        std::string net_to_use;
-        if (!highlighted_net.empty()) {
-            net_to_use = highlighted_net;
-        } else if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-            net_to_use = pcb_data->pins[selected_pin_index].net;
-        }
-        if (!net_to_use.empty() && net_to_use != "UNCONNECTED") {
-            for (const auto& pin : pcb_data->pins) {
-                if (pin.net == net_to_use && pin.part > 0) parts_to_highlight.insert(pin.part);
+        uint32_t net_id = ActiveNetId();
+        if (net_id != StringPool::kInvalid && !(pcb_data->NetFlagsOf(net_id) & BRDFileBase::kNetUnconnected)) {
+            const auto& pin_parts = pcb_data->pin_columns.part;
+            for (uint32_t pin_idx : pcb_data->PinsOnNet(net_id)) {
+                if (pin_parts[pin_idx] > 0) parts_to_highlight.insert(pin_parts[pin_idx]);
             }
         }
     }
 
     if (parts_to_highlight.empty()) return;
 
-    struct PinExtent { BRDPoint pos; float left, right, bottom, top; };
-
     for (unsigned int part_id : parts_to_highlight) {
-        std::vector<PinExtent> extents;
-        extents.reserve(32);
-        for (const auto& pin : pcb_data->pins) {
-            if (pin.part != part_id) continue;
-            PinExtent pe{ pin.pos, 5.f, 5.f, 5.f, 5.f }; // default
-            bool found = false;
-            // Circle
-            for (const auto& c : pcb_data->circles) {
-                if (c.center.x == pin.pos.x && c.center.y == pin.pos.y) {
-                    float r = std::max(5.f, c.radius);
-                    pe.left = pe.right = pe.bottom = pe.top = r;
-                    found = true; break;
-                }
-            }
-            // Rectangle
-            if (!found) {
-                for (const auto& rect : pcb_data->rectangles) {
-                    if (rect.center.x == pin.pos.x && rect.center.y == pin.pos.y) {
-                        float hw = rect.width * 0.5f;
-                        float hh = rect.height * 0.5f;
-                        if (rect.rotation == 0.f) {
-                            pe.left = pe.right = hw; pe.bottom = pe.top = hh;
-                        } else {
-                            float rot = rect.rotation * 3.14159265f / 180.f;
-                            float c = std::abs(std::cos(rot));
-                            float s = std::abs(std::sin(rot));
-                            float ex = hw * c + hh * s;
-                            float ey = hw * s + hh * c;
-                            pe.left = pe.right = ex; pe.bottom = pe.top = ey;
-                        }
-                        found = true; break;
-                    }
-                }
-            }
-            // Oval
-            if (!found) {
-                for (const auto& ov : pcb_data->ovals) {
-                    if (ov.center.x == pin.pos.x && ov.center.y == pin.pos.y) {
-                        float hw = ov.width * 0.5f;
-                        float hh = ov.height * 0.5f;
-                        if (ov.rotation == 0.f) {
-                            pe.left = pe.right = hw; pe.bottom = pe.top = hh;
-                        } else {
-                            float rot = ov.rotation * 3.14159265f / 180.f;
-                            float c = std::abs(std::cos(rot));
-                            float s = std::abs(std::sin(rot));
-                            float ex = hw * c + hh * s;
-                            float ey = hw * s + hh * c;
-                            pe.left = pe.right = ex; pe.bottom = pe.top = ey;
-                        }
-                        break; // found geometry
-                    }
-                }
-            }
-            extents.push_back(pe);
-        }
-
-        if (extents.empty()) continue;
-
-        float min_x = extents[0].pos.x, max_x = extents[0].pos.x;
-        float min_y = extents[0].pos.y, max_y = extents[0].pos.y;
-        for (const auto& e : extents) {
-            min_x = std::min(min_x, (float)e.pos.x);
-            max_x = std::max(max_x, (float)e.pos.x);
-            min_y = std::min(min_y, (float)e.pos.y);
-            max_y = std::max(max_y, (float)e.pos.y);
-        }
-
-        float left_margin = 0.f, right_margin = 0.f, bottom_margin = 0.f, top_margin = 0.f;
-        for (const auto& e : extents) {
-            if (e.pos.x == min_x) left_margin = std::max(left_margin, e.left);
-            if (e.pos.x == max_x) right_margin = std::max(right_margin, e.right);
-            if (e.pos.y == min_y) bottom_margin = std::max(bottom_margin, e.bottom);
-            if (e.pos.y == max_y) top_margin = std::max(top_margin, e.top);
-        }
-
-        min_x -= left_margin; max_x += right_margin; min_y -= bottom_margin; max_y += top_margin;
+        // Pad-aware part bounds are precomputed per part
+        if (part_id < 1 || part_id > part_extents.size() || !part_extents[part_id - 1].valid) continue;
+        const PartExtent& extent = part_extents[part_id - 1];
+        float min_x = extent.min_x, max_x = extent.max_x, min_y = extent.min_y, max_y = extent.max_y;
 
         float tlx = min_x, tly = max_y; // note Y inversion later
         float brx = max_x, bry = min_y;
@@ -879,26 +885,21 @@ void PCBRenderer::RenderRatsnetImGui(ImDrawList* draw_list, float zoom, float of
     }
     
     const auto& selected_pin = pcb_data->pins[selected_pin_index];
-    std::string target_net = selected_pin.net;
+    if (selected_pin_index >= (int)pcb_data->pin_columns.size()) {
+        return;
+    }
+    uint32_t target_net = pcb_data->pin_columns.net[selected_pin_index];
     
     // If the selected pin has no valid net, don't show ratsnet
-    if (target_net.empty() || target_net == "UNCONNECTED" || target_net == "NC") {
+    if ((pcb_data->NetFlagsOf(target_net) & BRDFileBase::kNetUnconnected) || pcb_data->NetName(target_net) == "NC") {
         return;
     }
 
-    // Build a list of pins for the target net (excluding the selected pin itself)
-    std::vector<size_t> connected_pin_indices;
-    for (size_t i = 0; i < pcb_data->pins.size(); ++i) {
-        if ((int)i == selected_pin_index) continue; // Skip the selected pin itself
-        
-        const auto& pin = pcb_data->pins[i];
-        if (pin.net == target_net) {
-            connected_pin_indices.push_back(i);
-        }
-    }
+    // Pins on the target net (the selected pin itself is skipped below)
+    IndexRange connected_pin_indices = pcb_data->PinsOnNet(target_net);
 
     // Need at least 1 other pin to draw connections from the selected pin
-    if (connected_pin_indices.empty()) {
+    if (connected_pin_indices.size() < 2) {
         return;
     }
 
@@ -921,7 +922,8 @@ void PCBRenderer::RenderRatsnetImGui(ImDrawList* draw_list, float zoom, float of
     ImVec2 selected_screen(selected_x * zoom + offset_x, offset_y - selected_y * zoom);
     
     // Connect the selected pin to all other pins in the same net
-    for (size_t pin_idx : connected_pin_indices) {
+    for (uint32_t pin_idx : connected_pin_indices) {
+        if ((int)pin_idx == selected_pin_index) continue;
         const auto& pin = pcb_data->pins[pin_idx];
         
         // Transform pin position
@@ -953,30 +955,18 @@ void PCBRenderer::RenderRatsnetImGui(ImDrawList* draw_list, float zoom, float of
     }
 }
 
-void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     if (!pcb_data || pcb_data->circles.empty() || pin_geometry_cache.empty()) {
         return;
     }
     
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (!highlighted_net.empty()) {
-        selected_net = highlighted_net; // external highlight overrides
-    } else if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
-    }
-    // Do not highlight ground nets
-    if (IsGroundNet(selected_net)) selected_net.clear();
+    const auto& shape_pins = pcb_data->pad_links.circle_pin;
     
-    // Render all circles with optimized visibility culling
-    for (size_t circle_idx = 0; circle_idx < pcb_data->circles.size(); ++circle_idx) {
+    // Render only the circles whose tiles overlap the view
+    circle_grid.Query(view_world, visible_items);
+    for (uint32_t circle_idx : visible_items) {
         const auto& circle = pcb_data->circles[circle_idx];
         
-        // Early visibility culling - skip if circle is outside visible area
-        if (!IsElementVisible(circle.center.x, circle.center.y, circle.radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
-        }
-        
     // Apply global rotation to circle center
     float wx = circle.center.x, wy = circle.center.y;
     ApplyRotation(wx, wy, false);
@@ -992,30 +982,7 @@ void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float
     // Check if this circle corresponds to a pin with cached data for color override
     float r = circle.r, g = circle.g, b = circle.b, a = circle.a;
         
-        // Find pin that matches this circle using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
-            
-            // Quick check using cached geometry index
-            if (cache.circle_index == circle_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    // Highlight all pins on the same net
-                    r = settings.pin_same_net_color.r; g = settings.pin_same_net_color.g; b = settings.pin_same_net_color.b; a = 1.0f;
-                } else if (cache.is_nc) {
-                    // NC pins
-                    r = settings.pin_nc_color.r; g = settings.pin_nc_color.g; b = settings.pin_nc_color.b; a = 1.0f;
-                } else if (cache.is_ground) {
-                    // Ground pins
-                    r = settings.pin_ground_color.r; g = settings.pin_ground_color.g; b = settings.pin_ground_color.b; a = 1.0f;
-                } else if (settings.override_pin_colors) {
-                    // Theme default pin color
-                    r = settings.pin_color.r; g = settings.pin_color.g; b = settings.pin_color.b; a = settings.pin_alpha;
-                }
-                break;
-            }
-        }
+        if (circle_idx < shape_pins.size()) ApplyPinColorClass(shape_pins[circle_idx], r, g, b, a);
         
         // Convert color components to ImU32 format (0-255 range)
         ImU32 fill_color = IM_COL32(
@@ -1025,45 +992,40 @@ void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float
             (int)(a * 255)
         );
         
+        // LOD: sub-threshold pads become dots
+        if (radius * 2.0f < settings.lod_pad_point_px) {
+            DrawPadDot(draw_list, x, y, radius * 2.0f, fill_color);
+            continue;
+        }
+        
         // Draw filled circle
         draw_list->AddCircleFilled(ImVec2(x, y), radius, fill_color);
         
         // Optional: Add a darker outline for better visibility
-        ImU32 outline_color = IM_COL32(
-            (int)(r * 180), 
-            (int)(g * 180), 
-            (int)(b * 180), 
-            255
-        );
-        draw_list->AddCircle(ImVec2(x, y), radius, outline_color, 0, 1.0f);
+        if (radius * 2.0f >= settings.lod_pad_outline_px) {
+            ImU32 outline_color = IM_COL32(
+                (int)(r * 180), 
+                (int)(g * 180), 
+                (int)(b * 180), 
+                255
+            );
+            draw_list->AddCircle(ImVec2(x, y), radius, outline_color, 0, 1.0f);
+        }
     }
 }
 
-void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     if (!pcb_data || pcb_data->rectangles.empty() || pin_geometry_cache.empty()) {
         return;
     }
     
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (!highlighted_net.empty()) {
-        selected_net = highlighted_net;
-    } else if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
-    }
-    // Do not highlight ground nets
-    if (IsGroundNet(selected_net)) selected_net.clear();
+    const auto& shape_pins = pcb_data->pad_links.rectangle_pin;
     
-    // Render all rectangles with optimized visibility culling
-    for (size_t rect_idx = 0; rect_idx < pcb_data->rectangles.size(); ++rect_idx) {
+    // Render only the rectangles whose tiles overlap the view
+    rectangle_grid.Query(view_world, visible_items);
+    for (uint32_t rect_idx : visible_items) {
         const auto& rectangle = pcb_data->rectangles[rect_idx];
         
-        // Early visibility culling using approximate radius
-        float approx_radius = std::max(rectangle.width, rectangle.height) * 0.5f;
-        if (!IsElementVisible(rectangle.center.x, rectangle.center.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
-        }
-        
     // Scale dimensions by zoom factor (store original half sizes in world units first)
     float half_width_world = rectangle.width * 0.5f;
     float half_height_world = rectangle.height * 0.5f;
@@ -1073,26 +1035,7 @@ void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, fl
     // Check if this rectangle corresponds to a pin with cached data for color override
     float r = rectangle.r, g = rectangle.g, b = rectangle.b, a = rectangle.a;
         
-        // Find pin that matches this rectangle using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
-            
-            // Quick check using cached geometry index
-            if (cache.rectangle_index == rect_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    r = settings.pin_same_net_color.r; g = settings.pin_same_net_color.g; b = settings.pin_same_net_color.b; a = 1.0f;
-                } else if (cache.is_nc) {
-                    r = settings.pin_nc_color.r; g = settings.pin_nc_color.g; b = settings.pin_nc_color.b; a = 1.0f;
-                } else if (cache.is_ground) {
-                    r = settings.pin_ground_color.r; g = settings.pin_ground_color.g; b = settings.pin_ground_color.b; a = 1.0f;
-                } else if (settings.override_pin_colors) {
-                    r = settings.pin_color.r; g = settings.pin_color.g; b = settings.pin_color.b; a = settings.pin_alpha;
-                }
-                break;
-            }
-        }
+        if (rect_idx < shape_pins.size()) ApplyPinColorClass(shape_pins[rect_idx], r, g, b, a);
         
         // Convert color components to ImU32 format (0-255 range)
         ImU32 fill_color = IM_COL32(
@@ -1102,6 +1045,15 @@ void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, fl
             (int)(a * 255)
         );
         
+        // LOD: sub-threshold pads become dots
+        float pad_px = std::max(rectangle.width, rectangle.height) * zoom;
+        if (pad_px < settings.lod_pad_point_px) {
+            float cx = rectangle.center.x, cy = rectangle.center.y;
+            ApplyRotation(cx, cy, false);
+            DrawPadDot(draw_list, cx * zoom + offset_x, offset_y - cy * zoom, pad_px, fill_color);
+            continue;
+        }
+        
         // Compute rectangle corner world coordinates first (applying its own rotation), then apply global board rotation per corner
         float rot_rad = rectangle.rotation * 3.14159265f / 180.0f;
         float cos_rot = std::cos(rot_rad);
@@ -1151,36 +1103,25 @@ void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, fl
         draw_list->AddQuadFilled(corners[0], corners[1], corners[2], corners[3], fill_color);
 
         // Outline
-    ImU32 outline_color = IM_COL32((int)(r * 180),(int)(g * 180),(int)(b * 180),255);
-        draw_list->AddQuad(corners[0], corners[1], corners[2], corners[3], outline_color, 1.0f);
+        if (pad_px >= settings.lod_pad_outline_px) {
+            ImU32 outline_color = IM_COL32((int)(r * 180),(int)(g * 180),(int)(b * 180),255);
+            draw_list->AddQuad(corners[0], corners[1], corners[2], corners[3], outline_color, 1.0f);
+        }
     }
 }
 
-void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     if (!pcb_data || pcb_data->ovals.empty() || pin_geometry_cache.empty()) {
         return;
     }
     
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (!highlighted_net.empty()) {
-        selected_net = highlighted_net;
-    } else if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
-    }
-    // Do not highlight ground nets
-    if (IsGroundNet(selected_net)) selected_net.clear();
+    const auto& shape_pins = pcb_data->pad_links.oval_pin;
     
-    // Render all ovals as stadium shapes (rounded rectangles) with optimized visibility culling
-    for (size_t oval_idx = 0; oval_idx < pcb_data->ovals.size(); ++oval_idx) {
+    // Render only the ovals (stadium shapes) whose tiles overlap the view
+    oval_grid.Query(view_world, visible_items);
+    for (uint32_t oval_idx : visible_items) {
         const auto& oval = pcb_data->ovals[oval_idx];
         
-        // Early visibility culling using approximate radius
-        float approx_radius = std::max(oval.width, oval.height) * 0.5f;
-        if (!IsElementVisible(oval.center.x, oval.center.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
-        }
-        
     // Precompute world half dimensions for local shape generation
     float half_w_world = oval.width * 0.5f;
     float half_h_world = oval.height * 0.5f;
@@ -1188,25 +1129,16 @@ void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float o
     // Check if this oval corresponds to a pin with cached data for color override
     float r = oval.r, g = oval.g, b = oval.b, a = oval.a;
         
-        // Find pin that matches this oval using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
-            
-            // Quick check using cached geometry index
-            if (cache.oval_index == oval_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    r = settings.pin_same_net_color.r; g = settings.pin_same_net_color.g; b = settings.pin_same_net_color.b; a = 1.0f;
-                } else if (cache.is_nc) {
-                    r = settings.pin_nc_color.r; g = settings.pin_nc_color.g; b = settings.pin_nc_color.b; a = 1.0f;
-                } else if (cache.is_ground) {
-                    r = settings.pin_ground_color.r; g = settings.pin_ground_color.g; b = settings.pin_ground_color.b; a = 1.0f;
-                } else if (settings.override_pin_colors) {
-                    r = settings.pin_color.r; g = settings.pin_color.g; b = settings.pin_color.b; a = settings.pin_alpha;
-                }
-                break;
-            }
+        if (oval_idx < shape_pins.size()) ApplyPinColorClass(shape_pins[oval_idx], r, g, b, a);
+        ImU32 fill_color = IM_COL32((int)(r * 255),(int)(g * 255),(int)(b * 255),(int)(a * 255));
+        
+        // LOD: sub-threshold pads become dots, skipping arc tessellation
+        float pad_px = std::max(oval.width, oval.height) * zoom;
+        if (pad_px < settings.lod_pad_point_px) {
+            float cx = oval.center.x, cy = oval.center.y;
+            ApplyRotation(cx, cy, false);
+            DrawPadDot(draw_list, cx * zoom + offset_x, offset_y - cy * zoom, pad_px, fill_color);
+            continue;
         }
         
         // Pin local rotation
@@ -1270,10 +1202,11 @@ void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float o
         }
 
         if (pts.size() >= 3) {
-            ImU32 fill_color = IM_COL32((int)(r * 255),(int)(g * 255),(int)(b * 255),(int)(a * 255));
             draw_list->AddConvexPolyFilled(pts.data(), (int)pts.size(), fill_color);
-            ImU32 outline_color = IM_COL32((int)(r * 180),(int)(g * 180),(int)(b * 180),255);
-            draw_list->AddPolyline(pts.data(), (int)pts.size(), outline_color, ImDrawFlags_Closed, 1.0f);
+            if (pad_px >= settings.lod_pad_outline_px) {
+                ImU32 outline_color = IM_COL32((int)(r * 180),(int)(g * 180),(int)(b * 180),255);
+                draw_list->AddPolyline(pts.data(), (int)pts.size(), outline_color, ImDrawFlags_Closed, 1.0f);
+            }
         }
     }
 }
@@ -1285,6 +1218,8 @@ void PCBRenderer::SetColorTheme(ColorTheme theme) {
     settings.background_color = {0.0f, 0.0f, 0.0f};
     settings.outline_color    = {1.0f, 1.0f, 1.0f};
     settings.part_outline_color = {1.0f, 1.0f, 1.0f};
+    settings.trace_color = {0.72f, 0.45f, 0.2f};
+    settings.trace_alpha = 0.7f;
     settings.pin_color = {1.0f, 1.0f, 0.0f}; // default accent yellow
     settings.pin_same_net_color = {1.0f, 1.0f, 0.0f};
     settings.pin_nc_color = {0.0f, 0.3f, 0.3f};
@@ -1306,6 +1241,7 @@ void PCBRenderer::SetColorTheme(ColorTheme theme) {
         settings.background_color = {0.95f, 0.95f, 0.95f};
         settings.outline_color    = {0.1f, 0.1f, 0.1f};
         settings.part_outline_color = {0.2f, 0.2f, 0.2f};
+        settings.trace_color = {0.8f, 0.5f, 0.25f};
     settings.pin_color = {0.0f, 0.45f, 0.85f}; // blue-ish default pin
         settings.pin_same_net_color = {0.0f, 0.45f, 0.85f}; // blue
         settings.pin_nc_color = {0.6f, 0.6f, 0.6f};
@@ -1325,6 +1261,8 @@ void PCBRenderer::SetColorTheme(ColorTheme theme) {
         settings.background_color = {0.0f, 0.0f, 0.0f};
         settings.outline_color    = {1.0f, 1.0f, 1.0f};
         settings.part_outline_color = {1.0f, 1.0f, 1.0f};
+        settings.trace_color = {1.0f, 0.55f, 0.0f};
+        settings.trace_alpha = 0.9f;
     settings.pin_color = {1.0f, 1.0f, 0.0f}; // bright yellow
         settings.pin_same_net_color = {1.0f, 1.0f, 0.0f}; // yellow
         settings.pin_nc_color = {0.0f, 1.0f, 1.0f}; // cyan
@@ -1382,55 +1320,75 @@ void PCBRenderer::ApplyTheme(const PCBThemeSpec& spec, bool setBaseFromSpec) {
 }
 
 bool PCBRenderer::IsGroundPin(const BRDPin& pin) {
-    // Check if pin is a ground pin based on net name
-    if (pin.net.empty()) return false;
-    
-    std::string net_upper = pin.net;
-    // Convert to uppercase for case-insensitive comparison
-    std::transform(net_upper.begin(), net_upper.end(), net_upper.begin(), ::toupper);
-    
-    // Common ground net names
-    return (net_upper == "GND" || 
-            net_upper == "GROUND" || 
-            net_upper == "VSS" || 
-            net_upper == "AGND" || 
-            net_upper == "DGND" || 
-            net_upper == "PGND" || 
-            net_upper == "SGND" || 
-            net_upper.find("GND") == 0 ||  // Starts with GND (GND1, GND2, etc.)
-            net_upper.find("GROUND") == 0); // Starts with GROUND
+    return BRDFileBase::IsGroundNetName(pcb_data->PinNet(pin));
 }
 
 bool PCBRenderer::IsGroundNet(const std::string& net) const {
-    if (net.empty()) return false;
-    std::string upper = net;
-    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
-    return (upper == "GND" ||
-            upper == "GROUND" ||
-            upper == "VSS" ||
-            upper == "AGND" ||
-            upper == "DGND" ||
-            upper == "PGND" ||
-            upper == "SGND" ||
-            upper.rfind("GND", 0) == 0 ||
-            upper.rfind("GROUND", 0) == 0);
+    return BRDFileBase::IsGroundNetName(net);
+}
+
+uint32_t PCBRenderer::ActiveNetId() const {
+    if (!pcb_data) return StringPool::kInvalid;
+    if (!highlighted_net.empty()) return pcb_data->FindNetId(highlighted_net); // external highlight overrides
+    if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pin_columns.size()) {
+        return pcb_data->pin_columns.net[selected_pin_index];
+    }
+    return StringPool::kInvalid;
+}
+
+uint32_t PCBRenderer::HighlightNetId() const {
+    uint32_t net_id = ActiveNetId();
+    if (net_id == StringPool::kInvalid) return net_id;
+    // Do not highlight unnamed or ground nets
+    if (pcb_data->NetName(net_id).empty() || (pcb_data->NetFlagsOf(net_id) & BRDFileBase::kNetGround)) return StringPool::kInvalid;
+    return net_id;
+}
+
+void PCBRenderer::RefreshPinColorClasses() {
+    if (!pcb_data || pin_color_class.size() != pcb_data->pins.size()) return;
+    uint32_t net_id = HighlightNetId();
+    if (net_id == pin_color_class_net) return;
+
+    // Return the previous net's pins to their base class, then mark the new net
+    if (pin_color_class_net != StringPool::kInvalid) {
+        for (uint32_t pin_idx : pcb_data->PinsOnNet(pin_color_class_net)) {
+            const auto& cache = pin_geometry_cache[pin_idx];
+            pin_color_class[pin_idx] = cache.is_nc ? PinColorClass::NoConnect
+                                     : cache.is_ground ? PinColorClass::Ground : PinColorClass::Default;
+        }
+    }
+    if (net_id != StringPool::kInvalid) {
+        for (uint32_t pin_idx : pcb_data->PinsOnNet(net_id)) {
+            pin_color_class[pin_idx] = PinColorClass::SameNet;
+        }
+    }
+    pin_color_class_net = net_id;
+}
+
+void PCBRenderer::ApplyPinColorClass(uint32_t pin_idx, float& r, float& g, float& b, float& a) const {
+    if (pin_idx >= pin_color_class.size()) return;
+    switch (pin_color_class[pin_idx]) {
+        case PinColorClass::SameNet:
+            // Highlight all pins on the same net
+            r = settings.pin_same_net_color.r; g = settings.pin_same_net_color.g; b = settings.pin_same_net_color.b; a = 1.0f;
+            break;
+        case PinColorClass::NoConnect:
+            r = settings.pin_nc_color.r; g = settings.pin_nc_color.g; b = settings.pin_nc_color.b; a = 1.0f;
+            break;
+        case PinColorClass::Ground:
+            r = settings.pin_ground_color.r; g = settings.pin_ground_color.g; b = settings.pin_ground_color.b; a = 1.0f;
+            break;
+        case PinColorClass::Default:
+            // Theme default pin color
+            if (settings.override_pin_colors) {
+                r = settings.pin_color.r; g = settings.pin_color.g; b = settings.pin_color.b; a = settings.pin_alpha;
+            }
+            break;
+    }
 }
 
 bool PCBRenderer::IsNCPin(const BRDPin& pin) {
-    // Check if pin is a No Connect (NC) pin based on net name
-    if (pin.net.empty()) return false;
-    
-    std::string net_upper = pin.net;
-    // Convert to uppercase for case-insensitive comparison
-    std::transform(net_upper.begin(), net_upper.end(), net_upper.begin(), ::toupper);
-    
-    // Check for NC (No Connect) net names
-    return (net_upper == "NC" || 
-            net_upper == "NO_CONNECT" || 
-            net_upper == "NOCONNECT" ||
-            net_upper == "N/C" ||
-            net_upper == "N.C." ||
-            net_upper.find("NC") == 0);  // Starts with NC (NC1, NC2, etc.)
+    return BRDFileBase::IsNoConnectNetName(pcb_data->PinNet(pin));
 }
 
 // Performance optimization methods
@@ -1439,6 +1397,8 @@ void PCBRenderer::BuildPinGeometryCache() {
     
     pin_geometry_cache.clear();
     pin_geometry_cache.resize(pcb_data->pins.size());
+    pin_color_class.assign(pcb_data->pins.size(), PinColorClass::Default);
+    pin_color_class_net = StringPool::kInvalid;
     
     LOG_INFO("Building pin geometry cache for " + std::to_string(pcb_data->pins.size()) + " pins");
     
@@ -1446,45 +1406,31 @@ void PCBRenderer::BuildPinGeometryCache() {
         const auto& pin = pcb_data->pins[pin_idx];
         auto& cache = pin_geometry_cache[pin_idx];
         
-        // Pre-compute pin type checks
-        cache.is_ground = IsGroundPin(pin);
-        cache.is_nc = IsNCPin(pin);
-        
-        // Find geometry for this pin
-        bool found_geometry = false;
-        
-        // Check circles
-        for (size_t circle_idx = 0; circle_idx < pcb_data->circles.size(); ++circle_idx) {
-            const auto& circle = pcb_data->circles[circle_idx];
-            if (circle.center.x == pin.pos.x && circle.center.y == pin.pos.y) {
-                cache.circle_index = circle_idx;
-                cache.radius = circle.radius;
-                found_geometry = true;
-                break;
-            }
-        }
-        
-        // Check rectangles if no circle found
-        if (!found_geometry) {
-            for (size_t rect_idx = 0; rect_idx < pcb_data->rectangles.size(); ++rect_idx) {
-                const auto& rect = pcb_data->rectangles[rect_idx];
-                if (rect.center.x == pin.pos.x && rect.center.y == pin.pos.y) {
-                    cache.rectangle_index = rect_idx;
-                    found_geometry = true;
+        // Pin type checks come from the per-net classification
+        uint8_t net_flags = pin_idx < pcb_data->pin_columns.size() ? pcb_data->NetFlagsOf(pcb_data->pin_columns.net[pin_idx]) : 0;
+        cache.is_ground = (net_flags & BRDFileBase::kNetGround) != 0;
+        cache.is_nc = (net_flags & BRDFileBase::kNetNoConnect) != 0;
+        if (cache.is_nc) pin_color_class[pin_idx] = PinColorClass::NoConnect;
+        else if (cache.is_ground) pin_color_class[pin_idx] = PinColorClass::Ground;
+        
+        // Pad geometry comes from the pin<->shape links resolved at load time
+        const auto& links = pcb_data->pad_links;
+        bool found_geometry = pin_idx < links.pin_shape.size() && links.pin_shape[pin_idx] != BRDFileBase::PadShape::None;
+        if (found_geometry) {
+            size_t shape_idx = links.pin_shape_index[pin_idx];
+            switch (links.pin_shape[pin_idx]) {
+                case BRDFileBase::PadShape::Circle:
+                    cache.circle_index = shape_idx;
+                    cache.radius = pcb_data->circles[shape_idx].radius;
                     break;
-                }
-            }
-        }
-        
-        // Check ovals if no other geometry found
-        if (!found_geometry) {
-            for (size_t oval_idx = 0; oval_idx < pcb_data->ovals.size(); ++oval_idx) {
-                const auto& oval = pcb_data->ovals[oval_idx];
-                if (oval.center.x == pin.pos.x && oval.center.y == pin.pos.y) {
-                    cache.oval_index = oval_idx;
-                    found_geometry = true;
+                case BRDFileBase::PadShape::Rectangle:
+                    cache.rectangle_index = shape_idx;
+                    break;
+                case BRDFileBase::PadShape::Oval:
+                    cache.oval_index = shape_idx;
+                    break;
+                default:
                     break;
-                }
             }
         }
         
@@ -1497,233 +1443,354 @@ void PCBRenderer::BuildPinGeometryCache() {
         }
     }
     
+    BuildPartExtents();
+    BuildHitTestGrids();
     LOG_INFO("Pin geometry cache built successfully");
 }
 
-bool PCBRenderer::IsElementVisible(float x, float y, float radius, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
-    // Apply global rotation to element position before projecting
-    float rx = x, ry = y;
-    ApplyRotation(rx, ry, false);
-    float screen_x = rx * zoom + offset_x;
-    float screen_y = offset_y - ry * zoom;
-    float screen_radius = radius * zoom;
-    
-    // Add some margin for smooth culling
-    float margin = 10.0f;
-    
-    // Check if element is within screen bounds
-    return (screen_x + screen_radius + margin >= 0 &&
-            screen_x - screen_radius - margin <= window_width &&
-            screen_y + screen_radius + margin >= 0 &&
-            screen_y - screen_radius - margin <= window_height);
-}
+void PCBRenderer::BuildPartExtents() {
+    part_extents.assign(pcb_data->parts.size(), PartExtent{});
 
+    for (size_t part_idx = 0; part_idx < pcb_data->parts.size(); ++part_idx) {
+        BRDPoint pin_min, pin_max;
+        if (!pcb_data->GetPartPinBoundingBox(part_idx, pin_min, pin_max)) continue;
 
-// Pin selection functionality
-bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_width, int window_height) {
-    if (!pcb_data || pcb_data->pins.empty() || pin_geometry_cache.empty()) {
-        return false;
+        // Grow the pin-center box by the pad half-extents of the pins on each edge
+        float left_margin = 0.f, right_margin = 0.f, bottom_margin = 0.f, top_margin = 0.f;
+        for (uint32_t pin_idx : pcb_data->PinsOfPart(part_idx)) {
+            const BRDPoint& pos = pcb_data->pins[pin_idx].pos;
+            float ex = 5.f, ey = 5.f; // default when the pin has no pad geometry
+            if (pin_idx < pin_geometry_cache.size()) {
+                const auto& cache = pin_geometry_cache[pin_idx];
+                auto rotated_half_extents = [&](float w, float h, float rotation) {
+                    float hw = w * 0.5f;
+                    float hh = h * 0.5f;
+                    if (rotation == 0.f) {
+                        ex = hw; ey = hh;
+                    } else {
+                        float rot = rotation * 3.14159265f / 180.f;
+                        float c = std::abs(std::cos(rot));
+                        float s = std::abs(std::sin(rot));
+                        ex = hw * c + hh * s;
+                        ey = hw * s + hh * c;
+                    }
+                };
+                if (cache.circle_index != SIZE_MAX) {
+                    ex = ey = std::max(5.f, pcb_data->circles[cache.circle_index].radius);
+                } else if (cache.rectangle_index != SIZE_MAX) {
+                    const auto& rect = pcb_data->rectangles[cache.rectangle_index];
+                    rotated_half_extents(rect.width, rect.height, rect.rotation);
+                } else if (cache.oval_index != SIZE_MAX) {
+                    const auto& ov = pcb_data->ovals[cache.oval_index];
+                    rotated_half_extents(ov.width, ov.height, ov.rotation);
+                }
+            }
+            if (pos.x == pin_min.x) left_margin = std::max(left_margin, ex);
+            if (pos.x == pin_max.x) right_margin = std::max(right_margin, ex);
+            if (pos.y == pin_min.y) bottom_margin = std::max(bottom_margin, ey);
+            if (pos.y == pin_max.y) top_margin = std::max(top_margin, ey);
+        }
+
+        PartExtent& extent = part_extents[part_idx];
+        extent.min_x = pin_min.x - left_margin;
+        extent.max_x = pin_max.x + right_margin;
+        extent.min_y = pin_min.y - bottom_margin;
+        extent.max_y = pin_max.y + top_margin;
+        extent.valid = true;
     }
-    
-    // Convert screen coordinates to world coordinates
-    float world_x, world_y;
-    ScreenToWorld(screen_x, screen_y, world_x, world_y, window_width, window_height);
-    
-    // Check if click is near any pin using cached geometry data
-    for (size_t i = 0; i < pcb_data->pins.size() && i < pin_geometry_cache.size(); ++i) {
-        const auto& pin = pcb_data->pins[i];
-        const auto& cache = pin_geometry_cache[i];
-        
-    // Skip NC pins and GND-family pins from selection
-    if (cache.is_nc || cache.is_ground) {
-            continue;
-        }
+}
+
+void PCBRenderer::BuildHitTestGrids() {
+    std::vector<SpatialGrid::Box> boxes(pcb_data->pins.size());
+    for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size(); ++pin_idx) {
+        const auto& cache = pin_geometry_cache[pin_idx];
 
-        // Use cached geometry data for hit testing
+        // Bounding radius of the pad, whatever its rotation
+        float reach;
         if (cache.rectangle_index != SIZE_MAX) {
-            // Rectangle pin: check if click is inside the rectangle (with rotation)
             const auto& rect = pcb_data->rectangles[cache.rectangle_index];
-            float dx = world_x - pin.pos.x;
-            float dy = world_y - pin.pos.y;
-            // Undo rotation
-            float angle_rad = -rect.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
-            float half_w = rect.width / 2.0f;
-            float half_h = rect.height / 2.0f;
-            if (std::abs(local_x) <= half_w && std::abs(local_y) <= half_h) {
-                if (selected_pin_index == static_cast<int>(i)) {
-                    selected_pin_index = -1;
-                } else {
-                    // Clear navigation highlights so manual selection is visible
-                    highlighted_net.clear();
-                    highlighted_part_index = -1;
-                    selected_pin_index = static_cast<int>(i);
-                }
-                return true;
-            }
-            continue;
-        }
-
-        if (cache.oval_index != SIZE_MAX) {
-            // Oval pin: check if click is inside the rotated ellipse (approximate)
+            reach = 0.5f * std::sqrt(rect.width * rect.width + rect.height * rect.height);
+        } else if (cache.oval_index != SIZE_MAX) {
             const auto& oval = pcb_data->ovals[cache.oval_index];
-            float dx = world_x - pin.pos.x;
-            float dy = world_y - pin.pos.y;
-            float angle_rad = -oval.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
-            float rx = oval.width / 2.0f;
-            float ry = oval.height / 2.0f;
-            if ((local_x * local_x) / (rx * rx) + (local_y * local_y) / (ry * ry) <= 1.0f) {
-                if (selected_pin_index == static_cast<int>(i)) {
-                    selected_pin_index = -1;
-                } else {
-                    highlighted_net.clear();
-                    highlighted_part_index = -1;
-                    selected_pin_index = static_cast<int>(i);
-                }
-                return true;
-            }
-            continue;
+            reach = 0.5f * std::max(oval.width, oval.height);
+        } else {
+            reach = cache.radius < 1.0f ? 5.0f : cache.radius;
         }
+        const auto& pos = pcb_data->pins[pin_idx].pos;
+        boxes[pin_idx] = {pos.x - reach, pos.y - reach, pos.x + reach, pos.y + reach};
+    }
+    pin_label_grid.Build(boxes);
 
-        // Otherwise, treat as circle (default) using cached radius
-        float dx = world_x - pin.pos.x;
-        float dy = world_y - pin.pos.y;
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        float circle_radius = cache.radius;
-        if (circle_radius < 1.0f) {
-            circle_radius = 5.0f;
-        }
-        
-        if (distance <= circle_radius) {
-            if (selected_pin_index == static_cast<int>(i)) {
-                selected_pin_index = -1;
-            } else {
-                // Clear navigation highlights so manual selection is visible
-                highlighted_net.clear();
-                highlighted_part_index = -1;
-                selected_pin_index = static_cast<int>(i);
-            }
-            return true;
+    // Skip NC pins and GND-family pins from hover/selection
+    for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size(); ++pin_idx) {
+        const auto& cache = pin_geometry_cache[pin_idx];
+        if (cache.is_nc || cache.is_ground) boxes[pin_idx] = SpatialGrid::Box{};
+    }
+    pin_grid.Build(boxes);
+
+    boxes.assign(part_extents.size(), SpatialGrid::Box{});
+    for (size_t part_idx = 0; part_idx < part_extents.size(); ++part_idx) {
+        const PartExtent& e = part_extents[part_idx];
+        if (e.valid) boxes[part_idx] = {e.min_x, e.min_y, e.max_x, e.max_y};
+    }
+    part_grid.Build(boxes);
+}
+
+void PCBRenderer::BuildRenderGrids() {
+    std::vector<SpatialGrid::Box> boxes;
+    auto around = [](const BRDPoint& c, float reach) {
+        return SpatialGrid::Box{c.x - reach, c.y - reach, c.x + reach, c.y + reach};
+    };
+    auto segment_box = [](const std::pair<BRDPoint, BRDPoint>& seg) {
+        return SpatialGrid::Box{static_cast<float>(std::min(seg.first.x, seg.second.x)), static_cast<float>(std::min(seg.first.y, seg.second.y)),
+                                static_cast<float>(std::max(seg.first.x, seg.second.x)), static_cast<float>(std::max(seg.first.y, seg.second.y))};
+    };
+
+    boxes.clear();
+    for (const auto& circle : pcb_data->circles) boxes.push_back(around(circle.center, circle.radius));
+    circle_grid.Build(boxes);
+
+    // Rectangles and ovals by their rotation-independent bounding radius
+    boxes.clear();
+    for (const auto& rect : pcb_data->rectangles) {
+        boxes.push_back(around(rect.center, 0.5f * std::sqrt(rect.width * rect.width + rect.height * rect.height)));
+    }
+    rectangle_grid.Build(boxes);
+
+    boxes.clear();
+    for (const auto& oval : pcb_data->ovals) boxes.push_back(around(oval.center, 0.5f * std::max(oval.width, oval.height)));
+    oval_grid.Build(boxes);
+
+    boxes.clear();
+    for (const auto& seg : pcb_data->outline_segments) boxes.push_back(segment_box(seg));
+    outline_grid.Build(boxes);
+
+    auto arc_box = [](const BRDArc& arc) {
+        SpatialGrid::Box box;
+        arc.GetBounds(box.min_x, box.min_y, box.max_x, box.max_y);
+        float reach = 0.5f * arc.width;
+        return SpatialGrid::Box{box.min_x - reach, box.min_y - reach, box.max_x + reach, box.max_y + reach};
+    };
+    boxes.clear();
+    for (const auto& arc : pcb_data->outline_arcs) boxes.push_back(arc_box(arc));
+    outline_arc_grid.Build(boxes);
+    outline_arc_tess.Reset(pcb_data->outline_arcs.size());
+
+    // One grid per copper layer, grown by half the trace width
+    const size_t layer_count = pcb_data->trace_layers.size();
+    trace_grids.assign(layer_count, SpatialGrid());
+    trace_arc_grids.assign(layer_count, SpatialGrid());
+    trace_arc_tess.assign(layer_count, ArcTessellator());
+    for (size_t l = 0; l < layer_count; ++l) {
+        const auto& layer = pcb_data->trace_layers[l];
+        boxes.clear();
+        for (const auto& trace : layer.segments) {
+            SpatialGrid::Box box = segment_box({trace.a, trace.b});
+            float reach = 0.5f * trace.width;
+            boxes.push_back({box.min_x - reach, box.min_y - reach, box.max_x + reach, box.max_y + reach});
+        }
+        trace_grids[l].Build(boxes);
+
+        boxes.clear();
+        for (const auto& arc : layer.arcs) boxes.push_back(arc_box(arc));
+        trace_arc_grids[l].Build(boxes);
+        trace_arc_tess[l].Reset(layer.arcs.size());
+    }
+
+    // A new group starts at the first segment that does not touch the current one
+    part_outline_groups.clear();
+    const auto& part_segments = pcb_data->part_outline_segments;
+    for (uint32_t i = 0; i < part_segments.size(); ++i) {
+        SpatialGrid::Box seg = segment_box(part_segments[i]);
+        if (part_outline_groups.empty() || !part_outline_groups.back().bounds.Overlaps(seg)) {
+            part_outline_groups.push_back({i, i + 1, seg});
+            continue;
+        }
+        OutlineGroup& group = part_outline_groups.back();
+        group.last = i + 1;
+        group.bounds.min_x = std::min(group.bounds.min_x, seg.min_x); group.bounds.max_x = std::max(group.bounds.max_x, seg.max_x);
+        group.bounds.min_y = std::min(group.bounds.min_y, seg.min_y); group.bounds.max_y = std::max(group.bounds.max_y, seg.max_y);
+    }
+    boxes.clear();
+    for (const auto& group : part_outline_groups) boxes.push_back(group.bounds);
+    part_outline_grid.Build(boxes);
+}
+
+void PCBRenderer::UpdateViewWorld(int window_width, int window_height) {
+    // Rotation is in quarter turns and flips mirror about the board center, so
+    // the window maps to an axis-aligned world rectangle: the box of its corners
+    const float margin = 10.0f; // pixels, for smooth culling at the edges
+    const float sx[2] = {-margin, window_width + margin};
+    const float sy[2] = {-margin, window_height + margin};
+    for (int i = 0; i < 4; ++i) {
+        float wx, wy;
+        ScreenToWorld(sx[i & 1], sy[i >> 1], wx, wy, window_width, window_height);
+        if (i == 0) {
+            view_world = {wx, wy, wx, wy};
+        } else {
+            view_world.min_x = std::min(view_world.min_x, wx); view_world.max_x = std::max(view_world.max_x, wx);
+            view_world.min_y = std::min(view_world.min_y, wy); view_world.max_y = std::max(view_world.max_y, wy);
+        }
+    }
+}
+
+void PCBRenderer::BeginLodFrame(int window_width, int window_height) {
+    int cols = std::max(1, (window_width + 1) / 2);
+    int rows = std::max(1, (window_height + 1) / 2);
+    if (cols != lod_dot_cols || rows != lod_dot_rows || ++lod_frame == 0) {
+        lod_dot_cols = cols;
+        lod_dot_rows = rows;
+        lod_dot_color.assign(static_cast<size_t>(cols) * rows, 0);
+        lod_dot_frame.assign(static_cast<size_t>(cols) * rows, 0);
+        lod_frame = 1;
+    }
+}
+
+void PCBRenderer::DrawPadDot(ImDrawList* draw_list, float x, float y, float size_px, ImU32 color) {
+    // Many zoomed-out pads land in the same few pixels; draw each color once per cell
+    if (x >= 0.0f && y >= 0.0f) {
+        int cx = static_cast<int>(x * 0.5f);
+        int cy = static_cast<int>(y * 0.5f);
+        if (cx < lod_dot_cols && cy < lod_dot_rows) {
+            size_t cell = static_cast<size_t>(cy) * lod_dot_cols + cx;
+            if (lod_dot_frame[cell] == lod_frame && lod_dot_color[cell] == color) return;
+            lod_dot_frame[cell] = lod_frame;
+            lod_dot_color[cell] = color;
         }
     }
+    float half = std::max(0.5f, size_px * 0.5f);
+    draw_list->AddRectFilled(ImVec2(x - half, y - half), ImVec2(x + half, y + half), color);
+}
+
+void PCBRenderer::UpdatePadFrame(int window_width, int window_height, float zoom, float offset_x, float offset_y) {
+    // Instances are relative to the board center, which is also the rotation/flip
+    // pivot: NDC = S * (c + A * p) + b, with A the quarter-turn rotation then
+    // flips, S the zoom over half the window and b the screen offset
+    static const int rotations[4][4] = {{1, 0, 0, 1}, {0, 1, -1, 0}, {-1, 0, 0, -1}, {0, -1, 1, 0}};
+    const int* R = rotations[((camera.rotation_steps % 4) + 4) % 4];
+    const double fx = camera.flip_horizontal ? -1.0 : 1.0;
+    const double fy = camera.flip_vertical ? -1.0 : 1.0;
+    const double sx = 2.0 * zoom / window_width;
+    const double sy = 2.0 * zoom / window_height;
+    pad_frame.linear[0] = static_cast<float>(sx * fx * R[0]); // column 0
+    pad_frame.linear[1] = static_cast<float>(sy * fy * R[2]);
+    pad_frame.linear[2] = static_cast<float>(sx * fx * R[1]); // column 1
+    pad_frame.linear[3] = static_cast<float>(sy * fy * R[3]);
+    pad_frame.translate[0] = static_cast<float>(sx * board_cx + 2.0 * offset_x / window_width - 1.0);
+    pad_frame.translate[1] = static_cast<float>(sy * board_cy + 1.0 - 2.0 * offset_y / window_height);
+    pad_frame.zoom = zoom;
+
+    pad_frame.highlight_net = HighlightNetId();
+    auto set = [](float* dst, float r, float g, float b, float a) { dst[0] = r; dst[1] = g; dst[2] = b; dst[3] = a; };
+    set(pad_frame.same_net_color, settings.pin_same_net_color.r, settings.pin_same_net_color.g, settings.pin_same_net_color.b, 1.0f);
+    set(pad_frame.nc_color, settings.pin_nc_color.r, settings.pin_nc_color.g, settings.pin_nc_color.b, 1.0f);
+    set(pad_frame.ground_color, settings.pin_ground_color.r, settings.pin_ground_color.g, settings.pin_ground_color.b, 1.0f);
+    set(pad_frame.pin_color, settings.pin_color.r, settings.pin_color.g, settings.pin_color.b, settings.pin_alpha);
+    pad_frame.override_pin_colors = settings.override_pin_colors;
+    pad_frame.point_px = settings.lod_pad_point_px;
+    pad_frame.outline_px = settings.lod_pad_outline_px;
+}
+
+void PCBRenderer::DrawPadBatchCallback(const ImDrawList*, const ImDrawCmd* cmd) {
+    const auto* self = static_cast<const PCBRenderer*>(cmd->UserCallbackData);
+    self->pad_batch.Draw(self->pad_frame);
+}
+
+bool PCBRenderer::PinContainsPoint(size_t pin_idx, float world_x, float world_y) const {
+    const auto& pin = pcb_data->pins[pin_idx];
+    const auto& cache = pin_geometry_cache[pin_idx];
+    float dx = world_x - pin.pos.x;
+    float dy = world_y - pin.pos.y;
+
+    if (cache.rectangle_index != SIZE_MAX) {
+        // Rectangle pin: undo the pad rotation and compare against half extents
+        const auto& rect = pcb_data->rectangles[cache.rectangle_index];
+        float angle_rad = -rect.rotation * 3.14159265f / 180.0f;
+        float cos_a = std::cos(angle_rad);
+        float sin_a = std::sin(angle_rad);
+        float local_x = dx * cos_a - dy * sin_a;
+        float local_y = dx * sin_a + dy * cos_a;
+        return std::abs(local_x) <= rect.width / 2.0f && std::abs(local_y) <= rect.height / 2.0f;
+    }
+
+    if (cache.oval_index != SIZE_MAX) {
+        // Oval pin: rotated ellipse (approximate)
+        const auto& oval = pcb_data->ovals[cache.oval_index];
+        float angle_rad = -oval.rotation * 3.14159265f / 180.0f;
+        float cos_a = std::cos(angle_rad);
+        float sin_a = std::sin(angle_rad);
+        float local_x = dx * cos_a - dy * sin_a;
+        float local_y = dx * sin_a + dy * cos_a;
+        float rx = oval.width / 2.0f;
+        float ry = oval.height / 2.0f;
+        return (local_x * local_x) / (rx * rx) + (local_y * local_y) / (ry * ry) <= 1.0f;
+    }
+
+    // Otherwise, treat as circle (default) using cached radius
+    float circle_radius = cache.radius;
+    if (circle_radius < 1.0f) {
+        circle_radius = 5.0f; // Default fallback for very small pins
+    }
+    return std::sqrt(dx * dx + dy * dy) <= circle_radius;
+}
+
+bool PCBRenderer::IsElementVisible(float x, float y, float radius, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    // Apply global rotation to element position before projecting
+    float rx = x, ry = y;
+    ApplyRotation(rx, ry, false);
+    float screen_x = rx * zoom + offset_x;
+    float screen_y = offset_y - ry * zoom;
+    float screen_radius = radius * zoom;
+    
+    // Add some margin for smooth culling
+    float margin = 10.0f;
+    
+    // Check if element is within screen bounds
+    return (screen_x + screen_radius + margin >= 0 &&
+            screen_x - screen_radius - margin <= window_width &&
+            screen_y + screen_radius + margin >= 0 &&
+            screen_y - screen_radius - margin <= window_height);
+}
+
+
+// Pin selection functionality
+bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_width, int window_height) {
+    if (!pcb_data || pcb_data->pins.empty() || pin_geometry_cache.empty()) {
+        return false;
+    }
+    
+    // Convert screen coordinates to world coordinates
+    float world_x, world_y;
+    ScreenToWorld(screen_x, screen_y, world_x, world_y, window_width, window_height);
+    
+    // Pins first, lowest index wins (NC and GND-family pins are not in the grid)
+    int pin_idx = pin_grid.FindFirst(world_x, world_y, [&](uint32_t i) { return PinContainsPoint(i, world_x, world_y); });
+    if (pin_idx >= 0) {
+        if (selected_pin_index == pin_idx) {
+            selected_pin_index = -1;
+        } else {
+            // Clear navigation highlights so manual selection is visible
+            highlighted_net.clear();
+            highlighted_part_index = -1;
+            selected_pin_index = pin_idx;
+        }
+        return true;
+    }
     
     // If no pin was clicked, check if click is inside any part area
-    if (pcb_data && !pcb_data->parts.empty()) {
-        for (size_t part_idx = 0; part_idx < pcb_data->parts.size(); ++part_idx) {
-            // const auto& part = pcb_data->parts[part_idx]; // unused
-            
-            // Get all pins for this part to calculate bounds
-            std::vector<const BRDPin*> part_pins;
-            for (const auto& pin : pcb_data->pins) {
-                if (pin.part == static_cast<unsigned int>(part_idx + 1)) { // pins store 1-based part ids
-                    part_pins.push_back(&pin);
-                }
-            }
-            
-            if (part_pins.empty()) continue;
-            
-            // Calculate part bounds using the same logic as RenderPartHighlighting
-            struct PinExtent { BRDPoint pos; float left, right, bottom, top; };
-            std::vector<PinExtent> extents;
-            extents.reserve(part_pins.size());
-            
-            for (const auto* pin_ptr : part_pins) {
-                const auto& pin = *pin_ptr;
-                size_t pin_index = pin_ptr - &pcb_data->pins[0]; // Calculate index
-                // Geometry cache not required for non-destructive bounds here
-                
-                PinExtent pe{ pin.pos, 5.f, 5.f, 5.f, 5.f }; // default
-                bool found = false;
-                
-                // Circle
-                for (const auto& c : pcb_data->circles) {
-                    if (c.center.x == pin.pos.x && c.center.y == pin.pos.y) {
-                        float r = std::max(5.f, c.radius);
-                        pe.left = pe.right = pe.bottom = pe.top = r;
-                        found = true; 
-                        break;
-                    }
-                }
-                
-                // Rectangle
-                if (!found) {
-                    for (const auto& rect : pcb_data->rectangles) {
-                        if (rect.center.x == pin.pos.x && rect.center.y == pin.pos.y) {
-                            float hw = rect.width * 0.5f;
-                            float hh = rect.height * 0.5f;
-                            if (rect.rotation == 0.f) {
-                                pe.left = pe.right = hw; 
-                                pe.bottom = pe.top = hh;
-                            } else {
-                                float rot = rect.rotation * 3.14159265f / 180.f;
-                                float c = std::abs(std::cos(rot));
-                                float s = std::abs(std::sin(rot));
-                                float ex = hw * c + hh * s;
-                                float ey = hw * s + hh * c;
-                                pe.left = pe.right = ex; 
-                                pe.bottom = pe.top = ey;
-                            }
-                            found = true; 
-                            break;
-                        }
-                    }
-                }
-                
-                extents.push_back(pe);
-            }
-            
-            if (extents.empty()) continue;
-            
-            // Calculate bounding box
-            float min_x = extents[0].pos.x, max_x = extents[0].pos.x;
-            float min_y = extents[0].pos.y, max_y = extents[0].pos.y;
-            for (const auto& e : extents) {
-                if (e.pos.x < min_x) { min_x = e.pos.x; }
-                if (e.pos.x > max_x) { max_x = e.pos.x; }
-                if (e.pos.y < min_y) { min_y = e.pos.y; }
-                if (e.pos.y > max_y) { max_y = e.pos.y; }
-            }
-            
-            // Calculate margins
-            float left_margin = 0.f, right_margin = 0.f, bottom_margin = 0.f, top_margin = 0.f;
-            for (const auto& e : extents) {
-                if (e.pos.x == min_x) left_margin = std::max(left_margin, e.left);
-                if (e.pos.x == max_x) right_margin = std::max(right_margin, e.right);
-                if (e.pos.y == min_y) bottom_margin = std::max(bottom_margin, e.bottom);
-                if (e.pos.y == max_y) top_margin = std::max(top_margin, e.top);
-            }
-            
-            // Expand bounds by margins
-            float part_min_x = min_x - left_margin;
-            float part_max_x = max_x + right_margin;
-            float part_min_y = min_y - bottom_margin;
-            float part_max_y = max_y + top_margin;
-            
-            // Check if click is inside this part's bounds
-            if (world_x >= part_min_x && world_x <= part_max_x && 
-                world_y >= part_min_y && world_y <= part_max_y) {
-                
-                if (highlighted_part_index == static_cast<int>(part_idx)) {
-                    // Clicking on already highlighted part deselects it
-                    highlighted_part_index = -1;
-                    // Also clear highlighted net to fully reset state
-                    highlighted_net.clear();
-                } else {
-                    // Highlight this part without altering any existing pin selection
-                    highlighted_net.clear();
-                    highlighted_part_index = static_cast<int>(part_idx);
-                }
-                return true;
-            }
+    int part_idx = FindPartAt(world_x, world_y);
+    if (part_idx >= 0) {
+        if (highlighted_part_index == part_idx) {
+            // Clicking on already highlighted part deselects it
+            highlighted_part_index = -1;
+            // Also clear highlighted net to fully reset state
+            highlighted_net.clear();
+        } else {
+            // Highlight this part without altering any existing pin selection
+            highlighted_net.clear();
+            highlighted_part_index = part_idx;
         }
+        return true;
     }
     
     // Click on empty area - deselect everything, including external net highlight
@@ -1746,69 +1813,8 @@ int PCBRenderer::GetHoveredPin(float screen_x, float screen_y, int window_width,
     float world_x, world_y;
     ScreenToWorld(screen_x, screen_y, world_x, world_y, window_width, window_height);
     
-    for (size_t i = 0; i < pcb_data->pins.size() && i < pin_geometry_cache.size(); ++i) {
-        const auto& pin = pcb_data->pins[i];
-        const auto& cache = pin_geometry_cache[i];
-        
-    // Skip NC pins and GND-family pins from hover/highlight
-    if (cache.is_nc || cache.is_ground) {
-            continue;
-        }
-
-        // Use cached geometry data for hit testing
-        if (cache.rectangle_index != SIZE_MAX) {
-            // Rectangle pin: check if mouse is inside the rectangle (with rotation)
-            const auto& rect = pcb_data->rectangles[cache.rectangle_index];
-            float dx = world_x - pin.pos.x;
-            float dy = world_y - pin.pos.y;
-            // Undo rotation
-            float angle_rad = -rect.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
-            float half_w = rect.width / 2.0f;
-            float half_h = rect.height / 2.0f;
-            if (std::abs(local_x) <= half_w && std::abs(local_y) <= half_h) {
-                return static_cast<int>(i);
-            }
-            continue;
-        }
-
-        if (cache.oval_index != SIZE_MAX) {
-            // Oval pin: check if mouse is inside the rotated ellipse (approximate)
-            const auto& oval = pcb_data->ovals[cache.oval_index];
-            float dx = world_x - pin.pos.x;
-            float dy = world_y - pin.pos.y;
-            float angle_rad = -oval.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
-            float rx = oval.width / 2.0f;
-            float ry = oval.height / 2.0f;
-            if ((local_x * local_x) / (rx * rx) + (local_y * local_y) / (ry * ry) <= 1.0f) {
-                return static_cast<int>(i);
-            }
-            continue;
-        }
-
-        // Otherwise, treat as circle (default) using cached radius
-        float dx = world_x - pin.pos.x;
-        float dy = world_y - pin.pos.y;
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        float circle_radius = cache.radius;
-        if (circle_radius < 1.0f) {
-            circle_radius = 5.0f; // Default fallback for very small pins
-        }
-        
-        if (distance <= circle_radius) {
-            return static_cast<int>(i);
-        }
-    }
-    
-    return -1; // No pin hovered
+    // NC and GND-family pins are left out of the grid, so they never hover
+    return pin_grid.FindFirst(world_x, world_y, [&](uint32_t i) { return PinContainsPoint(i, world_x, world_y); });
 }
 
 int PCBRenderer::HitTestPart(float screen_x, float screen_y, int window_width, int window_height) const {
@@ -1819,99 +1825,11 @@ int PCBRenderer::HitTestPart(float screen_x, float screen_y, int window_width, i
     float world_y = camera.y + (window_height * 0.5f - screen_y) / camera.zoom;
     ApplyRotation(world_x, world_y, true);
 
-    for (size_t part_idx = 0; part_idx < pcb_data->parts.size(); ++part_idx) {
-    // const auto &part = pcb_data->parts[part_idx]; // unused
-
-        // Collect pins for this part
-        std::vector<const BRDPin*> part_pins;
-        for (const auto &pin : pcb_data->pins) {
-            if (pin.part == static_cast<unsigned int>(part_idx + 1)) {
-                part_pins.push_back(&pin);
-            }
-        }
-        if (part_pins.empty()) continue;
-
-        struct PinExtent { BRDPoint pos; float left, right, bottom, top; };
-        std::vector<PinExtent> extents; extents.reserve(part_pins.size());
-
-        for (const auto *pin_ptr : part_pins) {
-            const auto &pin = *pin_ptr;
-            // size_t pin_index = pin_ptr - &pcb_data->pins[0]; // index unused here
-
-            PinExtent pe{ pin.pos, 5.f, 5.f, 5.f, 5.f }; // defaults
-            bool found = false;
-
-            // Circle
-            for (const auto &c : pcb_data->circles) {
-                if (c.center.x == pin.pos.x && c.center.y == pin.pos.y) {
-                    float r = std::max(5.f, c.radius);
-                    pe.left = pe.right = pe.bottom = pe.top = r; found = true; break;
-                }
-            }
-
-            // Rectangle
-            if (!found) {
-                for (const auto &rect : pcb_data->rectangles) {
-                    if (rect.center.x == pin.pos.x && rect.center.y == pin.pos.y) {
-                        float hw = rect.width * 0.5f; float hh = rect.height * 0.5f;
-                        if (rect.rotation == 0.f) { pe.left = pe.right = hw; pe.bottom = pe.top = hh; }
-                        else {
-                            float rot = rect.rotation * 3.14159265f / 180.f; float c = std::abs(std::cos(rot)); float s = std::abs(std::sin(rot));
-                            float ex = hw * c + hh * s; float ey = hw * s + hh * c; pe.left = pe.right = ex; pe.bottom = pe.top = ey;
-                        }
-                        found = true; break;
-                    }
-                }
-            }
-
-            // Oval
-            if (!found) {
-                for (const auto &oval : pcb_data->ovals) {
-                    if (oval.center.x == pin.pos.x && oval.center.y == pin.pos.y) {
-                        float hw = oval.width * 0.5f; float hh = oval.height * 0.5f;
-                        if (oval.rotation == 0.f) { pe.left = pe.right = hw; pe.bottom = pe.top = hh; }
-                        else {
-                            float rot = oval.rotation * 3.14159265f / 180.f; float c = std::abs(std::cos(rot)); float s = std::abs(std::sin(rot));
-                            float ex = hw * c + hh * s; float ey = hw * s + hh * c; pe.left = pe.right = ex; pe.bottom = pe.top = ey;
-                        }
-                        found = true; break;
-                    }
-                }
-            }
-
-            extents.push_back(pe);
-        }
-
-        if (extents.empty()) continue;
-
-        float min_x = extents[0].pos.x, max_x = extents[0].pos.x;
-        float min_y = extents[0].pos.y, max_y = extents[0].pos.y;
-        for (const auto &e : extents) {
-            if (e.pos.x < min_x) { min_x = e.pos.x; }
-            if (e.pos.x > max_x) { max_x = e.pos.x; }
-            if (e.pos.y < min_y) { min_y = e.pos.y; }
-            if (e.pos.y > max_y) { max_y = e.pos.y; }
-        }
-
-        float left_margin=0.f,right_margin=0.f,bottom_margin=0.f,top_margin=0.f;
-        for (const auto &e : extents) {
-            if (e.pos.x == min_x) left_margin = std::max(left_margin, e.left);
-            if (e.pos.x == max_x) right_margin = std::max(right_margin, e.right);
-            if (e.pos.y == min_y) bottom_margin = std::max(bottom_margin, e.bottom);
-            if (e.pos.y == max_y) top_margin = std::max(top_margin, e.top);
-        }
-
-        float part_min_x = min_x - left_margin;
-        float part_max_x = max_x + right_margin;
-        float part_min_y = min_y - bottom_margin;
-        float part_max_y = max_y + top_margin;
-
-        if (world_x >= part_min_x && world_x <= part_max_x && world_y >= part_min_y && world_y <= part_max_y) {
-            return static_cast<int>(part_idx);
-        }
-    }
+    return FindPartAt(world_x, world_y);
+}
 
-    return -1;
+int PCBRenderer::FindPartAt(float world_x, float world_y) const {
+    return part_grid.FindFirst(world_x, world_y);
 }
 
 // Coordinate conversion methods
@@ -1968,42 +1886,91 @@ void PCBRenderer::ApplyRotation(float& x, float& y, bool inverse) const {
 }
 
 void PCBRenderer::RenderPartNamesOnTop(ImDrawList* draw_list) {
-    // Render all collected part names on top of all other graphics
+    const ImU32 text_color = IM_COL32((int)(settings.component_name_text_color.r*255), (int)(settings.component_name_text_color.g*255), (int)(settings.component_name_text_color.b*255), 255);
+    const ImU32 background_color = IM_COL32((int)(settings.component_name_bg_color.r*255), (int)(settings.component_name_bg_color.g*255), (int)(settings.component_name_bg_color.b*255), (int)(settings.component_name_bg_color.a*255));
+
+    // Render all placed part names on top of all other graphics
     for (const auto& part_name_info : part_names_to_render) {
-        // Clip text rendering to component boundaries
-        draw_list->PushClipRect(part_name_info.clip_min, part_name_info.clip_max, true);
+        ImVec2 bg_min = ImVec2(part_name_info.position.x - 1, part_name_info.position.y);
+        ImVec2 bg_max = ImVec2(part_name_info.position.x + part_name_info.size.x + 1, part_name_info.position.y + part_name_info.size.y);
+
+        // Clip to component boundaries only when the label reaches past them;
+        // unclipped labels share one draw command
+        bool clip = bg_min.x < part_name_info.clip_min.x || bg_min.y < part_name_info.clip_min.y ||
+                    bg_max.x > part_name_info.clip_max.x || bg_max.y > part_name_info.clip_max.y;
+        if (clip) {
+            draw_list->PushClipRect(part_name_info.clip_min, part_name_info.clip_max, true);
+        }
         
         // Add text background only if it's not transparent
-        if ((part_name_info.background_color & 0xFF) > 0) {  // Check alpha channel
-            ImVec2 bg_min = ImVec2(part_name_info.position.x - 1, part_name_info.position.y);
-            ImVec2 bg_max = ImVec2(part_name_info.position.x + part_name_info.size.x + 1, part_name_info.position.y + part_name_info.size.y);
-            draw_list->AddRectFilled(bg_min, bg_max, part_name_info.background_color);
+        if ((background_color & 0xFF) > 0) {  // Check alpha channel
+            draw_list->AddRectFilled(bg_min, bg_max, background_color);
         }
         
         // Render the part name text (no scaling - text already fits within bounds)
-        draw_list->AddText(part_name_info.position, part_name_info.color, part_name_info.text.c_str());
+        draw_list->AddText(part_name_info.position, text_color, part_name_info.text.c_str());
         
-        // Restore clipping
-        draw_list->PopClipRect();
+        if (clip) {
+            draw_list->PopClipRect();
+        }
     }
-    
-    // Clear the collection for the next frame
-    part_names_to_render.clear();
 }
 
-void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float offset_y) {
-    if (!pcb_data || pcb_data->parts.empty()) {
-        return;
+bool PCBRenderer::ClaimLabelCells(const ImVec2& min, const ImVec2& max) {
+    int x0 = std::max(0, static_cast<int>(std::floor(min.x / kLabelCellPx)));
+    int y0 = std::max(0, static_cast<int>(std::floor(min.y / kLabelCellPx)));
+    int x1 = std::min(label_occupancy_cols - 1, static_cast<int>(std::ceil(max.x / kLabelCellPx)) - 1);
+    int y1 = std::min(label_occupancy_rows - 1, static_cast<int>(std::ceil(max.y / kLabelCellPx)) - 1);
+    if (x0 > x1 || y0 > y1) return false; // off screen
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        const uint8_t* row = &label_occupancy[static_cast<size_t>(cy) * label_occupancy_cols];
+        for (int cx = x0; cx <= x1; ++cx) {
+            if (row[cx]) return false;
+        }
+    }
+    for (int cy = y0; cy <= y1; ++cy) {
+        std::fill_n(&label_occupancy[static_cast<size_t>(cy) * label_occupancy_cols + x0], x1 - x0 + 1, uint8_t(1));
     }
+    return true;
+}
 
+void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float offset_y, int window_width, int window_height) {
     // Only show part names when zoomed in enough for readability
-    if (zoom < 0.3f) {
+    if (!pcb_data || pcb_data->parts.empty() || zoom < 0.3f) {
+        part_names_to_render.clear();
+        part_labels_valid = false;
         return;
     }
 
-    // Clear any existing part names from previous frame
-    part_names_to_render.clear();
+    // The selected part's name wins every collision
+    int priority_part = highlighted_part_index;
+    if (priority_part < 0 && selected_pin_index >= 0 && selected_pin_index < static_cast<int>(pcb_data->pins.size())) {
+        priority_part = static_cast<int>(pcb_data->pins[selected_pin_index].part) - 1; // pins store 1-based part ids
+    }
 
+    // Keep the previous placement while nothing it depends on has changed
+    PartLabelKey key;
+    key.width = window_width;
+    key.height = window_height;
+    key.camera = camera;
+    key.font = ImGui::GetFont();
+    key.font_size = ImGui::GetFontSize();
+    key.priority_part = priority_part;
+    if (part_labels_valid && key.width == part_label_key.width && key.height == part_label_key.height &&
+        key.camera.x == part_label_key.camera.x && key.camera.y == part_label_key.camera.y &&
+        key.camera.zoom == part_label_key.camera.zoom && key.camera.rotation_steps == part_label_key.camera.rotation_steps &&
+        key.camera.flip_horizontal == part_label_key.camera.flip_horizontal &&
+        key.camera.flip_vertical == part_label_key.camera.flip_vertical &&
+        key.font == part_label_key.font && key.font_size == part_label_key.font_size &&
+        key.priority_part == part_label_key.priority_part) {
+        return;
+    }
+    part_label_key = key;
+    part_labels_valid = true;
+
+    // Candidates: every on-screen name that fits inside its part
+    part_label_candidates.clear();
     for (size_t part_index = 0; part_index < pcb_data->parts.size(); ++part_index) {
         const auto& part = pcb_data->parts[part_index];
         
@@ -2012,137 +1979,183 @@ void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float
             continue;
         }
 
-        // Get pins for this part to calculate bounds
-        std::vector<BRDPin> part_pins;
-        for (const auto& pin : pcb_data->pins) {
-            if (pin.part == part_index + 1) { // Parts are 1-indexed
-                part_pins.push_back(pin);
-            }
-        }
+        // Pins of this part come from the part index (no per-frame pin scan)
+        const size_t part_pin_count = pcb_data->PinsOfPart(part_index).size();
 
         // If part has only one pin, do not show the part name
-        if (part_pins.size() == 1) {
+        if (part_pin_count == 1) {
             continue;
         }
 
-        if (part_pins.empty()) {
+        float min_x, min_y, max_x, max_y;
+        if (part_pin_count == 0) {
             // Use part bounds if no pins
-            float center_x = (part.p1.x + part.p2.x) * 0.5f;
-            float center_y = (part.p1.y + part.p2.y) * 0.5f;
-            ApplyRotation(center_x, center_y, false);
-            
-            // Transform to screen coordinates
-            float screen_x = center_x * zoom + offset_x;
-            float screen_y = offset_y - center_y * zoom;
-            
-            // Calculate text size
-            ImVec2 text_size = ImGui::CalcTextSize(part.name.c_str());
-            
-            // Check if text fits within part bounds
-            float part_width = std::abs(part.p2.x - part.p1.x) * zoom;
-            float part_height = std::abs(part.p2.y - part.p1.y) * zoom;
-            
-            // Only show if text fits completely within the part boundaries
-            if (text_size.x > part_width || text_size.y > part_height) {
-                continue; // Skip if text doesn't fit
-            }
-            
-            PartNameInfo info;
-            info.text = part.name;
-            info.position = ImVec2(screen_x - text_size.x * 0.5f, screen_y - text_size.y * 0.5f);
-            info.size = text_size;
-            info.color = IM_COL32((int)(settings.component_name_text_color.r*255), (int)(settings.component_name_text_color.g*255), (int)(settings.component_name_text_color.b*255), 255);
-            info.background_color = IM_COL32((int)(settings.component_name_bg_color.r*255), (int)(settings.component_name_bg_color.g*255), (int)(settings.component_name_bg_color.b*255), (int)(settings.component_name_bg_color.a*255));
-            
-            // Set clipping bounds (use part bounds)
-            float bbminx = part.p1.x, bbminy = part.p1.y;
-            float bbmaxx = part.p2.x, bbmaxy = part.p2.y;
-            ApplyRotation(bbminx, bbminy, false);
-            ApplyRotation(bbmaxx, bbmaxy, false);
-            float min_x = bbminx * zoom + offset_x;
-            float max_x = bbmaxx * zoom + offset_x;
-            float min_y = offset_y - bbmaxy * zoom;
-            float max_y = offset_y - bbminy * zoom;
-            
-            info.clip_min = ImVec2(min_x, min_y);
-            info.clip_max = ImVec2(max_x, max_y);
-            
-            part_names_to_render.push_back(info);
+            min_x = part.p1.x;
+            min_y = part.p1.y;
+            max_x = part.p2.x;
+            max_y = part.p2.y;
+            ApplyRotation(min_x, min_y, false);
+            ApplyRotation(max_x, max_y, false);
+        } else {
+            // Calculate part bounds from pins. Board rotation/flips map axis-aligned
+            // boxes to axis-aligned boxes, so rotating the cached corners is enough.
+            BRDPoint pin_min, pin_max;
+            pcb_data->GetPartPinBoundingBox(part_index, pin_min, pin_max);
+            min_x = pin_min.x;
+            min_y = pin_min.y;
+            max_x = pin_max.x;
+            max_y = pin_max.y;
+            ApplyRotation(min_x, min_y, false);
+            ApplyRotation(max_x, max_y, false);
+            if (min_x > max_x) std::swap(min_x, max_x);
+            if (min_y > max_y) std::swap(min_y, max_y);
+
+            // Add some margin around the pins
+            float margin = DeterminePinMargin(part, part_pin_count, 
+                                            std::sqrt((max_x - min_x) * (max_x - min_x) + (max_y - min_y) * (max_y - min_y)));
+            min_x -= margin;
+            max_x += margin;
+            min_y -= margin;
+            max_y += margin;
+        }
+
+        // Component bounds in screen coordinates
+        float screen_min_x = min_x * zoom + offset_x;
+        float screen_max_x = max_x * zoom + offset_x;
+        float screen_min_y = offset_y - max_y * zoom;
+        float screen_max_y = offset_y - min_y * zoom;
+        if (screen_max_x < 0.0f || screen_min_x > window_width || screen_max_y < 0.0f || screen_min_y > window_height) {
             continue;
         }
 
-        // Calculate part bounds from pins
-        float min_x = part_pins[0].pos.x, max_x = part_pins[0].pos.x;
-        float min_y = part_pins[0].pos.y, max_y = part_pins[0].pos.y;
-        ApplyRotation(min_x, min_y, false); // rotate initial
-        ApplyRotation(max_x, max_y, false);
-        if (min_x > max_x) std::swap(min_x, max_x);
-        if (min_y > max_y) std::swap(min_y, max_y);
-        
-        for (const auto& pin : part_pins) {
-            float px = pin.pos.x, py = pin.pos.y;
-            ApplyRotation(px, py, false);
-            min_x = std::min(min_x, px);
-            max_x = std::max(max_x, px);
-            min_y = std::min(min_y, py);
-            max_y = std::max(max_y, py);
-        }
-
-        // Add some margin around the pins
-        float margin = DeterminePinMargin(part, part_pins, 
-                                        std::sqrt((max_x - min_x) * (max_x - min_x) + (max_y - min_y) * (max_y - min_y)));
-        
-        min_x -= margin;
-        max_x += margin;
-        min_y -= margin;
-        max_y += margin;
-
-        // Calculate center position in world coordinates
-        float center_x = (min_x + max_x) * 0.5f;
-        float center_y = (min_y + max_y) * 0.5f;
-        
-        // Transform to screen coordinates
-        float screen_center_x = center_x * zoom + offset_x;
-        float screen_center_y = offset_y - center_y * zoom;
-        
-        // Calculate text size
-        ImVec2 text_size = ImGui::CalcTextSize(part.name.c_str());
-        
-        // Check if text fits within component bounds (screen coordinates)
-        float component_width = (max_x - min_x) * zoom;
-        float component_height = (max_y - min_y) * zoom;
-        
         // Only show if text fits completely within the component boundaries
+        ImVec2 text_size = ImGui::CalcTextSize(part.name.c_str());
+        float component_width = std::abs(max_x - min_x) * zoom;
+        float component_height = std::abs(max_y - min_y) * zoom;
         if (text_size.x > component_width || text_size.y > component_height) {
-            // Text too large to fit inside component, skip
             continue;
         }
-        
-        // Use original text size (no artificial scaling)
-        ImVec2 scaled_text_size = text_size;
 
-    PartNameInfo info;
+        float screen_center_x = (screen_min_x + screen_max_x) * 0.5f;
+        float screen_center_y = (screen_min_y + screen_max_y) * 0.5f;
+
+        PartNameInfo info;
         info.text = part.name;
-        info.position = ImVec2(screen_center_x - scaled_text_size.x * 0.5f, screen_center_y - scaled_text_size.y * 0.5f);
-        info.size = scaled_text_size;
-    info.color = IM_COL32((int)(settings.component_name_text_color.r*255), (int)(settings.component_name_text_color.g*255), (int)(settings.component_name_text_color.b*255), 255);
-    // Background
-    info.background_color = IM_COL32((int)(settings.component_name_bg_color.r*255), (int)(settings.component_name_bg_color.g*255), (int)(settings.component_name_bg_color.b*255), (int)(settings.component_name_bg_color.a*255));
-        
-        // Set clipping bounds to component area
-        float screen_min_x = min_x * zoom + offset_x;
-        float screen_max_x = max_x * zoom + offset_x;
-        float screen_min_y = offset_y - max_y * zoom;
-        float screen_max_y = offset_y - min_y * zoom;
-        
-        info.clip_min = ImVec2(screen_min_x, screen_min_y);
-        info.clip_max = ImVec2(screen_max_x, screen_max_y);
-        
-        part_names_to_render.push_back(info);
+        info.position = ImVec2(screen_center_x - text_size.x * 0.5f, screen_center_y - text_size.y * 0.5f);
+        info.size = text_size;
+        info.clip_min = ImVec2(std::min(screen_min_x, screen_max_x), std::min(screen_min_y, screen_max_y));
+        info.clip_max = ImVec2(std::max(screen_min_x, screen_max_x), std::max(screen_min_y, screen_max_y));
+        info.priority = static_cast<int>(part_index) == priority_part ? std::numeric_limits<float>::max()
+                                                                      : component_width * component_height;
+        part_label_candidates.push_back(std::move(info));
+    }
+    std::stable_sort(part_label_candidates.begin(), part_label_candidates.end(),
+                     [](const PartNameInfo& a, const PartNameInfo& b) { return a.priority > b.priority; });
+
+    // Greedy placement; a blocked name gets one try as a shorter "AB.." form
+    label_occupancy_cols = (window_width + kLabelCellPx - 1) / kLabelCellPx;
+    label_occupancy_rows = (window_height + kLabelCellPx - 1) / kLabelCellPx;
+    label_occupancy.assign(static_cast<size_t>(std::max(0, label_occupancy_cols)) * std::max(0, label_occupancy_rows), 0);
+    part_names_to_render.clear();
+    for (PartNameInfo& info : part_label_candidates) {
+        // Background box extends 1px left and right of the text
+        if (ClaimLabelCells(ImVec2(info.position.x - 1, info.position.y),
+                            ImVec2(info.position.x + info.size.x + 1, info.position.y + info.size.y))) {
+            part_names_to_render.push_back(std::move(info));
+            continue;
+        }
+        if (info.text.size() < 5) {
+            continue; // too short to abbreviate usefully
+        }
+        std::string abbreviated = info.text.substr(0, info.text.size() / 2) + "..";
+        ImVec2 short_size = ImGui::CalcTextSize(abbreviated.c_str());
+        ImVec2 short_pos(info.position.x + (info.size.x - short_size.x) * 0.5f, info.position.y);
+        if (ClaimLabelCells(ImVec2(short_pos.x - 1, short_pos.y),
+                            ImVec2(short_pos.x + short_size.x + 1, short_pos.y + short_size.y))) {
+            info.text = std::move(abbreviated);
+            info.position = short_pos;
+            info.size = short_size;
+            part_names_to_render.push_back(std::move(info));
+        }
+    }
+}
+
+void PCBRenderer::ResetLabelLayouts() {
+    label_layouts.clear();
+    label_lines.clear();
+    label_font = nullptr;
+    part_labels_valid = false;
+}
+
+void PCBRenderer::BreakLabelText(const std::string& text, float max_width, uint16_t& line_count) {
+    line_count = 0;
+    if (text.empty()) return;
+
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    float text_width = ImGui::CalcTextSize(begin, end).x;
+    if (text_width <= max_width) {
+        label_lines.push_back({begin, end, text_width});
+        line_count = 1;
+        return;
+    }
+
+    // Text is too wide, try to break it intelligently
+    while (begin < end) {
+        // Find the longest prefix that fits (widths grow with length)
+        size_t remaining = static_cast<size_t>(end - begin);
+        size_t best_break = 0;
+        size_t lo = 1, hi = remaining;
+        while (lo <= hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (ImGui::CalcTextSize(begin, begin + mid).x <= max_width) {
+                best_break = mid;
+                lo = mid + 1;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        if (best_break == 0) {
+            // Even single character doesn't fit, force break
+            best_break = 1;
+        }
+
+        // Try to break at a better position (space, underscore, etc.)
+        if (best_break < remaining) {
+            for (size_t j = best_break; j > 0; --j) {
+                char c = begin[j - 1];
+                if (c == '_' || c == '-' || c == '.' || c == ' ') {
+                    best_break = j;
+                    break;
+                }
+            }
+        }
+
+        const char* line_end = begin + best_break;
+        label_lines.push_back({begin, line_end, ImGui::CalcTextSize(begin, line_end).x});
+        line_count++;
+        begin = line_end;
+    }
+}
+
+const PCBRenderer::PinLabelLayout& PCBRenderer::GetPinLabelLayout(size_t pin_index, float max_text_width) {
+    PinLabelLayout& layout = label_layouts[pin_index];
+    if (layout.valid) return layout;
+
+    const BRDPin& pin = pcb_data->pins[pin_index];
+    layout.first_line = static_cast<uint32_t>(label_lines.size());
+    // Diode reading (pin comment), pin number, net name; in drawing order
+    BreakLabelText(pin.comment, max_text_width, layout.diode_lines);
+    BreakLabelText(pin.snum_id != kEmptyStringId ? pcb_data->PinSnum(pin) : pcb_data->PinName(pin), max_text_width, layout.pin_lines);
+    layout.net_lines = 0;
+    if (pin.net_id != kEmptyStringId && pin.net_id != kUnconnectedNetId) {
+        BreakLabelText(pcb_data->PinNet(pin), max_text_width, layout.net_lines);
     }
+    layout.valid = true;
+    return layout;
 }
 
-void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
     if (!pcb_data || pcb_data->pins.empty() || pin_geometry_cache.empty()) {
         return;
     }
@@ -2152,13 +2165,35 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
         return;
     }
 
-    for (size_t pin_index = 0; pin_index < pcb_data->pins.size() && pin_index < pin_geometry_cache.size(); ++pin_index) {
+    // Line breaks depend on the pad's pixel size, so layouts are kept per zoom
+    // bucket and laid out at the bucket's lower bound: they fit every zoom in it
+    int zoom_bucket = static_cast<int>(std::floor(std::log2(zoom) * kLabelZoomSteps));
+    const ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    if (font != label_font || font_size != label_font_size || zoom_bucket != label_zoom_bucket ||
+        label_layouts.size() != pcb_data->pins.size()) {
+        label_layouts.assign(pcb_data->pins.size(), PinLabelLayout());
+        label_lines.clear();
+        label_font = font;
+        label_font_size = font_size;
+        label_zoom_bucket = zoom_bucket;
+    }
+    const float layout_zoom = std::exp2(static_cast<float>(zoom_bucket) / kLabelZoomSteps);
+    const float line_height = ImGui::GetTextLineHeight();
+    const float text_spacing = 2.0f;
+
+    const ImU32 diode_color = IM_COL32((int)(settings.diode_text_color.r*255),(int)(settings.diode_text_color.g*255),(int)(settings.diode_text_color.b*255),255);
+    const ImU32 pin_color = IM_COL32((int)(settings.pin_text_color.r*255),(int)(settings.pin_text_color.g*255),(int)(settings.pin_text_color.b*255),255);
+    const ImU32 net_color = IM_COL32((int)(settings.net_text_color.r*255),(int)(settings.net_text_color.g*255),(int)(settings.net_text_color.b*255),255);
+
+    // Labels are drawn inside their pad: only pins whose pad overlaps the view
+    pin_label_grid.Query(view_world, visible_items);
+    for (uint32_t pin_index : visible_items) {
         const auto& pin = pcb_data->pins[pin_index];
         const auto& cache = pin_geometry_cache[pin_index];
-        
-        // Early visibility culling for pins
-        float approx_radius = cache.radius > 0 ? cache.radius : 10.0f;
-        if (!IsElementVisible(pin.pos.x, pin.pos.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
+
+        // Skip if no pin number available
+        if (pin.snum_id == kEmptyStringId && pin.name_id == kEmptyStringId) {
             continue;
         }
         
@@ -2169,35 +2204,33 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
     float x = px * zoom + offset_x;
     float y = offset_y - py * zoom;
         
-        // Calculate pin dimensions using cached geometry data
-        float pin_width = 0.0f, pin_height = 0.0f;
+        // Pad dimensions in world units, using cached geometry data
+        float pad_width = 0.0f, pad_height = 0.0f;
         
         if (cache.rectangle_index != SIZE_MAX) {
             // Rectangle pin
             const auto& rect = pcb_data->rectangles[cache.rectangle_index];
-            pin_width = rect.width * zoom;
-            pin_height = rect.height * zoom;
+            pad_width = rect.width;
+            pad_height = rect.height;
         } else if (cache.oval_index != SIZE_MAX) {
             // Oval pin
             const auto& oval = pcb_data->ovals[cache.oval_index];
-            pin_width = oval.width * zoom;
-            pin_height = oval.height * zoom;
+            pad_width = oval.width;
+            pad_height = oval.height;
         } else if (cache.circle_index != SIZE_MAX) {
             // Circle pin
             const auto& circle = pcb_data->circles[cache.circle_index];
-            float radius = circle.radius * zoom;
-            pin_width = radius * 2.0f;
-            pin_height = radius * 2.0f;
+            pad_width = circle.radius * 2.0f;
+            pad_height = circle.radius * 2.0f;
         } else {
             // Fallback using cached radius
-            float radius = cache.radius * zoom;
-            pin_width = radius * 2.0f;
-            pin_height = radius * 2.0f;
+            pad_width = cache.radius * 2.0f;
+            pad_height = cache.radius * 2.0f;
         }
         
         // Ensure minimum visibility for all pin types
-        if (pin_width < 2.0f) pin_width = 2.0f;
-        if (pin_height < 2.0f) pin_height = 2.0f;
+        float pin_width = std::max(pad_width * zoom, 2.0f);
+        float pin_height = std::max(pad_height * zoom, 2.0f);
         
         // Calculate effective area for text fitting (use smaller dimension)
         float effective_size = std::min(pin_width, pin_height);
@@ -2207,110 +2240,22 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             continue;
         }
         
-        // Get pin number
-        std::string pin_number = "";
-        if (!pin.snum.empty()) {
-            pin_number = pin.snum;
-        } else if (!pin.name.empty()) {
-            pin_number = pin.name;
-        }
-        
-        // Get diode reading from pin comment
-        std::string diode_reading = "";
-        if (!pin.comment.empty()) {
-            diode_reading = pin.comment;
-        }
-        
-        // Get net name (prefer meaningful names)
-        std::string net_name = "";
-        if (!pin.net.empty() && pin.net != "UNCONNECTED" && pin.net != "") {
-            if (pin.net.substr(0, 4) != "NET_") {
-                net_name = pin.net;  // Meaningful names (VCC, GND, etc.)
-            } else {
-                net_name = pin.net;  // Show generic NET_ names too
-            }
-        }
-        
-        // Skip if no pin number available
-        if (pin_number.empty()) {
-            continue;
-        }
-        
-    // (Removed unused base text size calculations; dynamic line wrapping below recalculates sizes as needed)
-        
         // Calculate maximum text dimensions that fit in pin area (with margin)
-        float max_text_width = pin_width * 0.95f;   // Use ~95% of pin width for text
         float max_text_height = pin_height * 0.95f; // Use ~95% of pin height for text
-        
-        // Helper function to break text into multiple lines if needed
-        auto breakTextIntoLines = [&](const std::string& text, float max_width) -> std::vector<std::string> {
-            std::vector<std::string> lines;
-            if (text.empty()) return lines;
-            
-            ImVec2 text_size = ImGui::CalcTextSize(text.c_str());
-            if (text_size.x <= max_width) {
-                lines.push_back(text);
-                return lines;
-            }
-            
-            // Text is too wide, try to break it intelligently
-            std::string remaining = text;
-            while (!remaining.empty()) {
-                // Find the longest substring that fits
-                size_t best_break = 0;
-                for (size_t i = 1; i <= remaining.length(); ++i) {
-                    std::string substr = remaining.substr(0, i);
-                    ImVec2 substr_size = ImGui::CalcTextSize(substr.c_str());
-                    if (substr_size.x <= max_width) {
-                        best_break = i;
-                    } else {
-                        break;
-                    }
-                }
-                
-                if (best_break == 0) {
-                    // Even single character doesn't fit, force break
-                    best_break = 1;
-                }
-                
-                // Try to break at a better position (space, underscore, etc.)
-                if (best_break < remaining.length()) {
-                    size_t last_good_break = best_break;
-                    for (size_t j = best_break; j > 0; --j) {
-                        char c = remaining[j-1];
-                        if (c == '_' || c == '-' || c == '.' || c == ' ') {
-                            last_good_break = j;
-                            break;
-                        }
-                    }
-                    best_break = last_good_break;
-                }
-                
-                lines.push_back(remaining.substr(0, best_break));
-                remaining = remaining.substr(best_break);
-            }
-            
-            return lines;
-        };
-        
-        // Break texts into lines if needed
-        std::vector<std::string> pin_lines = breakTextIntoLines(pin_number, max_text_width);
-        std::vector<std::string> net_lines = breakTextIntoLines(net_name, max_text_width);
-        std::vector<std::string> diode_lines = breakTextIntoLines(diode_reading, max_text_width);
+        const PinLabelLayout& layout = GetPinLabelLayout(pin_index, pad_width * layout_zoom * 0.95f);
         
         // Calculate total heights for multiline text
-        float pin_text_height = pin_lines.empty() ? 0.0f : pin_lines.size() * ImGui::GetTextLineHeight();
-        float net_text_height = net_lines.empty() ? 0.0f : net_lines.size() * ImGui::GetTextLineHeight();
-        float diode_text_height = diode_lines.empty() ? 0.0f : diode_lines.size() * ImGui::GetTextLineHeight();
+        float pin_text_height = layout.pin_lines * line_height;
+        float net_text_height = layout.net_lines * line_height;
+        float diode_text_height = layout.diode_lines * line_height;
         
         // Check if texts fit within the pin
-        bool show_pin_text = !pin_lines.empty() && pin_text_height <= max_text_height;
-        bool show_net_text = !net_lines.empty() && net_text_height <= max_text_height;
-    bool show_diode_text = settings.show_diode_readings && !diode_lines.empty() && diode_text_height <= max_text_height;
+        bool show_pin_text = layout.pin_lines > 0 && pin_text_height <= max_text_height;
+        bool show_net_text = layout.net_lines > 0 && net_text_height <= max_text_height;
+    bool show_diode_text = settings.show_diode_readings && layout.diode_lines > 0 && diode_text_height <= max_text_height;
         
         // If we have multiple texts, check if they fit stacked vertically
         // Priority: diode reading (top), pin number (middle), net name (bottom)
-        float text_spacing = 2.0f;
     if (show_diode_text && show_pin_text && show_net_text) {
             float total_text_height = diode_text_height + pin_text_height + net_text_height + 2 * text_spacing;
             if (total_text_height > max_text_height) {
@@ -2330,6 +2275,8 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             if (total_text_height > max_text_height) {
                 show_net_text = false; // Drop net text if doesn't fit with pin
             }
+        } else if (show_diode_text) {
+            show_net_text = false; // Without the pin number only the diode reading is shown
         }
         
         // Skip if no text will be shown
@@ -2337,9 +2284,6 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             continue;
         }
         
-        // Position text centered on pin location
-        ImVec2 text_pos;
-        
         // Clip text rendering to pin area to ensure it stays inside
         float half_width = pin_width * 0.5f;
         float half_height = pin_height * 0.5f;
@@ -2349,117 +2293,27 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             true
         );
         
-        if (show_diode_text && show_pin_text && show_net_text) {
-            // All three texts - stack them vertically: diode (top), pin (middle), net (bottom)
-            float text_spacing = 2.0f;
-            float total_text_height = diode_text_height + pin_text_height + net_text_height + 2 * text_spacing;
-            
-            // Position diode reading lines at TOP (theme-controlled color)
-            float current_y = y - total_text_height * 0.5f;
-            for (const auto& line : diode_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 diode_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(diode_text_pos, IM_COL32((int)(settings.diode_text_color.r*255),(int)(settings.diode_text_color.g*255),(int)(settings.diode_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-            
-            current_y += text_spacing;
-            
-            // Position pin number lines in MIDDLE (theme-controlled color)
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32((int)(settings.pin_text_color.r*255),(int)(settings.pin_text_color.g*255),(int)(settings.pin_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-            
-            current_y += text_spacing;
-            
-            // Position net name lines at BOTTOM (theme-controlled color)
-            for (const auto& line : net_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 net_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(net_text_pos, IM_COL32((int)(settings.net_text_color.r*255),(int)(settings.net_text_color.g*255),(int)(settings.net_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-        }
-    else if (show_diode_text && show_pin_text) {
-            // Diode and pin texts - stack them vertically: diode (top), pin (bottom)
-            float text_spacing = 2.0f;
-            float total_text_height = diode_text_height + pin_text_height + text_spacing;
-            
-            // Position diode reading lines at TOP (theme-controlled color)
-            float current_y = y - total_text_height * 0.5f;
-            for (const auto& line : diode_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 diode_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(diode_text_pos, IM_COL32((int)(settings.diode_text_color.r*255),(int)(settings.diode_text_color.g*255),(int)(settings.diode_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-            
-            current_y += text_spacing;
-            
-            // Position pin number lines at BOTTOM (theme-controlled color)
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32((int)(settings.pin_text_color.r*255),(int)(settings.pin_text_color.g*255),(int)(settings.pin_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-        }
-        else if (show_pin_text && show_net_text) {
-            // Both texts - stack them vertically
-            float text_spacing = 2.0f;
-            float total_text_height = pin_text_height + net_text_height + text_spacing;
-            
-            // Position pin number lines at TOP of circle (theme-controlled color)
-            float current_y = y - total_text_height * 0.5f;
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32((int)(settings.pin_text_color.r*255),(int)(settings.pin_text_color.g*255),(int)(settings.pin_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
+        // Stack the shown texts vertically, centered on the pin: diode (top),
+        // pin number (middle), net name (bottom), each in its theme color
+        const LabelLine* lines = label_lines.data() + layout.first_line;
+        struct Section { bool show; const LabelLine* first; uint16_t count; ImU32 color; };
+        const Section sections[3] = {
+            {show_diode_text, lines, layout.diode_lines, diode_color},
+            {show_pin_text, lines + layout.diode_lines, layout.pin_lines, pin_color},
+            {show_net_text, lines + layout.diode_lines + layout.pin_lines, layout.net_lines, net_color},
+        };
+        float total_text_height = -text_spacing;
+        for (const Section& section : sections) {
+            if (section.show) total_text_height += section.count * line_height + text_spacing;
+        }
+        float current_y = y - total_text_height * 0.5f;
+        for (const Section& section : sections) {
+            if (!section.show) continue;
+            for (const LabelLine* line = section.first; line != section.first + section.count; ++line) {
+                draw_list->AddText(ImVec2(x - line->width * 0.5f, current_y), section.color, line->begin, line->end);
+                current_y += line_height;
             }
-            
             current_y += text_spacing;
-            
-            // Position net name lines at BOTTOM of circle (theme-controlled color)
-            for (const auto& line : net_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 net_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(net_text_pos, IM_COL32((int)(settings.net_text_color.r*255),(int)(settings.net_text_color.g*255),(int)(settings.net_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-        }
-    else if (show_diode_text) {
-            // Only diode reading - center it (theme-controlled color)
-            float current_y = y - diode_text_height * 0.5f;
-            for (const auto& line : diode_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 diode_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(diode_text_pos, IM_COL32((int)(settings.diode_text_color.r*255),(int)(settings.diode_text_color.g*255),(int)(settings.diode_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-        }
-        else if (show_pin_text) {
-            // Only pin number - center it (theme-controlled color)
-            float current_y = y - pin_text_height * 0.5f;
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32((int)(settings.pin_text_color.r*255),(int)(settings.pin_text_color.g*255),(int)(settings.pin_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
-        }
-        else if (show_net_text) {
-            // Only net name - center it (theme-controlled color)
-            float current_y = y - net_text_height * 0.5f;
-            for (const auto& line : net_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
-                ImVec2 net_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(net_text_pos, IM_COL32((int)(settings.net_text_color.r*255),(int)(settings.net_text_color.g*255),(int)(settings.net_text_color.b*255),255), line.c_str());
-                current_y += ImGui::GetTextLineHeight();
-            }
         }
         
         // Restore clipping
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "BRDFileBase.h"
+#include "SpatialGrid.h"
+#include "PadBatchRenderer.h"
+#include "ArcTessellator.h"
 #include <GL/glew.h>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <imgui.h>
 // Forward-declare to avoid heavy include in header
 struct PCBThemeSpec;
@@ -34,6 +39,7 @@ struct RenderSettings {
     float pin_alpha = 1.0f;
     float outline_alpha = 1.0f;
     float part_outline_alpha = 1.0f;
+    float trace_alpha = 0.7f;
     
     struct {
         float r = 0.2f, g = 0.8f, b = 0.2f;  // Green
@@ -50,6 +56,10 @@ struct RenderSettings {
     struct {
         float r = 1.0f, g = 1.0f, b = 1.0f;  // White
     } part_outline_color;
+
+    struct {
+        float r = 0.72f, g = 0.45f, b = 0.2f;  // Copper
+    } trace_color;
     // Pin override colors for special cases and net highlighting
     struct {
         float r = 1.0f, g = 1.0f, b = 0.0f; // Yellow for same-net highlight
@@ -86,6 +96,14 @@ struct RenderSettings {
     struct { float r = 0.0f, g = 1.0f, b = 1.0f; } diode_text_color; // diode reading text
     struct { float r = 1.0f, g = 1.0f, b = 1.0f; } component_name_text_color; // part name text
     struct { float r = 0.0f, g = 0.0f, b = 0.0f; float a = 0.5f; } component_name_bg_color; // part name bg
+
+    // Level of detail thresholds, in screen pixels. Pads narrower than
+    // lod_pad_point_px are drawn as dots, pad outlines are dropped below
+    // lod_pad_outline_px, and part outlines smaller than lod_part_box_px are
+    // drawn as their bounding box
+    float lod_pad_point_px = 3.0f;
+    float lod_pad_outline_px = 4.0f;
+    float lod_part_box_px = 12.0f;
 };
 
 // Predefined color themes
@@ -95,15 +113,15 @@ enum class ColorTheme {
     HighContrast = 2,
 };
 
-// Structure to hold part name rendering information
+// Structure to hold part name rendering information (colors come from the
+// theme when drawn, so placements survive theme changes)
 struct PartNameInfo {
     ImVec2 position;
     ImVec2 size;
     std::string text;
-    ImU32 color;
     ImVec2 clip_min;
     ImVec2 clip_max;
-    ImU32 background_color;
+    float priority = 0.0f; // placement order, highest first
 };
 
 // Structure to hold pin number rendering information
@@ -129,16 +147,28 @@ public:
     
     void SetPCBData(std::shared_ptr<BRDFileBase> pcb_data);
     void Render(int window_width, int window_height);
+    // Puts the board drawn by the last Render() under the frame's ImGui output;
+    // call between ImGui::Render() and the backend's RenderDrawData()
+    void SubmitScene(ImDrawData* draw_data);
+    // Whether Render() would re-emit the board, i.e. the view, selection or
+    // settings changed since the last frame; callable outside an ImGui frame
+    bool NeedsRedraw(int window_width, int window_height) const;
+    // Forces the next Render() to re-emit the board and re-layout pin labels
+    // (e.g. after editing pcb_data in place)
+    void InvalidateScene() { scene_dirty = true; ResetLabelLayouts(); }
+    // Number of times the board geometry has been re-emitted
+    uint64_t GetSceneBuildCount() const { return scene_builds; }
     
     // ImGui-based rendering methods (like original OpenBoardView)
     void RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
     void RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
-    void RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
-    void RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
-    void RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void RenderTracesImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
+    void RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
+    void RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
+    void RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
     void RenderPartNamesOnTop(ImDrawList* draw_list);  // Render collected part names on top
-    void RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height); // Render pin numbers as text overlays
-    void CollectPartNamesForRendering(float zoom, float offset_x, float offset_y); // Collect part names for rendering
+    void RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y); // Render pin numbers as text overlays
+    void CollectPartNamesForRendering(float zoom, float offset_x, float offset_y, int window_width, int window_height); // Place non-overlapping part names (kept while the view is unchanged)
     void RenderPartHighlighting(ImDrawList* draw_list, float zoom, float offset_x, float offset_y); // Render part highlighting on top
     void RenderRatsnetImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height); // Render ratsnet/airwires
     
@@ -172,6 +202,11 @@ public:
     void SetHighlightedNet(const std::string &net) { highlighted_net = net; }
     void ClearHighlightedNet() { highlighted_net.clear(); }
     const std::string &GetHighlightedNet() const { return highlighted_net; }
+
+    // Copper layer visibility: position is 1-based into the board's
+    // trace_layers (layer order), -1 shows every layer
+    void SetLayerFilter(int position) { layer_filter = position; }
+    int GetLayerFilter() const { return layer_filter; }
     void SetHighlightedPart(int partIndex) { highlighted_part_index = partIndex; }
     void ClearHighlightedPart() { highlighted_part_index = -1; }
     int GetHighlightedPart() const { return highlighted_part_index; }
@@ -188,6 +223,11 @@ public:
     // Non-destructive hit-test for parts: returns part index or -1
     int HitTestPart(float screen_x, float screen_y, int window_width, int window_height) const;
     
+    // Draw pads with the instanced GL 3.3 renderer instead of ImDrawList; needs the
+    // GL context current. Returns whether the GPU path is active (false on GL2)
+    bool SetGpuPadsEnabled(bool enabled);
+    bool IsGpuPadsEnabled() const { return pad_batch.IsReady(); }
+
     // Settings
     RenderSettings& GetSettings() { return settings; }
     const Camera& GetCamera() const { return camera; }
@@ -199,10 +239,36 @@ public:
     void ApplyTheme(const PCBThemeSpec& spec, bool setBaseFromSpec = true);
 
 private:
-    // OpenGL objects
-    GLuint shader_program = 0;
-    GLuint vao = 0;
-    GLuint vbo = 0;
+    // Retained board geometry. Everything the scene depends on besides the
+    // board data is in SceneKey; data and backend changes set scene_dirty
+    struct SceneKey {
+        int width = 0, height = 0;
+        Camera camera;
+        int selected_pin = -1;
+        int highlighted_part = -1;
+        std::string highlighted_net;
+        int layer_filter = -1;
+        RenderSettings settings; // compared bytewise
+        const ImFont* font = nullptr;
+        float font_size = 0.0f;
+        ImTextureID font_texture = ImTextureID();
+    };
+    static_assert(std::is_trivially_copyable<RenderSettings>::value, "SceneKey compares RenderSettings with memcmp");
+    // with_font=false keeps the last frame's font fields (no ImGui frame needed)
+    SceneKey CurrentSceneKey(int window_width, int window_height, bool with_font = true) const;
+    static bool SameScene(const SceneKey& a, const SceneKey& b);
+    void EmitScene(ImDrawList* draw_list, int window_width, int window_height);
+    std::unique_ptr<ImDrawList> scene_list;
+    SceneKey scene_key;
+    bool scene_dirty = true;
+    bool scene_pending = false; // Render() produced a scene this frame
+    uint64_t scene_builds = 0;
+
+    // GPU pad path: instances are rebuilt lazily in Render (context current) after
+    // new data; frame params are filled per frame and read by the draw callback
+    PadBatchRenderer pad_batch;
+    bool pad_batch_dirty = true;
+    PadBatchRenderer::FrameParams pad_frame;
     
     // Data
     std::shared_ptr<BRDFileBase> pcb_data;
@@ -224,19 +290,122 @@ private:
         bool is_nc = false;
     };
     std::vector<PinGeometryCache> pin_geometry_cache;
+
+    // Pad fill class per pin, so the pad loops do no per-shape lookups.
+    // Base classes come from BuildPinGeometryCache; SameNet is moved between
+    // nets only when the highlighted net changes
+    enum class PinColorClass : uint8_t { Default, SameNet, NoConnect, Ground };
+    std::vector<PinColorClass> pin_color_class;
+    uint32_t pin_color_class_net = StringPool::kInvalid; // net currently marked SameNet
+
+    // Per-part bounds (pin centers grown by edge pads' extents, unrotated
+    // world units), built with the geometry cache; indexed by 0-based part
+    struct PartExtent {
+        float min_x = 0.f, min_y = 0.f, max_x = 0.f, max_y = 0.f;
+        bool valid = false; // false for parts without pins
+    };
+    std::vector<PartExtent> part_extents;
+
+    // Hit-test indexes over pad extents (hoverable pins only) and part extents,
+    // in unrotated world units; rebuilt with the geometry cache
+    SpatialGrid pin_grid;
+    SpatialGrid part_grid;
+    // Culling tiles for pin labels: the same pad extents, over every pin
+    SpatialGrid pin_label_grid;
+
+    // Culling tiles over every drawn primitive, in unrotated world units.
+    // Each frame queries them with the visible world rectangle (view_world)
+    SpatialGrid circle_grid;
+    SpatialGrid rectangle_grid;
+    SpatialGrid oval_grid;
+    SpatialGrid outline_grid;
+    SpatialGrid part_outline_grid; // over part_outline_groups
+    std::vector<SpatialGrid> trace_grids; // per trace layer, over its segments
+    SpatialGrid outline_arc_grid;
+    std::vector<SpatialGrid> trace_arc_grids; // per trace layer, over its arcs
+    SpatialGrid::Box view_world;
+    std::vector<uint32_t> visible_items; // scratch for grid queries
+    std::vector<const BRDTrace*> highlighted_traces; // drawn after the other traces
+    std::vector<std::pair<uint32_t, uint32_t>> highlighted_arcs; // (layer, arc)
+
+    // Arcs are tessellated per zoom bucket when first drawn (see ArcTessellator)
+    ArcTessellator outline_arc_tess;
+    std::vector<ArcTessellator> trace_arc_tess; // per trace layer
+    std::vector<ImVec2> arc_screen_points; // scratch
+    void DrawArc(ImDrawList* draw_list, ArcTessellator& tess, const BRDArc& arc, size_t index,
+                 float zoom, float offset_x, float offset_y, ImU32 color, float thickness);
+
+    // Runs of consecutive, touching part outline segments (one per part in
+    // practice), so tiny parts can be drawn as a single box
+    struct OutlineGroup {
+        uint32_t first = 0, last = 0; // segment range [first, last)
+        SpatialGrid::Box bounds;
+    };
+    std::vector<OutlineGroup> part_outline_groups;
+
+    // LOD dots: at most one dot per color per 2x2 pixel cell each frame
+    std::vector<ImU32> lod_dot_color;
+    std::vector<uint32_t> lod_dot_frame;
+    uint32_t lod_frame = 0;
+    int lod_dot_cols = 0, lod_dot_rows = 0;
     
     // Part name rendering (collected during rendering, drawn on top)
     std::vector<PartNameInfo> part_names_to_render;
+
+    // Part name placement: candidates are placed greedily, highest priority
+    // first (selected part, then larger parts), into a screen-space occupancy
+    // grid; a name that collides is abbreviated or dropped. The placement is
+    // reused while the view, font and selected part stay the same
+    struct PartLabelKey {
+        int width = 0, height = 0;
+        Camera camera;
+        const ImFont* font = nullptr;
+        float font_size = 0.0f;
+        int priority_part = -1;
+    };
+    static constexpr int kLabelCellPx = 4;
+    PartLabelKey part_label_key;
+    bool part_labels_valid = false;
+    std::vector<PartNameInfo> part_label_candidates;
+    std::vector<uint8_t> label_occupancy; // one byte per kLabelCellPx cell
+    int label_occupancy_cols = 0, label_occupancy_rows = 0;
+    // Claims the cells under [min, max) unless one is taken already
+    bool ClaimLabelCells(const ImVec2& min, const ImVec2& max);
     
     // Pin number rendering (collected during rendering, drawn on top)
     std::vector<PinNumberInfo> pin_numbers_to_render;
 
-    // Shader compilation
-    bool CreateShaderProgram();
-    GLuint CompileShader(const char* source, GLenum type);
-    
+    // Pin label layout for RenderPinNumbersAsText: diode / pin number / net text
+    // broken into lines that fit the pad, measured once per zoom bucket and font.
+    // Lines point into the pins' strings, so no strings are built per frame
+    struct LabelLine {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        float width = 0.0f;
+    };
+    struct PinLabelLayout {
+        uint32_t first_line = 0; // into label_lines: diode, then pin, then net lines
+        uint16_t diode_lines = 0, pin_lines = 0, net_lines = 0;
+        bool valid = false;
+    };
+    static constexpr int kLabelZoomSteps = 8; // buckets per doubling of zoom
+    std::vector<PinLabelLayout> label_layouts; // per pin
+    std::vector<LabelLine> label_lines;
+    int label_zoom_bucket = 0;
+    const ImFont* label_font = nullptr; // nullptr: layouts need a reset
+    float label_font_size = 0.0f;
+    void ResetLabelLayouts();
+    // Layout of pin_index's labels wrapped to max_text_width (pixels at the
+    // bucket's zoom); computed on first use after a reset
+    const PinLabelLayout& GetPinLabelLayout(size_t pin_index, float max_text_width);
+    void BreakLabelText(const std::string& text, float max_width, uint16_t& line_count);
+
     // Utility helpers
     bool IsGroundNet(const std::string& net) const;
+    // Interned id of the highlighted net, else the selected pin's net (StringPool::kInvalid if none)
+    uint32_t ActiveNetId() const;
+    // ActiveNetId() minus unnamed and ground nets, which are never highlighted
+    uint32_t HighlightNetId() const;
     
     // Rendering methods
     void RenderBackground();
@@ -245,13 +414,26 @@ private:
     void RenderPins();
     // Enhanced rendering methods
     void RenderPartOutline(const BRDPart& part, const std::vector<BRDPin>& part_pins);
-    float DeterminePinMargin(const BRDPart& part, const std::vector<BRDPin>& part_pins, float distance);
+    float DeterminePinMargin(const BRDPart& part, size_t part_pin_count, float distance);
     float DeterminePinSize(const BRDPart& part, const std::vector<BRDPin>& part_pins);
     void RenderGenericComponentOutline(float min_x, float min_y, float max_x, float max_y, float margin);
     void RenderConnectorComponentImGui(ImDrawList* draw_list, const BRDPart& part, const std::vector<BRDPin>& part_pins, float zoom, float offset_x, float offset_y);
     
     // Performance optimization methods
     void BuildPinGeometryCache();
+    void BuildPartExtents();
+    void BuildHitTestGrids();
+    void BuildRenderGrids();
+    void UpdateViewWorld(int window_width, int window_height);
+    void BeginLodFrame(int window_width, int window_height);
+    void DrawPadDot(ImDrawList* draw_list, float x, float y, float size_px, ImU32 color);
+    void UpdatePadFrame(int window_width, int window_height, float zoom, float offset_x, float offset_y);
+    static void DrawPadBatchCallback(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+    bool PinContainsPoint(size_t pin_idx, float world_x, float world_y) const; // exact pad shape test
+    void RefreshPinColorClasses();
+    // Overrides a pad's own color with its pin's class color; no-op for pads without a pin
+    void ApplyPinColorClass(uint32_t pin_idx, float& r, float& g, float& b, float& a) const;
+    int FindPartAt(float world_x, float world_y) const; // unrotated world coords; -1 if none
     bool IsElementVisible(float x, float y, float radius, float zoom, float offset_x, float offset_y, int window_width, int window_height);
     
     // Pin utilities
@@ -279,4 +461,5 @@ private:
     // Currently externally highlighted net (via dropdown search)
     std::string highlighted_net;
     int highlighted_part_index = -1;
+    int layer_filter = -1;
 };
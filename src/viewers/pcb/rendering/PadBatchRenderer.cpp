@@ -0,0 +1,301 @@
+#include "PadBatchRenderer.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+const char* pad_vertex_shader_source = R"(
+#version 330 core
+layout (location = 0) in vec2 a_corner;   // unit quad corner, -1..1
+layout (location = 1) in vec2 a_center;
+layout (location = 2) in vec2 a_half;
+layout (location = 3) in float a_rotation;
+layout (location = 4) in uvec3 a_info;    // shape, net, pin class
+layout (location = 5) in vec4 a_color;
+
+uniform mat2 u_linear;
+uniform vec2 u_translate;
+uniform float u_zoom;
+uniform uint u_highlight_net;
+uniform vec4 u_same_net_color;
+uniform vec4 u_nc_color;
+uniform vec4 u_ground_color;
+uniform vec4 u_pin_color;
+uniform bool u_override_pin_colors;
+uniform float u_point_px;
+uniform float u_outline_px;
+
+out vec2 v_local;
+flat out vec2 v_half;
+flat out uint v_shape;
+flat out vec4 v_color;
+flat out float v_outline;
+
+void main() {
+    uint shape = a_info.x;
+    vec2 half_size = a_half;
+    float rotation = a_rotation;
+
+    // Circles keep at least a one pixel radius, as in the ImDrawList path
+    if (shape == 0u) half_size = max(half_size, vec2(1.0 / u_zoom));
+
+    // LOD: pads below the point threshold become axis-aligned square dots
+    float pad_px = 2.0 * max(half_size.x, half_size.y) * u_zoom;
+    bool dot = pad_px < u_point_px;
+    if (dot) {
+        shape = 1u;
+        half_size = vec2(max(pad_px, 1.0) * 0.5 / u_zoom);
+        rotation = 0.0;
+    }
+
+    // One pixel of margin for the anti-aliased edge
+    vec2 local = a_corner * (half_size + vec2(1.0 / u_zoom));
+    float c = cos(rotation), s = sin(rotation);
+    vec2 world = a_center + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    gl_Position = vec4(u_linear * world + u_translate, 0.0, 1.0);
+
+    v_local = local;
+    v_half = half_size;
+    v_shape = shape;
+    v_outline = (!dot && pad_px >= u_outline_px) ? 1.0 : 0.0;
+
+    // Same precedence as PCBRenderer::ApplyPinColorClass
+    uint pin_class = a_info.z;
+    if (pin_class != 0u && a_info.y == u_highlight_net) v_color = u_same_net_color;
+    else if (pin_class == 2u) v_color = u_nc_color;
+    else if (pin_class == 3u) v_color = u_ground_color;
+    else if (pin_class == 1u && u_override_pin_colors) v_color = u_pin_color;
+    else v_color = a_color;
+}
+)";
+
+const char* pad_fragment_shader_source = R"(
+#version 330 core
+in vec2 v_local;
+flat in vec2 v_half;
+flat in uint v_shape;
+flat in vec4 v_color;
+flat in float v_outline;
+
+uniform float u_zoom;
+
+out vec4 FragColor;
+
+float PadDistance(vec2 p, vec2 h) {
+    if (v_shape == 0u) return length(p) - h.x;
+    vec2 q = abs(p);
+    if (v_shape == 1u) {
+        vec2 d = q - h;
+        return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+    }
+    // Oval: stadium along its longer axis
+    float r = min(h.x, h.y);
+    if (h.x >= h.y) q.x = max(q.x - (h.x - r), 0.0);
+    else q.y = max(q.y - (h.y - r), 0.0);
+    return length(q) - r;
+}
+
+void main() {
+    float d = PadDistance(v_local, v_half) * u_zoom; // pixels, negative inside
+    float coverage = clamp(0.5 - d, 0.0, 1.0);
+    if (coverage <= 0.0) discard;
+
+    // One pixel darker outline, like the ImDrawList path's AddCircle/AddQuad
+    vec4 color = v_color;
+    if (v_outline > 0.5 && d > -1.0) color = vec4(v_color.rgb * (180.0 / 255.0), 1.0);
+    FragColor = vec4(color.rgb, color.a * coverage);
+}
+)";
+
+GLuint CompilePadShader(const char* source, GLenum type) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetShaderInfoLog(shader, 512, nullptr, info_log);
+        LOG_ERROR("Pad shader compilation failed: " + std::string(info_log));
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+uint8_t ToByte(float v) {
+    return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f);
+}
+
+} // namespace
+
+PadBatchRenderer::~PadBatchRenderer() {
+    Shutdown();
+}
+
+bool PadBatchRenderer::Initialize() {
+    Shutdown();
+    if (!GLEW_VERSION_3_3) {
+        LOG_INFO("GL 3.3 not available; pads use the ImDrawList path");
+        return false;
+    }
+
+    GLuint vertex_shader = CompilePadShader(pad_vertex_shader_source, GL_VERTEX_SHADER);
+    if (!vertex_shader) return false;
+    GLuint fragment_shader = CompilePadShader(pad_fragment_shader_source, GL_FRAGMENT_SHADER);
+    if (!fragment_shader) {
+        glDeleteShader(vertex_shader);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    glLinkProgram(program);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetProgramInfoLog(program, 512, nullptr, info_log);
+        LOG_ERROR("Pad shader program linking failed: " + std::string(info_log));
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+
+    uniforms.linear = glGetUniformLocation(program, "u_linear");
+    uniforms.translate = glGetUniformLocation(program, "u_translate");
+    uniforms.zoom = glGetUniformLocation(program, "u_zoom");
+    uniforms.highlight_net = glGetUniformLocation(program, "u_highlight_net");
+    uniforms.same_net_color = glGetUniformLocation(program, "u_same_net_color");
+    uniforms.nc_color = glGetUniformLocation(program, "u_nc_color");
+    uniforms.ground_color = glGetUniformLocation(program, "u_ground_color");
+    uniforms.pin_color = glGetUniformLocation(program, "u_pin_color");
+    uniforms.override_pin_colors = glGetUniformLocation(program, "u_override_pin_colors");
+    uniforms.point_px = glGetUniformLocation(program, "u_point_px");
+    uniforms.outline_px = glGetUniformLocation(program, "u_outline_px");
+
+    // Unit quad as a triangle strip, then the per-instance attributes
+    static const float quad[8] = {-1.f, -1.f, 1.f, -1.f, -1.f, 1.f, 1.f, 1.f};
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glGenBuffers(1, &quad_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, quad_vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glGenBuffers(1, &instance_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    const GLsizei stride = sizeof(Instance);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, center));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, half_size));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, rotation));
+    glVertexAttribIPointer(4, 3, GL_UNSIGNED_INT, stride, (void*)offsetof(Instance, shape));
+    glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(Instance, color));
+    for (GLuint attrib = 1; attrib <= 5; ++attrib) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return true;
+}
+
+void PadBatchRenderer::Shutdown() {
+    if (instance_vbo) glDeleteBuffers(1, &instance_vbo);
+    if (quad_vbo) glDeleteBuffers(1, &quad_vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (program) glDeleteProgram(program);
+    instance_vbo = quad_vbo = vao = program = 0;
+    instance_count = 0;
+}
+
+void PadBatchRenderer::BuildInstances(const BRDFileBase& board, double origin_x, double origin_y, std::vector<Instance>& out) {
+    out.clear();
+    out.reserve(board.circles.size() + board.rectangles.size() + board.ovals.size());
+
+    auto add = [&](const BRDPoint& center, float half_w, float half_h, float rotation_deg, Shape shape,
+                   float r, float g, float b, float a, uint32_t pin_idx) {
+        Instance inst;
+        inst.center[0] = static_cast<float>(center.x - origin_x);
+        inst.center[1] = static_cast<float>(center.y - origin_y);
+        inst.half_size[0] = half_w;
+        inst.half_size[1] = half_h;
+        inst.rotation = rotation_deg * 3.14159265f / 180.0f;
+        inst.shape = shape;
+        inst.net = StringPool::kInvalid;
+        inst.pin_class = kNoPin;
+        if (pin_idx < board.pin_columns.size()) {
+            inst.net = board.pin_columns.net[pin_idx];
+            uint8_t flags = board.NetFlagsOf(inst.net);
+            inst.pin_class = (flags & BRDFileBase::kNetNoConnect) ? kNoConnect
+                           : (flags & BRDFileBase::kNetGround) ? kGround : kDefault;
+        }
+        inst.color[0] = ToByte(r);
+        inst.color[1] = ToByte(g);
+        inst.color[2] = ToByte(b);
+        inst.color[3] = ToByte(a);
+        out.push_back(inst);
+    };
+
+    const auto& links = board.pad_links;
+    for (size_t i = 0; i < board.circles.size(); ++i) {
+        const auto& c = board.circles[i];
+        add(c.center, c.radius, c.radius, 0.0f, kCircle, c.r, c.g, c.b, c.a,
+            i < links.circle_pin.size() ? links.circle_pin[i] : BRDFileBase::kNoIndex);
+    }
+    for (size_t i = 0; i < board.rectangles.size(); ++i) {
+        const auto& rc = board.rectangles[i];
+        add(rc.center, rc.width * 0.5f, rc.height * 0.5f, rc.rotation, kRectangle, rc.r, rc.g, rc.b, rc.a,
+            i < links.rectangle_pin.size() ? links.rectangle_pin[i] : BRDFileBase::kNoIndex);
+    }
+    for (size_t i = 0; i < board.ovals.size(); ++i) {
+        const auto& o = board.ovals[i];
+        add(o.center, o.width * 0.5f, o.height * 0.5f, o.rotation, kOval, o.r, o.g, o.b, o.a,
+            i < links.oval_pin.size() ? links.oval_pin[i] : BRDFileBase::kNoIndex);
+    }
+}
+
+void PadBatchRenderer::Upload(const std::vector<Instance>& instances) {
+    if (!IsReady()) return;
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Instance), instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    instance_count = instances.size();
+}
+
+void PadBatchRenderer::Draw(const FrameParams& params) const {
+    if (!IsReady() || instance_count == 0) return;
+
+    glUseProgram(program);
+    glUniformMatrix2fv(uniforms.linear, 1, GL_FALSE, params.linear);
+    glUniform2fv(uniforms.translate, 1, params.translate);
+    glUniform1f(uniforms.zoom, params.zoom);
+    glUniform1ui(uniforms.highlight_net, params.highlight_net);
+    glUniform4fv(uniforms.same_net_color, 1, params.same_net_color);
+    glUniform4fv(uniforms.nc_color, 1, params.nc_color);
+    glUniform4fv(uniforms.ground_color, 1, params.ground_color);
+    glUniform4fv(uniforms.pin_color, 1, params.pin_color);
+    glUniform1i(uniforms.override_pin_colors, params.override_pin_colors ? 1 : 0);
+    glUniform1f(uniforms.point_px, params.point_px);
+    glUniform1f(uniforms.outline_px, params.outline_px);
+
+    glEnable(GL_BLEND);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE); // flips mirror the quads
+
+    glBindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instance_count));
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
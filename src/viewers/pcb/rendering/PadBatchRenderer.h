@@ -0,0 +1,77 @@
+#pragma once
+
+#include "BRDFileBase.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+// Instanced GPU pad renderer. Every circle, rectangle and oval pad is one
+// instance in a static buffer, uploaded once per board, and is drawn as a quad
+// whose fragment shader evaluates the pad's signed distance function. Between
+// frames only a small uniform set changes (view transform, highlight net,
+// class colors, LOD thresholds). Needs a GL 3.3 core context; PCBRenderer keeps
+// its ImDrawList path for GL2 contexts.
+class PadBatchRenderer {
+public:
+    enum Shape : uint32_t { kCircle = 0, kRectangle = 1, kOval = 2 };
+    // Pin class of a pad; same-net highlighting is decided on the GPU from the net id
+    enum PinClass : uint32_t { kNoPin = 0, kDefault = 1, kNoConnect = 2, kGround = 3 };
+
+    struct Instance {
+        float center[2];    // world units relative to the batch origin
+        float half_size[2]; // circles: radius in both
+        float rotation;     // pad rotation, radians
+        uint32_t shape;
+        uint32_t net;       // interned net id, StringPool::kInvalid without a pin
+        uint32_t pin_class;
+        uint8_t color[4];   // the shape's own RGBA
+    };
+
+    // Per-frame state; the only data sent to the GPU after Upload()
+    struct FrameParams {
+        float linear[4] = {1.f, 0.f, 0.f, 1.f}; // column-major 2x2, origin-relative world -> NDC
+        float translate[2] = {0.f, 0.f};
+        float zoom = 1.0f;                      // pixels per world unit
+        uint32_t highlight_net = StringPool::kInvalid;
+        float same_net_color[4] = {1.f, 1.f, 0.f, 1.f};
+        float nc_color[4] = {0.f, 0.3f, 0.3f, 1.f};
+        float ground_color[4] = {0.376f, 0.376f, 0.376f, 1.f};
+        float pin_color[4] = {1.f, 1.f, 0.f, 1.f};
+        bool override_pin_colors = false;
+        float point_px = 3.0f;   // RenderSettings::lod_pad_point_px
+        float outline_px = 4.0f; // RenderSettings::lod_pad_outline_px
+    };
+
+    PadBatchRenderer() = default;
+    ~PadBatchRenderer();
+    PadBatchRenderer(const PadBatchRenderer&) = delete;
+    PadBatchRenderer& operator=(const PadBatchRenderer&) = delete;
+
+    // Compiles the shaders and creates the buffers in the current context;
+    // false (and nothing allocated) if GL 3.3 is not available
+    bool Initialize();
+    void Shutdown();
+    bool IsReady() const { return program != 0; }
+
+    // Circles, then rectangles, then ovals, each in index order (the ImDrawList
+    // draw order), centers relative to (origin_x, origin_y)
+    static void BuildInstances(const BRDFileBase& board, double origin_x, double origin_y, std::vector<Instance>& out);
+    void Upload(const std::vector<Instance>& instances);
+    size_t InstanceCount() const { return instance_count; }
+
+    // Draws all pads with the current GL state's framebuffer and viewport
+    void Draw(const FrameParams& params) const;
+
+private:
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint quad_vbo = 0;
+    GLuint instance_vbo = 0;
+    size_t instance_count = 0;
+
+    struct Uniforms {
+        GLint linear = -1, translate = -1, zoom = -1, highlight_net = -1;
+        GLint same_net_color = -1, nc_color = -1, ground_color = -1, pin_color = -1;
+        GLint override_pin_colors = -1, point_px = -1, outline_px = -1;
+    } uniforms;
+};
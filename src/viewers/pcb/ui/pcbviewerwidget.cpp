@@ -2,6 +2,7 @@
 #include "viewers/pcb/PCBViewerEmbedder.h"
 #include "../rendering/PCBRenderer.h" // for ColorTheme enum values
 #include "ui/LoadingOverlay.h"
+#include "ui/FrameClock.h"
 #include "core/memoryfilemanager.h"
 #include <QtConcurrent/QtConcurrent>
 #include <QFutureWatcher>
@@ -149,7 +150,6 @@ PCBViewerWidget::PCBViewerWidget(QWidget *parent)
     , m_mainLayout(nullptr)
     , m_toolbar(nullptr)
     , m_viewerContainer(nullptr)
-    , m_updateTimer(new QTimer(this))
     , m_viewerInitialized(false)
     , m_pcbLoaded(false)
     , m_usingFallback(false)
@@ -177,10 +177,10 @@ PCBViewerWidget::PCBViewerWidget(QWidget *parent)
     // Initialize the PCB viewer
     initializePCBViewer();
     
-    // Setup update timer
-    m_updateTimer->setSingleShot(false);
-    m_updateTimer->setInterval(16); // ~60 FPS
-    connect(m_updateTimer, &QTimer::timeout, this, &PCBViewerWidget::updateViewer);
+    // Frames are rendered on demand by the shared clock, only while dirty
+    FrameClock::instance()->addViewer(this,
+        [this]() { return m_framesActive && m_viewerInitialized && m_pcbEmbedder && m_pcbEmbedder->needsRender(); },
+        [this]() { updateViewer(); });
     
     WritePCBDebugToFile("PCBViewerWidget constructor completed");
 }
@@ -189,10 +189,8 @@ PCBViewerWidget::~PCBViewerWidget()
 {
     WritePCBDebugToFile("PCBViewerWidget destructor");
     
-    // Stop update timer
-    if (m_updateTimer) {
-        m_updateTimer->stop();
-    }
+    // Stop rendering
+    FrameClock::instance()->removeViewer(this);
     
     // Clean up PCB embedder
     if (m_pcbEmbedder) {
@@ -225,13 +223,10 @@ bool PCBViewerWidget::loadPCB(const QString &filePath)
         m_pcbLoaded = true;
         m_currentFilePath = filePath;
         updateLayerBarVisibility();
-        if (m_pcbEmbedder) m_pcbEmbedder->setLayerFilter(-1);
+        resetLayerFilter();
         populateNetAndComponentList();
         
-        // Start update timer if not already running
-        if (!m_updateTimer->isActive()) {
-            m_updateTimer->start();
-        }
+        setFramesActive(true);
         
         WritePCBDebugToFile("PCB file loaded successfully");
         emit pcbLoaded(filePath);
@@ -278,11 +273,10 @@ bool PCBViewerWidget::loadPCBFromMemory(const QString& memoryId, const QString&
     if (success) {
         m_pcbLoaded = true;
         m_currentFilePath = memoryId; // Store memory ID as current file path
+        updateLayerBarVisibility();
+        resetLayerFilter();
         
-        // Start update timer if not already running
-        if (!m_updateTimer->isActive()) {
-            m_updateTimer->start();
-        }
+        setFramesActive(true);
         
         WritePCBDebugToFile("PCB file loaded successfully from memory");
         emit pcbLoaded(displayName);
@@ -346,10 +340,7 @@ void PCBViewerWidget::closePCB()
 {
     WritePCBDebugToFile("Closing PCB");
     
-    // Stop update timer
-    if (m_updateTimer->isActive()) {
-        m_updateTimer->stop();
-    }
+    setFramesActive(false);
     
     // Close PCB in embedder
     if (m_pcbEmbedder) {
@@ -447,6 +438,14 @@ void PCBViewerWidget::updateViewer()
     m_isUpdating = false;
 }
 
+void PCBViewerWidget::setFramesActive(bool active)
+{
+    m_framesActive = active;
+    if (active) {
+        FrameClock::instance()->requestFrame(this);
+    }
+}
+
 // Protected event handlers
 
 void PCBViewerWidget::resizeEvent(QResizeEvent *event)
@@ -472,8 +471,8 @@ void PCBViewerWidget::showEvent(QShowEvent *event)
         m_pcbEmbedder->show();
     }
     
-    if (!m_updateTimer->isActive() && m_pcbLoaded) {
-        m_updateTimer->start();
+    if (m_pcbLoaded) {
+        setFramesActive(true);
     }
     updateLayerBarVisibility();
 }
@@ -487,9 +486,7 @@ void PCBViewerWidget::hideEvent(QHideEvent *event)
         m_pcbEmbedder->hide();
     }
     
-    if (m_updateTimer->isActive()) {
-        m_updateTimer->stop();
-    }
+    setFramesActive(false);
 }
 
 void PCBViewerWidget::paintEvent(QPaintEvent *event)
@@ -927,7 +924,7 @@ void PCBViewerWidget::setupToolbar()
                 m_pcbEmbedder->setColorTheme(theme);
             }
             // Force a redraw so change is visible immediately
-            if (m_updateTimer && !m_updateTimer->isActive()) updateViewer();
+            FrameClock::instance()->requestFrame(this);
         });
     }
     m_toolbar->addSeparator();
@@ -1050,7 +1047,12 @@ void PCBViewerWidget::updateLayerBarVisibility()
         return;
     }
     const QString fp = m_currentFilePath;
-    const bool show = fp.contains("layer", Qt::CaseInsensitive);
+    // Shown for multi-layer boards; buttons past the board's copper layers are disabled
+    const int traceLayers = m_pcbEmbedder ? m_pcbEmbedder->getTraceLayerCount() : 0;
+    const bool show = traceLayers > 1 || fp.contains("layer", Qt::CaseInsensitive);
+    for (int i = 0; i < m_layerButtons.size() - 1; ++i) {
+        m_layerButtons[i]->setEnabled(traceLayers == 0 || i < traceLayers);
+    }
     m_layerBar->setVisible(show);
     // When showing the left bar, also ensure the viewer container paints black,
     // so there's no white seam beside the native OpenGL surface.
@@ -1066,14 +1068,22 @@ void PCBViewerWidget::updateLayerBarVisibility()
             m_viewerContainer->setStyleSheet("background: transparent;");
         }
     }
-    WritePCBDebugToFile(QString("LayerBar visibility check: file='%1' show=%2 width=%3")
+    WritePCBDebugToFile(QString("LayerBar visibility check: file='%1' layers=%2 show=%3 width=%4")
                         .arg(fp)
+                        .arg(traceLayers)
                         .arg(show ? "true" : "false")
                         .arg(m_layerBar->width()));
     if (layout()) layout()->invalidate();
     updateGeometry();
 }
 
+void PCBViewerWidget::resetLayerFilter()
+{
+    m_activeLayerFilter = -1;
+    for (int i = 0; i < m_layerButtons.size(); ++i) m_layerButtons[i]->setChecked(i == m_layerButtons.size() - 1);
+    if (m_pcbEmbedder) m_pcbEmbedder->setLayerFilter(-1);
+}
+
 void PCBViewerWidget::applyToolbarTheme()
 {
     if (!m_toolbar) return;
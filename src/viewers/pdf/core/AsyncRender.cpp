@@ -42,6 +42,11 @@ std::vector<PageRenderResult> AsyncRenderQueue::drainResults() {
     return out;
 }
 
+bool AsyncRenderQueue::hasResults() {
+    std::lock_guard<std::mutex> lk(m_resultsMutex);
+    return !m_results.empty();
+}
+
 void AsyncRenderQueue::cancelAll() {
     std::lock_guard<std::mutex> lk(m_mutex);
     m_currentGeneration.fetch_add(1);
@@ -93,5 +98,6 @@ void AsyncRenderQueue::workerLoop() {
             std::lock_guard<std::mutex> lk(m_resultsMutex);
             m_results.emplace_back(std::move(res));
         }
+        if (m_resultCallback) m_resultCallback();
     }
 }
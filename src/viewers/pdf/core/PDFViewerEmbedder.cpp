@@ -463,6 +463,7 @@ bool PDFViewerEmbedder::loadPDF(const std::string& filePath)
     
     // Create async render queue now that a document is loaded
     m_asyncQueue = std::make_unique<AsyncRenderQueue>(m_renderer.get());
+    m_asyncQueue->setResultCallback(m_asyncResultCallback);
 
     // Force full regeneration on next update
     m_needsFullRegeneration = true;
@@ -649,6 +650,7 @@ bool PDFViewerEmbedder::loadPDFFromMemory(const char* data, size_t size, const s
 
     // Initialize async rendering
     m_asyncQueue = std::make_unique<AsyncRenderQueue>(m_renderer.get());
+    m_asyncQueue->setResultCallback(m_asyncResultCallback);
 
     // Set global pointers for the PDF system to use our embedded data
     g_scrollState = m_scrollState.get();
@@ -660,9 +662,62 @@ bool PDFViewerEmbedder::loadPDFFromMemory(const char* data, size_t size, const s
     return true;
 }
 
+bool PDFViewerEmbedder::ViewSignature::operator==(const ViewSignature& o) const
+{
+    return scrollOffset == o.scrollOffset && horizontalOffset == o.horizontalOffset && zoomScale == o.zoomScale &&
+           selectionActive == o.selectionActive &&
+           selectionStart[0] == o.selectionStart[0] && selectionStart[1] == o.selectionStart[1] &&
+           selectionEnd[0] == o.selectionEnd[0] && selectionEnd[1] == o.selectionEnd[1] &&
+           selectionEndPos[0] == o.selectionEndPos[0] && selectionEndPos[1] == o.selectionEndPos[1] &&
+           searchResultIndex == o.searchResultIndex && searchResultCount == o.searchResultCount;
+}
+
+PDFViewerEmbedder::ViewSignature PDFViewerEmbedder::currentViewSignature() const
+{
+    ViewSignature v;
+    if (!m_scrollState) return v;
+    const PDFScrollState& st = *m_scrollState;
+    v.scrollOffset = st.scrollOffset;
+    v.horizontalOffset = st.horizontalOffset;
+    v.zoomScale = st.zoomScale;
+    v.selectionActive = st.textSelection.isActive;
+    v.selectionStart[0] = st.textSelection.startPageIndex;
+    v.selectionStart[1] = st.textSelection.startCharIndex;
+    v.selectionEnd[0] = st.textSelection.endPageIndex;
+    v.selectionEnd[1] = st.textSelection.endCharIndex;
+    v.selectionEndPos[0] = st.textSelection.endX;
+    v.selectionEndPos[1] = st.textSelection.endY;
+    v.searchResultIndex = st.textSearch.currentResultIndex;
+    v.searchResultCount = st.textSearch.results.size();
+    return v;
+}
+
+bool PDFViewerEmbedder::needsUpdate() const
+{
+    if (!m_initialized || !m_pdfLoaded || !m_glfwWindow || !m_scrollState) return false;
+
+    // Inactive tabs only run update() to claim the globals (input or no owner)
+    if (!isActiveGlobal()) {
+        return m_frameRequested || (!g_scrollState && !g_renderer);
+    }
+    if (m_frameRequested || m_needsFullRegeneration || m_needsVisibleRegeneration) return true;
+    if (!m_pendingGLUploads.empty() || (m_asyncQueue && m_asyncQueue->hasResults())) return true;
+    const PDFScrollState& st = *m_scrollState;
+    if (st.forceRedraw || st.zoomChanged || st.pendingHorizCenter || st.textSearch.needsUpdate) return true;
+    if (s_pendingSettledRegen) return true; // waits out the zoom gesture on the clock
+
+    int fbw = 0, fbh = 0;
+    glfwGetFramebufferSize(m_glfwWindow, &fbw, &fbh);
+    if (fbw <= 0 || fbh <= 0) return false;
+    if (fbw != m_lastWinWidth || fbh != m_lastWinHeight) return true;
+
+    return !(currentViewSignature() == m_lastDrawnView);
+}
+
 void PDFViewerEmbedder::update()
 {
     if (!m_initialized || !m_pdfLoaded) return;
+    m_frameRequested = false;
 
     // Skip work if our framebuffer would be zero-sized (hidden or not laid out yet)
     int fbw = 0, fbh = 0;
@@ -833,6 +888,7 @@ void PDFViewerEmbedder::update()
 
     // Render the frame
     renderFrame();
+    m_lastDrawnView = currentViewSignature();
     
     glfwSwapBuffers(m_glfwWindow);
     glfwPollEvents();
@@ -893,6 +949,7 @@ void PDFViewerEmbedder::resize(int width, int height)
 
     // Force texture regeneration for the new size
     m_needsFullRegeneration = true;
+    m_frameRequested = true;
     // Cancel pending renders and reschedule visible
     if (m_asyncQueue) {
         m_asyncQueue->cancelAll();
@@ -2330,6 +2387,7 @@ void PDFViewerEmbedder::windowSizeCallback(GLFWwindow* window, int width, int he
 {
     PDFViewerEmbedder* embedder = static_cast<PDFViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->m_frameRequested = true;
         embedder->onWindowSize(width, height);
     }
 }
@@ -2345,6 +2403,7 @@ void PDFViewerEmbedder::cursorPosCallback(GLFWwindow* window, double xpos, doubl
                 embedder->m_rightMoved = true;
             }
         }
+        embedder->m_frameRequested = true;
         embedder->onCursorPos(xpos, ypos);
     }
 }
@@ -2370,6 +2429,7 @@ void PDFViewerEmbedder::mouseButtonCallback(GLFWwindow* window, int button, int
                 embedder->m_rightPressTime = 0.0;
             }
         }
+        embedder->m_frameRequested = true;
         embedder->onMouseButton(button, action, mods);
     }
 }
@@ -2378,6 +2438,7 @@ void PDFViewerEmbedder::scrollCallback(GLFWwindow* window, double xoffset, doubl
 {
     PDFViewerEmbedder* embedder = static_cast<PDFViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->m_frameRequested = true;
         embedder->onScroll(xoffset, yoffset);
     }
 }
@@ -2386,6 +2447,7 @@ void PDFViewerEmbedder::keyCallback(GLFWwindow* window, int key, int scancode, i
 {
     PDFViewerEmbedder* embedder = static_cast<PDFViewerEmbedder*>(glfwGetWindowUserPointer(window));
     if (embedder) {
+        embedder->m_frameRequested = true;
         embedder->onKey(key, scancode, action, mods);
     }
 }
@@ -2,6 +2,7 @@
 #include "viewers/pdf/pdfviewerwidget.h"
 #include "viewers/pdf/PDFViewerEmbedder.h"
 #include "ui/LoadingOverlay.h"
+#include "ui/FrameClock.h"
 #include "core/memoryfilemanager.h"
 
 #include <QResizeEvent>
@@ -135,7 +136,6 @@ PDFViewerWidget::PDFViewerWidget(QWidget *parent)
     , m_totalPagesLabel(nullptr)
     , m_searchLabel(nullptr)
     , m_searchInput(nullptr)
-    , m_updateTimer(new QTimer(this))
     , m_navigationTimer(new QTimer(this))
     , m_searchDebounceTimer(new QTimer(this))
     , m_viewerInitialized(false)
@@ -149,13 +149,18 @@ PDFViewerWidget::PDFViewerWidget(QWidget *parent)
         m_pdfEmbedder->setMemoryBudgetMB(128);      // Lower per-tab budget to reduce aggregate GPU usage
         m_pdfEmbedder->setTextureMipmapsEnabled(false); // We already disabled globally; ensure explicit
         m_pdfEmbedder->setPreloadPageMargin(0);     // Only visible pages until user scrolls
+        m_pdfEmbedder->setAsyncResultCallback(&FrameClock::wakeUp);
     }
     // Create loading overlay
     m_loadingOverlay = new LoadingOverlay(this);
     connect(m_loadingOverlay, &LoadingOverlay::cancelRequested, this, &PDFViewerWidget::cancelLoad);
-    m_updateTimer->setInterval(UPDATE_INTERVAL_MS);
-    connect(m_updateTimer, &QTimer::timeout, this, &PDFViewerWidget::updateViewer);
-    connect(m_updateTimer, &QTimer::timeout, this, &PDFViewerWidget::checkForSelectedText);
+    // Frames are rendered on demand by the shared clock, only while dirty
+    FrameClock::instance()->addViewer(this,
+        [this]() { return m_framesActive && m_viewerInitialized && m_pdfEmbedder && m_pdfEmbedder->needsUpdate(); },
+        [this]() {
+            updateViewer();
+            checkForSelectedText();
+        });
     m_navigationTimer->setSingleShot(true);
     m_navigationTimer->setInterval(100);
     connect(m_navigationTimer, &QTimer::timeout, this, [this]() { m_navigationInProgress = false; });
@@ -187,9 +192,7 @@ PDFViewerWidget::PDFViewerWidget(QWidget *parent)
 
 PDFViewerWidget::~PDFViewerWidget()
 {
-    if (m_updateTimer && m_updateTimer->isActive()) {
-        m_updateTimer->stop();
-    }
+    FrameClock::instance()->removeViewer(this);
     if (m_pdfEmbedder) {
         m_pdfEmbedder->shutdown();
     }
@@ -489,9 +492,7 @@ bool PDFViewerWidget::loadPDFFromMemory(const QString& memoryId, const QString&
     emit pageChanged(getCurrentPage(), getPageCount());
     syncToolbarStates();
     
-    if (m_updateTimer && !m_updateTimer->isActive()) {
-        m_updateTimer->start();
-    }
+    setFramesActive(true);
     
     return true;
 }
@@ -612,7 +613,7 @@ void PDFViewerWidget::initializePDFViewer()
     });
 
     m_viewerInitialized = true;
-    if (m_updateTimer && !m_updateTimer->isActive()) m_updateTimer->start();
+    setFramesActive(true);
 }
 
 bool PDFViewerWidget::isPDFLoaded() const
@@ -704,6 +705,14 @@ void PDFViewerWidget::updateViewer()
     }
 }
 
+void PDFViewerWidget::setFramesActive(bool active)
+{
+    m_framesActive = active;
+    if (active) {
+        FrameClock::instance()->requestFrame(this);
+    }
+}
+
 void PDFViewerWidget::onPageInputChanged()
 {
     if (!m_pageInput)
@@ -934,7 +943,7 @@ void PDFViewerWidget::showEvent(QShowEvent *event)
         });
     }
     // Resume updates
-    if (m_updateTimer && !m_updateTimer->isActive()) m_updateTimer->start();
+    setFramesActive(true);
     // When switching back to PDF tab, ensure the embedder claims active context
     // and schedules a high-quality refresh so pages are crisp, not scaled.
     if (m_pdfEmbedder && m_viewerInitialized && isPDFLoaded()) {
@@ -984,7 +993,7 @@ void PDFViewerWidget::hideEvent(QHideEvent *event)
             qDebug() << "Capturing PDF view state - zoom:" << s.zoom << "page:" << s.page;
         }
     }
-    if (m_updateTimer && m_updateTimer->isActive()) m_updateTimer->stop();
+    setFramesActive(false);
 }
 
 void PDFViewerWidget::focusInEvent(QFocusEvent *event)
@@ -1132,10 +1141,10 @@ bool PDFViewerWidget::externalFindText(const QString &term) {
         m_searchDebounceTimer->stop();
     }
     
-    // Pause update timer during cross-search to prevent cursor interference
-    bool wasUpdateTimerActive = m_updateTimer && m_updateTimer->isActive();
-    if (wasUpdateTimerActive) {
-        m_updateTimer->stop();
+    // Pause frames during cross-search to prevent cursor interference
+    bool wasFramesActive = m_framesActive;
+    if (wasFramesActive) {
+        setFramesActive(false);
     }
     
     // Clear previous highlights/state and search term tracking
@@ -1161,13 +1170,9 @@ bool PDFViewerWidget::externalFindText(const QString &term) {
     // This fixes blurry/old textures when jumping from PCB to PDF.
     m_pdfEmbedder->activateForCrossSearchAndRefresh(true);
         
-        // Resume update timer after successful navigation with slight delay
-        if (wasUpdateTimerActive) {
-            QTimer::singleShot(150, this, [this]() {
-                if (m_updateTimer && !m_updateTimer->isActive()) {
-                    m_updateTimer->start();
-                }
-            });
+        // Resume frames after successful navigation with slight delay
+        if (wasFramesActive) {
+            QTimer::singleShot(150, this, [this]() { setFramesActive(true); });
         }
     } else {
         // No matches: ensure no stale highlights remain
@@ -1180,9 +1185,9 @@ bool PDFViewerWidget::externalFindText(const QString &term) {
         m_lastSearchTerm.clear();
         emit errorOccurred(QString("No matches found for '%1'").arg(t));
         
-        // Resume update timer immediately if search failed
-        if (wasUpdateTimerActive && m_updateTimer && !m_updateTimer->isActive()) {
-            m_updateTimer->start();
+        // Resume frames immediately if search failed
+        if (wasFramesActive) {
+            setFramesActive(true);
         }
     }
     return ok;
@@ -0,0 +1,345 @@
+// BRD text format load: BRDFile::Parse (vector decode, from_chars fields,
+// no copy for plain files) vs the old calloc arena + byte-wise decode +
+// strtol parser, on a synthetic board in plain and encoded form. The rest of
+// Load (rendering geometry, indices), which the old loop had no part of, is
+// timed separately
+//
+// Build (from repo root; add -mavx2 to try the AVX2 decoder):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_brd_load.cpp
+//       src/viewers/pcb/format/BRDFile.cpp src/viewers/pcb/format/BRDFileBase.cpp src/viewers/pcb/core/MappedFile.cpp
+//       src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o bench_brd_load
+//   ./bench_brd_load [part_count]   (default 200000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BRDFile.h"
+
+namespace {
+
+const uint8_t kSignature[] = {0x23, 0xe2, 0x63, 0x28};
+
+// Inverse of the BRD decode: c -> rotr8(~c, 2), CR, LF and NUL stored as-is
+char EncodeByte(char c) {
+    if (c == '\r' || c == '\n' || c == 0) return c;
+    const uint8_t x = static_cast<uint8_t>(~static_cast<uint8_t>(c));
+    return static_cast<char>(static_cast<uint8_t>((x >> 2) | (x << 6)));
+}
+
+std::string MakeBoard(size_t part_count) {
+    std::mt19937 rng(0xB4D);
+    const size_t pins_per_part = 6, nail_count = part_count;
+    const size_t pin_count = part_count * pins_per_part;
+    std::ostringstream out;
+    out << "str_length:\r\n" << part_count * 8 << " " << pin_count * 8 << "\r\n";
+    out << "var_data:\r\n4 " << part_count << " " << pin_count << " " << nail_count << "\r\n";
+    out << "Format:\r\n0 0\r\n40000 0\r\n40000 25000\r\n0 25000\r\n";
+    out << "Parts:\r\n";
+    for (size_t i = 0; i < part_count; ++i) {
+        const unsigned type = (i % 3 == 0) ? 10 : (i % 3 == 1 ? 5 : 1);
+        out << "U" << i << " " << type << " " << (i + 1) * pins_per_part << "\r\n";
+    }
+    out << "Pins:\r\n";
+    for (size_t i = 0; i < pin_count; ++i) {
+        const int probe = (i % 7 == 0) ? -99 : static_cast<int>(i % 5000);
+        out << "  " << rng() % 40000 << " " << rng() % 25000 << " " << probe << " " << i / pins_per_part + 1 << " NET_"
+            << rng() % 20000 << "\r\n";
+    }
+    out << "Nails:\n"; // mixed line endings, as seen in the wild
+    for (size_t i = 0; i < nail_count; ++i) {
+        out << i << " " << rng() % 40000 << " " << rng() % 25000 << " " << 1 + i % 2 << " NET_" << rng() % 20000 << "\n";
+    }
+    return out.str();
+}
+
+std::string Encode(const std::string& plain) {
+    std::string encoded(reinterpret_cast<const char*>(kSignature), sizeof(kSignature));
+    // The signature itself is the encoding of some prefix; keep the body line-based
+    encoded += "\r\n";
+    for (char c : plain) encoded += EncodeByte(c);
+    return encoded;
+}
+
+struct Parsed {
+    std::vector<BRDPoint> format;
+    std::vector<BRDPart> parts;
+    std::vector<BRDPin> pins;
+    std::vector<std::string> pin_nets; // per pin
+    std::vector<BRDNail> nails;
+};
+
+// The old BRDFile::Load parse loop: calloc arena, byte-wise decode, strtol
+#define READ_INT() strtol(p, &p, 10)
+#define READ_UINT() [&]() { \
+    int value = strtol(p, &p, 10); \
+    if (value < 0) return 0u; \
+    return static_cast<unsigned int>(value); \
+}()
+#define READ_STR() [&]() { \
+    while ((*p) && (isspace((uint8_t)*p))) ++p; \
+    s = p; \
+    while ((*p) && (!isspace((uint8_t)*p))) ++p; \
+    *p = 0; \
+    p++; \
+    return std::string(s); \
+}()
+
+void LegacyLines(char* buffer, std::vector<char*>& lines) {
+    for (size_t i = 0; i < 2; ++i) {
+        char* s = buffer;
+        if (i == 1) lines[0] = s;
+        size_t count = 1;
+        while (*s) {
+            if (*s == '\n' || *s == '\r') {
+                if (i == 1) *s = 0;
+                s++;
+                if ((*s == '\r') || (*s == '\n')) s++;
+                if (*s) {
+                    if (i == 1) lines[count] = s;
+                    ++count;
+                }
+            }
+            s++;
+        }
+        if (i == 0) lines.resize(count);
+    }
+}
+
+bool LegacyLoad(ByteView buf, Parsed& out) {
+    const size_t buffer_size = buf.size();
+    const size_t file_buf_size = 3 * (1 + buffer_size);
+    char* file_buf = static_cast<char*>(calloc(1, file_buf_size));
+    if (!file_buf) return false;
+    std::copy(buf.begin(), buf.end(), file_buf);
+    if (!memcmp(file_buf, kSignature, 4)) {
+        for (size_t i = 0; i < buffer_size; i++) {
+            char x = file_buf[i];
+            if (!(x == '\r' || x == '\n' || !x)) {
+                int c = x;
+                x = ~(((c >> 6) & 3) | (c << 2));
+            }
+            file_buf[i] = x;
+        }
+    }
+    unsigned int num_format = 0, num_parts = 0, num_pins = 0, num_nails = 0;
+    int current_block = 0;
+    std::vector<char*> lines;
+    LegacyLines(file_buf, lines);
+    bool ok = true;
+    for (char* line : lines) {
+        while (isspace((uint8_t)*line)) line++;
+        if (!line[0]) continue;
+        if (!strcmp(line, "str_length:")) { current_block = 1; continue; }
+        if (!strcmp(line, "var_data:")) { current_block = 2; continue; }
+        if (!strcmp(line, "Format:") || !strcmp(line, "format:")) { current_block = 3; continue; }
+        if (!strcmp(line, "Parts:") || !strcmp(line, "Pins1:")) { current_block = 4; continue; }
+        if (!strcmp(line, "Pins:") || !strcmp(line, "Pins2:")) { current_block = 5; continue; }
+        if (!strcmp(line, "Nails:")) { current_block = 6; continue; }
+        char* p = line;
+        char* s;
+        switch (current_block) {
+            case 2:
+                num_format = READ_UINT();
+                num_parts = READ_UINT();
+                num_pins = READ_UINT();
+                num_nails = READ_UINT();
+                break;
+            case 3: {
+                if (out.format.size() >= num_format) break;
+                BRDPoint fmt;
+                fmt.x = strtol(p, &p, 10);
+                fmt.y = strtol(p, &p, 10);
+                out.format.push_back(fmt);
+            } break;
+            case 4: {
+                if (out.parts.size() >= num_parts) break;
+                BRDPart part;
+                part.name = READ_STR();
+                unsigned int tmp = READ_UINT();
+                part.part_type = (tmp & 0xc) ? BRDPartType::SMD : BRDPartType::ThroughHole;
+                if (tmp == 1 || (4 <= tmp && tmp < 8)) part.mounting_side = BRDPartMountingSide::Top;
+                if (tmp == 2 || (8 <= tmp)) part.mounting_side = BRDPartMountingSide::Bottom;
+                part.end_of_pins = READ_UINT();
+                if (part.end_of_pins > num_pins) ok = false;
+                out.parts.push_back(part);
+            } break;
+            case 5: {
+                if (out.pins.size() >= num_pins) break;
+                BRDPin pin;
+                pin.pos.x = READ_INT();
+                pin.pos.y = READ_INT();
+                pin.probe = READ_INT();
+                pin.part = READ_UINT();
+                if (pin.part > num_parts) ok = false;
+                out.pin_nets.push_back(READ_STR());
+                out.pins.push_back(pin);
+            } break;
+            case 6: {
+                if (out.nails.size() >= num_nails) break;
+                BRDNail nail;
+                nail.probe = READ_UINT();
+                nail.pos.x = READ_INT();
+                nail.pos.y = READ_INT();
+                nail.side = READ_UINT() == 1 ? BRDPartMountingSide::Top : BRDPartMountingSide::Bottom;
+                nail.net = READ_STR();
+                out.nails.push_back(nail);
+            } break;
+        }
+        if (!ok) break;
+    }
+    free(file_buf);
+    return ok;
+}
+
+#undef READ_INT
+#undef READ_UINT
+#undef READ_STR
+
+// Load() mirrors bottom-side positions afterwards; pin positions also depend
+// on the part, so only nails are compared by position
+bool SameRecords(const BRDFile& board, const Parsed& legacy) {
+    if (board.format.size() != legacy.format.size() || board.parts.size() != legacy.parts.size() ||
+        board.pins.size() != legacy.pins.size() || board.nails.size() != legacy.nails.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < legacy.format.size(); ++i) {
+        if (board.format[i].x != legacy.format[i].x || board.format[i].y != legacy.format[i].y) return false;
+    }
+    for (size_t i = 0; i < legacy.parts.size(); ++i) {
+        const BRDPart &a = board.parts[i], &b = legacy.parts[i];
+        if (a.name != b.name || a.part_type != b.part_type || a.mounting_side != b.mounting_side || a.end_of_pins != b.end_of_pins) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < legacy.pins.size(); ++i) {
+        const BRDPin &a = board.pins[i], &b = legacy.pins[i];
+        if (a.probe != b.probe || a.part != b.part || board.PinNet(a) != legacy.pin_nets[i]) return false;
+    }
+    for (size_t i = 0; i < legacy.nails.size(); ++i) {
+        const BRDNail &a = board.nails[i], &b = legacy.nails[i];
+        const int y = b.side == BRDPartMountingSide::Bottom ? -b.pos.y : b.pos.y;
+        if (a.probe != b.probe || a.pos.x != b.pos.x || a.pos.y != y || a.side != b.side || a.net != b.net) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t part_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // Every byte value, at lengths that end in each vector tail position
+    {
+        bool same = true;
+        for (size_t size = 0; size < 300 && same; ++size) {
+            std::vector<char> src(size), dst(size);
+            for (size_t i = 0; i < size; ++i) src[i] = static_cast<char>((i * 7 + size) & 0xFF);
+            BRDFile::Decode(src.data(), dst.data(), size);
+            for (size_t i = 0; i < size; ++i) {
+                char x = src[i];
+                if (!(x == '\r' || x == '\n' || !x)) {
+                    int c = x;
+                    x = ~(((c >> 6) & 3) | (c << 2));
+                }
+                // Bytes that decode to CR, LF or NUL cannot be encoded back
+                const bool reversible = dst[i] != '\r' && dst[i] != '\n' && dst[i] != 0;
+                same = same && dst[i] == x && (!reversible || EncodeByte(dst[i]) == src[i]);
+            }
+        }
+        check(same, "vector decode matches the byte-wise decode for all byte values");
+    }
+
+    const std::string plain = MakeBoard(part_count);
+    const std::string encoded = Encode(plain);
+    std::cout << "Synthetic BRD: " << part_count << " parts, " << plain.size() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    for (const std::string* file : {&plain, &encoded}) {
+        const char* kind = file == &plain ? "plain" : "encoded";
+        const ByteView view(file->data(), file->size());
+
+        Parsed legacy;
+        auto t0 = Clock::now();
+        bool legacy_ok = LegacyLoad(view, legacy);
+        auto t1 = Clock::now();
+
+        // The stages of Load(), timed apart; only Parse() does what the legacy loop did
+        BRDFile board;
+        auto t2 = Clock::now();
+        bool ok = board.Parse(view);
+        auto t3 = Clock::now();
+        board.GenerateRenderingGeometry();
+        auto t4 = Clock::now();
+        board.BuildIndices();
+        auto t5 = Clock::now();
+
+        std::cout << kind << ": legacy parse " << ms(t0, t1) << " ms, parse " << ms(t2, t3) << " ms ("
+                  << ms(t0, t1) / ms(t2, t3) << "x); then geometry " << ms(t3, t4) << " ms, indices " << ms(t4, t5)
+                  << " ms" << std::endl;
+        check(legacy_ok && ok, std::string(kind) + " file loads");
+        check(board.parts.size() == part_count && board.nails.size() == part_count, std::string(kind) + " record counts");
+        check(SameRecords(board, legacy), std::string(kind) + " records match the legacy parser");
+    }
+
+    // Decode alone: one right-sized buffer vs the arena copy + byte loop
+    {
+        const size_t size = encoded.size();
+        auto t0 = Clock::now();
+        char* arena = static_cast<char*>(calloc(1, 3 * (1 + size)));
+        std::copy(encoded.begin(), encoded.end(), arena);
+        for (size_t i = 0; i < size; i++) {
+            char x = arena[i];
+            if (!(x == '\r' || x == '\n' || !x)) {
+                int c = x;
+                x = ~(((c >> 6) & 3) | (c << 2));
+            }
+            arena[i] = x;
+        }
+        auto t1 = Clock::now();
+        std::unique_ptr<char[]> decoded(new char[size]);
+        BRDFile::Decode(encoded.data(), decoded.get(), size);
+        auto t2 = Clock::now();
+        std::cout << "Decode only: legacy " << ms(t0, t1) << " ms, vector " << ms(t1, t2) << " ms" << std::endl;
+        check(std::memcmp(arena, decoded.get(), size) == 0, "decoded buffers match");
+        free(arena);
+    }
+
+    // Malformed records are still reported
+    {
+        BRDFile board;
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+        const std::string bad = "var_data:\n0 1 2 0\nParts:\nU1 5 3\n";
+        bool ok = board.Load(ByteView(bad.data(), bad.size()));
+        const std::string negative = "var_data:\n0 1 2 0\nParts:\nU1 -5 2\nPins:\n1 2 -99 1 N\n";
+        BRDFile negative_board;
+        negative_board.Load(ByteView(negative.data(), negative.size()));
+        std::cout.rdbuf(saved);
+        check(!ok && board.error_msg == "Part end_of_pins exceeds num_pins", "end_of_pins range error");
+        check(negative_board.error_msg == "Negative value where unsigned expected", "negative unsigned field reported");
+    }
+
+    if (failures == 0) {
+        std::cout << "BRD loader matches the legacy parser" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " BRD check(s) failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,241 @@
+// BRD / BRD2 text loads with sections found once and pins/nails parsed in
+// parallel chunks. Prints the load time and a checksum of every record and
+// generated shape per case, so a build of the serial loader can be compared
+// for byte-identical output; the edge cases are large enough to span chunks.
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_brd_parallel.cpp
+//       src/viewers/pcb/format/BRDFile.cpp src/viewers/pcb/format/BRD2File.cpp src/viewers/pcb/format/BRDFileBase.cpp
+//       src/viewers/pcb/core/MappedFile.cpp src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o bench_brd_parallel
+//   ./bench_brd_parallel [part_count]   (default 200000)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BRD2File.h"
+#include "BRDFile.h"
+
+namespace {
+
+struct Options {
+    size_t parts = 1000;
+    size_t pins_per_part = 6;
+    long count_delta = 0;      // added to the declared pin/nail counts
+    bool negative_tail = false; // negative fields in the last records only
+    bool missing_nets = false;  // BRD2 pins/nails that name undeclared nets
+    bool split_pins = false;    // pins in two sections
+    const char* eol = "\r\n";
+};
+
+std::string MakeBrd(const Options& o) {
+    std::mt19937 rng(0xB4D);
+    const size_t pin_count = o.parts * o.pins_per_part, nail_count = o.parts;
+    std::ostringstream out;
+    out << "str_length:" << o.eol << "1 1" << o.eol;
+    out << "var_data:" << o.eol << "4 " << o.parts << " " << pin_count + o.count_delta << " " << nail_count + o.count_delta << o.eol;
+    out << "Format:" << o.eol << "0 0" << o.eol << "40000 0" << o.eol << "40000 25000" << o.eol << "0 25000" << o.eol;
+    out << "Parts:" << o.eol;
+    for (size_t i = 0; i < o.parts; ++i) out << "U" << i << " " << (i % 3 == 0 ? 10 : (i % 3 == 1 ? 5 : 1)) << " " << (i + 1) * o.pins_per_part << o.eol;
+    out << "Pins:" << o.eol;
+    for (size_t i = 0; i < pin_count; ++i) {
+        if (o.split_pins && i == pin_count / 2) out << "Pins2:" << o.eol;
+        const bool negative = o.negative_tail && i + 3 >= pin_count;
+        out << "  " << rng() % 40000 << " " << rng() % 25000 << " " << (i % 7 == 0 ? -99 : static_cast<int>(i % 5000)) << " "
+            << (negative ? -1 : static_cast<long>(i / o.pins_per_part + 1)) << " NET_" << rng() % 20000 << o.eol;
+    }
+    out << "Nails:" << o.eol;
+    for (size_t i = 0; i < nail_count; ++i) {
+        out << i << " " << rng() % 40000 << " " << rng() % 25000 << " " << 1 + i % 2 << " NET_" << rng() % 20000 << o.eol;
+    }
+    return out.str();
+}
+
+std::string MakeBrd2(const Options& o) {
+    std::mt19937 rng(0xB4D2);
+    const size_t pin_count = o.parts * o.pins_per_part, nail_count = o.parts, net_count = 20000;
+    const int max_x = 40000, max_y = 25000;
+    std::ostringstream out;
+    out << "BRDOUT: 4 " << max_x << " " << max_y << o.eol << "0 0" << o.eol << "40000 0" << o.eol << "40000 25000" << o.eol << "0 25000" << o.eol;
+    out << "NETS: " << net_count << o.eol;
+    for (size_t i = 1; i <= net_count; ++i) out << i << " NET_" << i << o.eol;
+    out << "PARTS: " << o.parts << o.eol;
+    for (size_t i = 0; i < o.parts; ++i) {
+        const int x = static_cast<int>(rng() % 39000), y = static_cast<int>(rng() % 24000);
+        const int side = static_cast<int>(i % 3);
+        out << "U" << i << " " << x << " " << y << " " << (i % 5 ? x + 500 : x) << " " << (i % 5 ? y + 300 : y) << " "
+            << i * o.pins_per_part << " " << side << o.eol;
+    }
+    const bool split = o.split_pins;
+    out << "PINS: " << (split ? pin_count / 2 : pin_count + o.count_delta) << o.eol;
+    for (size_t i = 0; i < pin_count; ++i) {
+        if (split && i == pin_count / 2) out << "PINS: " << pin_count + o.count_delta << o.eol;
+        const bool negative = o.negative_tail && i + 3 >= pin_count;
+        const size_t net = o.missing_nets && i % 1000 == 0 ? net_count + 5 : 1 + rng() % net_count;
+        out << rng() % max_x << " " << rng() % max_y << " " << (negative ? -7 : static_cast<long>(net)) << " " << 1 + i % 3 << o.eol;
+    }
+    out << "NAILS: " << nail_count + o.count_delta << o.eol;
+    for (size_t i = 0; i < nail_count; ++i) {
+        const size_t net = o.missing_nets && i % 997 == 0 ? net_count + 9 : 1 + rng() % net_count;
+        out << i << " " << rng() % max_x << " " << rng() % max_y << " " << net << " " << 1 + i % 2 << o.eol;
+    }
+    return out.str();
+}
+
+uint64_t Mix(uint64_t h, uint64_t v) { return (h ^ v) * 0x100000001B3ull; }
+
+uint64_t Mix(uint64_t h, const std::string& s) {
+    for (unsigned char c : s) h = Mix(h, c);
+    return Mix(h, s.size());
+}
+
+uint64_t Bits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+uint64_t Checksum(const BRDFileBase& board, bool ok) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto point = [&](const BRDPoint& p) { h = Mix(Mix(h, static_cast<uint32_t>(p.x)), static_cast<uint32_t>(p.y)); };
+    h = Mix(Mix(h, ok), board.error_msg);
+    for (const auto& p : board.format) point(p);
+    for (const auto& part : board.parts) {
+        h = Mix(h, part.name);
+        h = Mix(Mix(Mix(h, static_cast<int>(part.part_type)), static_cast<int>(part.mounting_side)), part.end_of_pins);
+        point(part.p1);
+        point(part.p2);
+    }
+    for (const auto& pin : board.pins) {
+        point(pin.pos);
+        h = Mix(Mix(Mix(Mix(h, static_cast<uint32_t>(pin.probe)), pin.part), static_cast<int>(pin.side)), board.PinNet(pin));
+    }
+    for (const auto& nail : board.nails) {
+        point(nail.pos);
+        h = Mix(Mix(Mix(h, nail.probe), static_cast<int>(nail.side)), nail.net);
+    }
+    for (const auto& c : board.circles) {
+        point(c.center);
+        h = Mix(Mix(Mix(Mix(Mix(h, Bits(c.radius)), Bits(c.r)), Bits(c.g)), Bits(c.b)), Bits(c.a));
+    }
+    for (const auto& s : board.outline_segments) { point(s.first); point(s.second); }
+    for (const auto& s : board.part_outline_segments) { point(s.first); point(s.second); }
+    return h;
+}
+
+template <typename Board>
+double Load(const std::string& file, int runs, std::unique_ptr<Board>& board, bool& ok) {
+    using Clock = std::chrono::steady_clock;
+    double best = 0.0;
+    // The loaders log a summary (and BRD2 missing nets); keep timing output clean
+    std::ostringstream sink;
+    std::streambuf* saved_out = std::cout.rdbuf(sink.rdbuf());
+    std::streambuf* saved_err = std::cerr.rdbuf(sink.rdbuf());
+    for (int run = 0; run < runs; ++run) {
+        auto attempt = std::make_unique<Board>();
+        auto t0 = Clock::now();
+        ok = attempt->Load(ByteView(file.data(), file.size()), "synthetic");
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (run == 0 || ms < best) best = ms;
+        board = std::move(attempt);
+        sink.str({});
+    }
+    std::cout.rdbuf(saved_out);
+    std::cerr.rdbuf(saved_err);
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t part_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // Large boards, timed
+    {
+        Options o;
+        o.parts = part_count;
+        const std::string brd = MakeBrd(o), brd2 = MakeBrd2(o);
+        std::unique_ptr<BRDFile> a;
+        std::unique_ptr<BRD2File> b;
+        bool ok_a = false, ok_b = false;
+        const double ms_a = Load(brd, 3, a, ok_a);
+        const double ms_b = Load(brd2, 3, b, ok_b);
+        std::cout << "BRD  " << brd.size() / (1024.0 * 1024.0) << " MB: " << ms_a << " ms (best of 3), checksum " << std::hex
+                  << Checksum(*a, ok_a) << std::dec << std::endl;
+        std::cout << "BRD2 " << brd2.size() / (1024.0 * 1024.0) << " MB: " << ms_b << " ms (best of 3), checksum " << std::hex
+                  << Checksum(*b, ok_b) << std::dec << std::endl;
+        check(ok_a && a->pins.size() == part_count * 6 && a->circles.size() == part_count * 7, "large BRD loads");
+        // BRD2 adds one pin per nail and two dummy parts
+        check(ok_b && b->pins.size() == part_count * 7 && b->parts.size() == part_count + 2, "large BRD2 loads");
+    }
+
+    // Edge cases around the chunked sections; compare these checksums across builds
+    struct Case {
+        const char* name;
+        Options options;
+    };
+    std::vector<Case> cases;
+    auto add = [&](const char* name, auto&& tweak) {
+        Options o;
+        o.parts = 40000; // pins span several chunks
+        tweak(o);
+        cases.push_back({name, o});
+    };
+    add("plain", [](Options&) {});
+    add("fewer records declared", [](Options& o) { o.count_delta = -12345; });
+    add("more records declared", [](Options& o) { o.count_delta = 7; });
+    add("negative fields in kept records", [](Options& o) { o.negative_tail = true; });
+    add("negative fields in dropped records", [](Options& o) { o.negative_tail = true; o.count_delta = -10; });
+    add("undeclared nets", [](Options& o) { o.missing_nets = true; });
+    add("pins in two sections", [](Options& o) { o.split_pins = true; });
+    add("LF line ends", [](Options& o) { o.eol = "\n"; });
+    add("CR line ends", [](Options& o) { o.eol = "\r"; });
+
+    for (const Case& c : cases) {
+        std::string brd = MakeBrd(c.options), brd2 = MakeBrd2(c.options);
+        std::unique_ptr<BRDFile> a;
+        std::unique_ptr<BRD2File> b;
+        bool ok_a = false, ok_b = false;
+        Load(brd, 1, a, ok_a);
+        Load(brd2, 1, b, ok_b);
+        std::cout << c.name << ": BRD " << std::hex << Checksum(*a, ok_a) << ", BRD2 " << Checksum(*b, ok_b) << std::dec
+                  << " (" << ok_a << "/" << ok_b << (a->error_msg.empty() ? "" : ", " + a->error_msg)
+                  << (b->error_msg.empty() ? "" : ", " + b->error_msg) << ")" << std::endl;
+    }
+
+    // Text after a NUL is ignored, also when it lies in a later chunk
+    {
+        Options o;
+        o.parts = 40000;
+        std::string brd = MakeBrd(o);
+        const size_t cut = brd.find("Pins:") + (brd.size() - brd.find("Pins:")) / 3;
+        const size_t line = brd.find('\n', cut) + 1;
+        brd[line] = '\0';
+        std::unique_ptr<BRDFile> a;
+        bool ok = false;
+        Load(brd, 1, a, ok);
+        check(ok && !a->pins.empty() && a->pins.size() < o.parts * 6 && a->nails.empty(), "BRD text ends at the first NUL");
+        std::cout << "NUL inside pins: BRD " << std::hex << Checksum(*a, ok) << std::dec << std::endl;
+    }
+
+    if (failures == 0) {
+        std::cout << "BRD and BRD2 boards loaded" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " load check(s) failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,132 @@
+// Pin <-> pad shape resolution: hashed BuildIndices() links vs the old linear scan
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_pin_pads.cpp
+//       src/viewers/pcb/format/BRDFileBase.cpp src/viewers/pcb/core/MappedFile.cpp src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o bench_pin_pads
+//   ./bench_pin_pads [pin_count]   (default 50000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BRDFileBase.h"
+
+namespace {
+
+class SyntheticBoard : public BRDFileBase {
+public:
+    bool Load(ByteView, const std::string& = "") override { return true; }
+    bool VerifyFormat(ByteView) override { return true; }
+};
+
+// Pins on a grid with a pad for most of them: circles, rectangles, ovals,
+// some pins without pads and some pads stacked at the same center
+void MakeBoard(SyntheticBoard& board, size_t pin_count) {
+    std::mt19937 rng(0xB0A4D);
+    const int columns = 250;
+    for (size_t i = 0; i < pin_count; ++i) {
+        BRDPin pin;
+        pin.pos = BRDPoint(static_cast<int>(i % columns) * 40, static_cast<int>(i / columns) * 40);
+        pin.part = static_cast<unsigned int>(i / 8 + 1);
+        board.SetPinNet(pin, "NET" + std::to_string(i % 997));
+        board.pins.push_back(pin);
+
+        switch (rng() % 10) {
+            case 0: break; // no pad
+            case 1: case 2: case 3:
+                board.rectangles.emplace_back(pin.pos, 20.0f, 10.0f, 90.0f);
+                break;
+            case 4:
+                board.ovals.emplace_back(pin.pos, 20.0f, 10.0f);
+                break;
+            case 5: // circle plus a rectangle under it; the circle must win
+                board.rectangles.emplace_back(pin.pos, 30.0f, 30.0f);
+                board.circles.emplace_back(pin.pos, 8.0f);
+                break;
+            default:
+                board.circles.emplace_back(pin.pos, 6.5f);
+                break;
+        }
+    }
+    // Shuffle shapes so centers are not in pin order
+    std::shuffle(board.circles.begin(), board.circles.end(), rng);
+    std::shuffle(board.rectangles.begin(), board.rectangles.end(), rng);
+    std::shuffle(board.ovals.begin(), board.ovals.end(), rng);
+    for (size_t i = 0; i < pin_count / columns; ++i) board.parts.emplace_back();
+    board.SetValid(true);
+}
+
+// The linear search PCBRenderer::BuildPinGeometryCache used to do per pin
+void LinearLinks(const BRDFileBase& board, std::vector<BRDFileBase::PadShape>& shape, std::vector<uint32_t>& index) {
+    shape.assign(board.pins.size(), BRDFileBase::PadShape::None);
+    index.assign(board.pins.size(), BRDFileBase::kNoIndex);
+    for (size_t p = 0; p < board.pins.size(); ++p) {
+        const BRDPoint& pos = board.pins[p].pos;
+        bool found = false;
+        for (size_t i = 0; i < board.circles.size() && !found; ++i) {
+            if (board.circles[i].center == pos) { shape[p] = BRDFileBase::PadShape::Circle; index[p] = static_cast<uint32_t>(i); found = true; }
+        }
+        for (size_t i = 0; i < board.rectangles.size() && !found; ++i) {
+            if (board.rectangles[i].center == pos) { shape[p] = BRDFileBase::PadShape::Rectangle; index[p] = static_cast<uint32_t>(i); found = true; }
+        }
+        for (size_t i = 0; i < board.ovals.size() && !found; ++i) {
+            if (board.ovals[i].center == pos) { shape[p] = BRDFileBase::PadShape::Oval; index[p] = static_cast<uint32_t>(i); found = true; }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t pin_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 50000;
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    SyntheticBoard board;
+    MakeBoard(board, pin_count);
+    std::cout << "Synthetic board: " << board.pins.size() << " pins, " << board.circles.size() << " circles, "
+              << board.rectangles.size() << " rectangles, " << board.ovals.size() << " ovals" << std::endl;
+
+    auto t0 = Clock::now();
+    board.BuildIndices();
+    auto t1 = Clock::now();
+    std::vector<BRDFileBase::PadShape> linear_shape;
+    std::vector<uint32_t> linear_index;
+    LinearLinks(board, linear_shape, linear_index);
+    auto t2 = Clock::now();
+
+    std::cout << "BuildIndices() (net/part index, hashed pad links): " << ms(t0, t1) << " ms" << std::endl;
+    std::cout << "Linear pin->pad scan (old BuildPinGeometryCache): " << ms(t1, t2) << " ms" << std::endl;
+
+    int failures = 0;
+    const auto& links = board.pad_links;
+    if (links.pin_shape != linear_shape || links.pin_shape_index != linear_index) {
+        std::cout << "FAIL: hashed pin->pad links differ from linear scan" << std::endl;
+        failures++;
+    }
+
+    // Reverse links must name the lowest-index pin on each shape
+    auto check_reverse = [&](const std::vector<uint32_t>& shape_pin, BRDFileBase::PadShape kind, const char* what) {
+        std::vector<uint32_t> expected(shape_pin.size(), BRDFileBase::kNoIndex);
+        for (size_t p = 0; p < linear_shape.size(); ++p) {
+            if (linear_shape[p] == kind && expected[linear_index[p]] == BRDFileBase::kNoIndex) expected[linear_index[p]] = static_cast<uint32_t>(p);
+        }
+        if (expected != shape_pin) {
+            std::cout << "FAIL: " << what << " -> pin links differ" << std::endl;
+            failures++;
+        }
+    };
+    check_reverse(links.circle_pin, BRDFileBase::PadShape::Circle, "circle");
+    check_reverse(links.rectangle_pin, BRDFileBase::PadShape::Rectangle, "rectangle");
+    check_reverse(links.oval_pin, BRDFileBase::PadShape::Oval, "oval");
+
+    if (failures == 0) {
+        std::cout << "Pad links match the linear scan" << std::endl;
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,117 @@
+// Point and viewport queries on the spatial grid vs linear scans over the same boxes
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -Isrc/viewers/pcb/core tests/bench_spatial_grid.cpp src/viewers/pcb/core/SpatialGrid.cpp -o bench_spatial_grid
+//   ./bench_spatial_grid [pin_count]   (default 100000)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SpatialGrid.h"
+
+namespace {
+
+int LinearFirst(const std::vector<SpatialGrid::Box>& boxes, float x, float y) {
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (!boxes[i].IsEmpty() && boxes[i].Contains(x, y)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t pin_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    using Clock = std::chrono::steady_clock;
+    auto us = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::micro>(b - a).count(); };
+
+    // Pads on a 25 mil pitch with some overlap, a few NC/GND pins left out,
+    // plus part extents over runs of 16 pins
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> size(4.0f, 20.0f);
+    const size_t columns = 400;
+    std::vector<SpatialGrid::Box> pins(pin_count);
+    for (size_t i = 0; i < pin_count; ++i) {
+        if (rng() % 20 == 0) continue; // not hoverable
+        float x = static_cast<float>(i % columns) * 25.0f;
+        float y = static_cast<float>(i / columns) * 25.0f;
+        float r = size(rng);
+        pins[i] = {x - r, y - r, x + r, y + r};
+    }
+    std::vector<SpatialGrid::Box> parts;
+    for (size_t i = 0; i + 16 <= pin_count; i += 16) {
+        float x0 = static_cast<float>(i % columns) * 25.0f;
+        float y0 = static_cast<float>(i / columns) * 25.0f;
+        parts.push_back({x0 - 10.0f, y0 - 10.0f, x0 + 15 * 25.0f + 10.0f, y0 + 10.0f});
+    }
+
+    SpatialGrid pin_grid, part_grid;
+    auto t0 = Clock::now();
+    pin_grid.Build(pins);
+    part_grid.Build(parts);
+    auto t1 = Clock::now();
+    std::cout << pin_count << " pins, " << parts.size() << " parts; grid build " << us(t0, t1) / 1000.0 << " ms" << std::endl;
+
+    const float board_w = columns * 25.0f;
+    const float board_h = static_cast<float>((pin_count + columns - 1) / columns) * 25.0f;
+    std::uniform_real_distribution<float> qx(-50.0f, board_w + 50.0f), qy(-50.0f, board_h + 50.0f);
+    const int queries = 200000;
+    std::vector<float> xs(queries), ys(queries);
+    for (int q = 0; q < queries; ++q) { xs[q] = qx(rng); ys[q] = qy(rng); }
+
+    long long checksum = 0;
+    t0 = Clock::now();
+    for (int q = 0; q < queries; ++q) checksum += pin_grid.FindFirst(xs[q], ys[q]) + part_grid.FindFirst(xs[q], ys[q]);
+    t1 = Clock::now();
+    std::cout << "Grid hover query (pin + part): " << us(t0, t1) / queries << " us" << std::endl;
+
+    // The linear scan is slow; time and verify on a subset
+    const int linear_queries = 2000;
+    int mismatches = 0;
+    t0 = Clock::now();
+    for (int q = 0; q < linear_queries; ++q) {
+        int pin = LinearFirst(pins, xs[q], ys[q]);
+        int part = LinearFirst(parts, xs[q], ys[q]);
+        if (pin != pin_grid.FindFirst(xs[q], ys[q]) || part != part_grid.FindFirst(xs[q], ys[q])) mismatches++;
+    }
+    t1 = Clock::now();
+    std::cout << "Linear hover query (pin + part, incl. grid check): " << us(t0, t1) / linear_queries << " us" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+    // Viewport queries: zoomed in, a few percent, a quarter and all of the board
+    std::vector<uint32_t> visible, expected;
+    const float spans[4] = {400.0f, board_w * 0.2f, board_w * 0.5f, board_w * 2.0f};
+    for (float span : spans) {
+        const int views = 200;
+        double grid_us = 0.0, linear_us = 0.0;
+        size_t drawn = 0;
+        for (int v = 0; v < views; ++v) {
+            float cx = qx(rng), cy = qy(rng);
+            SpatialGrid::Box view{cx - span * 0.5f, cy - span * 0.3f, cx + span * 0.5f, cy + span * 0.3f};
+            t0 = Clock::now();
+            pin_grid.Query(view, visible);
+            t1 = Clock::now();
+            expected.clear();
+            for (size_t i = 0; i < pins.size(); ++i) {
+                if (!pins[i].IsEmpty() && pins[i].Overlaps(view)) expected.push_back(static_cast<uint32_t>(i));
+            }
+            auto t2 = Clock::now();
+            grid_us += us(t0, t1);
+            linear_us += us(t1, t2);
+            drawn += visible.size();
+            if (visible != expected) mismatches++;
+        }
+        std::cout << "Viewport " << span << " wide: " << drawn / views << " pins in view, grid " << grid_us / views
+                  << " us, linear " << linear_us / views << " us" << std::endl;
+    }
+
+    if (mismatches == 0) {
+        std::cout << "Grid queries match the linear scans" << std::endl;
+        return 0;
+    }
+    std::cout << "FAIL: " << mismatches << " queries differ from the linear scans" << std::endl;
+    return 1;
+}
@@ -0,0 +1,205 @@
+// XZZ embedded JSON (part/net aliases, diode readings): streaming
+// XZZPCBFile::ParseJsonTables() vs the old copy + find() extraction
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_xzz_json.cpp
+//       src/viewers/pcb/format/XZZPCBFile.cpp src/viewers/pcb/format/ByteScan.cpp src/viewers/pcb/format/JsonScanner.cpp
+//       src/viewers/pcb/format/des.cpp src/viewers/pcb/format/BRDFileBase.cpp src/viewers/pcb/core/MappedFile.cpp src/viewers/pcb/core/Utils.cpp
+//       src/viewers/pcb/core/BRDTypes.cpp -o bench_xzz_json
+//   ./bench_xzz_json [part_count]   (default 40000)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "XZZPCBFile.h"
+
+namespace {
+
+using Aliases = std::unordered_map<std::string, std::string>;
+using Diodes = std::unordered_map<std::string, Aliases>;
+
+// Same shape as the object XZZ files carry after the post-v6 marker
+std::string MakeJson(size_t part_count) {
+    std::mt19937 rng(0x5A5A);
+    std::string json = "{\"part\":[";
+    for (size_t i = 0; i < part_count; ++i) {
+        if (i) json += ',';
+        json += "{\"reference\":\"U" + std::to_string(i) + "\",\"alias\":\"J" + std::to_string(10000 + i) + "\",\"pad\":[";
+        const int pads = 2 + static_cast<int>(rng() % 14);
+        for (int p = 0; p < pads; ++p) {
+            if (p) json += ',';
+            json += "{\"name\":\"" + std::to_string(p + 1) + "\",\"diode\":\"0." + std::to_string(100 + rng() % 900) + "\"}";
+        }
+        json += "]}";
+    }
+    json += "],\"net\":[";
+    for (size_t i = 0; i < part_count; ++i) {
+        if (i) json += ',';
+        json += "{\"name\":\"Net" + std::to_string(i) + "\",\"alias\":\"PP_RAIL_" + std::to_string(i) + "\"}";
+    }
+    json += "]}";
+    return json;
+}
+
+// Extracts "key":"value" from obj, as the old parser did
+std::string LegacyField(const std::string& obj, const std::string& pattern) {
+    size_t start = obj.find(pattern);
+    if (start == std::string::npos) return {};
+    start += pattern.size();
+    size_t end = obj.find('"', start);
+    return end == std::string::npos ? std::string() : obj.substr(start, end - start);
+}
+
+// Index of the brace closing the object opened at start, or npos
+size_t LegacyObjectEnd(const std::string& s, size_t start) {
+    int count = 0;
+    for (size_t i = start; i < s.size(); ++i) {
+        if (s[i] == '{') count++;
+        else if (s[i] == '}' && --count == 0) return i;
+    }
+    return std::string::npos;
+}
+
+// The old XZZPCBFile::ParseJsonData, minus its logging
+void LegacyParse(ByteView buf, Aliases& part_aliases, Aliases& net_aliases, Diodes& diodes) {
+    std::string json_str(buf.begin(), buf.end());
+    size_t json_begin = json_str.find('{');
+    if (json_begin == std::string::npos) return;
+    size_t json_end = LegacyObjectEnd(json_str, json_begin);
+    if (json_end == std::string::npos) return;
+    std::string json_data = json_str.substr(json_begin, json_end - json_begin + 1);
+
+    size_t part_array_start = json_data.find("\"part\":[");
+    if (part_array_start == std::string::npos) return;
+    size_t pos = part_array_start + 8;
+    while (pos < json_data.size()) {
+        size_t part_start = json_data.find('{', pos);
+        if (part_start == std::string::npos) break;
+        size_t part_end = LegacyObjectEnd(json_data, part_start);
+        if (part_end == std::string::npos) break;
+        std::string part_obj = json_data.substr(part_start, part_end - part_start + 1);
+
+        std::string reference = LegacyField(part_obj, "\"reference\":\"");
+        std::string alias = LegacyField(part_obj, "\"alias\":\"");
+        if (!reference.empty() && !alias.empty()) part_aliases[reference] = alias;
+
+        size_t pad_array_start = part_obj.find("\"pad\":[");
+        if (pad_array_start != std::string::npos) {
+            pad_array_start += 7;
+            size_t pad_array_end = pad_array_start;
+            int bracket_count = 1;
+            for (size_t i = pad_array_start; i < part_obj.size(); ++i) {
+                if (part_obj[i] == '[') bracket_count++;
+                else if (part_obj[i] == ']' && --bracket_count == 0) { pad_array_end = i; break; }
+            }
+            std::string pad_array = part_obj.substr(pad_array_start, pad_array_end - pad_array_start);
+            size_t pad_pos = 0;
+            while (pad_pos < pad_array.size()) {
+                size_t pad_start = pad_array.find('{', pad_pos);
+                if (pad_start == std::string::npos) break;
+                size_t pad_end = pad_array.find('}', pad_start);
+                if (pad_end == std::string::npos) break;
+                std::string pad_obj = pad_array.substr(pad_start, pad_end - pad_start + 1);
+                std::string pin_name = LegacyField(pad_obj, "\"name\":\"");
+                std::string diode = LegacyField(pad_obj, "\"diode\":\"");
+                if (!reference.empty() && !pin_name.empty() && !diode.empty()) diodes[reference][pin_name] = diode;
+                pad_pos = pad_end + 1;
+            }
+        }
+        pos = part_end + 1;
+    }
+
+    size_t net_array_start = json_data.find("\"net\":[");
+    if (net_array_start == std::string::npos) return;
+    size_t net_pos = net_array_start + 7;
+    while (net_pos < json_data.size()) {
+        size_t net_start = json_data.find('{', net_pos);
+        if (net_start == std::string::npos) break;
+        size_t net_end = LegacyObjectEnd(json_data, net_start);
+        if (net_end == std::string::npos) break;
+        std::string net_obj = json_data.substr(net_start, net_end - net_start + 1);
+        std::string name = LegacyField(net_obj, "\"name\":\"");
+        std::string alias = LegacyField(net_obj, "\"alias\":\"");
+        if (!name.empty() && !alias.empty()) net_aliases[name] = alias;
+        net_pos = net_end + 1;
+    }
+}
+
+ByteView View(const std::string& s) { return ByteView(s.data(), s.size()); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t part_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 40000;
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    const std::string json = MakeJson(part_count);
+    std::cout << "Synthetic JSON: " << part_count << " parts and nets, " << json.size() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    Aliases parts, nets, legacy_parts, legacy_nets;
+    Diodes diodes, legacy_diodes;
+    auto t0 = Clock::now();
+    bool ok = XZZPCBFile::ParseJsonTables(View(json), parts, nets, diodes);
+    auto t1 = Clock::now();
+    LegacyParse(View(json), legacy_parts, legacy_nets, legacy_diodes);
+    auto t2 = Clock::now();
+
+    const double mb = json.size() / (1024.0 * 1024.0);
+    std::cout << "ParseJsonTables (streaming): " << ms(t0, t1) << " ms (" << mb / (ms(t0, t1) / 1000.0) << " MB/s)" << std::endl;
+    std::cout << "Legacy copy + find(): " << ms(t1, t2) << " ms (" << mb / (ms(t1, t2) / 1000.0) << " MB/s)" << std::endl;
+
+    check(ok, "well-formed JSON accepted");
+    check(parts == legacy_parts, "part aliases match the legacy parser");
+    check(nets == legacy_nets, "net aliases match the legacy parser");
+    check(diodes == legacy_diodes, "diode readings match the legacy parser");
+    check(parts.size() == part_count && nets.size() == part_count, "every part and net recorded");
+
+    // Inputs the old find() scan misread: key order, escapes, numbers,
+    // unknown members with nested braces, whitespace
+    {
+        Aliases p, n;
+        Diodes d;
+        const std::string odd =
+            " { \"meta\" : {\"note\":\"{\\\"part\\\":[\"}, \"part\" : [ {\"pad\":[{\"diode\":0.45,\"name\":1}],"
+            " \"alias\":\"J\\u00e9\\\"1\\\"\", \"extra\":[1,{\"a\":null}], \"reference\":\"R1\"} ],"
+            " \"net\":[{\"alias\":\"PP\\/3V3\",\"name\":\"N1\",\"unused\":true}] } trailing";
+        check(XZZPCBFile::ParseJsonTables(View(odd), p, n, d), "reordered/escaped JSON accepted");
+        check(p.size() == 1 && p["R1"] == "J\xC3\xA9\"1\"", "alias with escapes after the pad array");
+        check(d["R1"].size() == 1 && d["R1"]["1"] == "0.45", "numeric pin name and diode value");
+        check(n.size() == 1 && n["N1"] == "PP/3V3", "net alias with escaped slash");
+    }
+
+    // Truncated or malformed input is reported and keeps the entries before the error
+    {
+        Aliases p, n;
+        Diodes d;
+        const std::string cut = json.substr(0, json.size() / 3);
+        check(!XZZPCBFile::ParseJsonTables(View(cut), p, n, d), "truncated JSON rejected");
+        check(!p.empty() && p.size() < part_count && n.empty(), "parts before the cut kept");
+        for (const char* bad : {"{\"part\":[{\"reference\":\"A\",}]}", "{\"part\":[{\"reference\" \"A\"}]}", "[]", "",
+                                "{\"net\":[{\"name\":\"A\",\"alias\":\"B\"}]]"}) {
+            Aliases bp, bn;
+            Diodes bd;
+            check(!XZZPCBFile::ParseJsonTables(View(bad), bp, bn, bd), std::string("rejects ") + bad);
+        }
+    }
+
+    if (failures == 0) {
+        std::cout << "Streaming JSON tables match the legacy parser" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " JSON check(s) failed" << std::endl;
+    return 1;
+}
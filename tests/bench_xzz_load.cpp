@@ -0,0 +1,180 @@
+// XZZ load profile on a synthetic board: outline, copper traces/arcs and test
+// pads, parsed through XZZPCBFile::Load. Prints the load time and a checksum
+// of every stored coordinate, so two builds can be compared for speed and
+// byte-identical geometry, and checks the outline-derived translation.
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_xzz_load.cpp
+//       src/viewers/pcb/format/XZZPCBFile.cpp src/viewers/pcb/format/ByteScan.cpp src/viewers/pcb/format/JsonScanner.cpp
+//       src/viewers/pcb/format/des.cpp src/viewers/pcb/format/BRDFileBase.cpp src/viewers/pcb/core/MappedFile.cpp
+//       src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o bench_xzz_load
+//   ./bench_xzz_load [trace_count]   (default 2000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "XZZPCBFile.h"
+
+namespace {
+
+const int kOriginX = 1234, kOriginY = 5678; // outline minimum, board units
+const int kScale = 10000;
+
+void PutU32(std::vector<char>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void PutBlock(std::vector<char>& out, uint8_t type, const std::vector<uint32_t>& fields, const std::string& tail = {}) {
+    out.push_back(static_cast<char>(type));
+    PutU32(out, static_cast<uint32_t>(fields.size() * 4 + tail.size()));
+    for (uint32_t f : fields) PutU32(out, f);
+    out.insert(out.end(), tail.begin(), tail.end());
+}
+
+uint32_t Raw(int units) { return static_cast<uint32_t>(units * kScale); }
+
+std::vector<char> MakeFile(size_t trace_count, size_t pad_count) {
+    std::mt19937 rng(42);
+    const int width = 40000, height = 25000;
+    auto rx = [&]() { return kOriginX + static_cast<int>(rng() % width); };
+    auto ry = [&]() { return kOriginY + static_cast<int>(rng() % height); };
+
+    std::vector<char> nets;
+    for (uint32_t i = 1; i <= 500; ++i) {
+        std::string name = "NET" + std::to_string(i);
+        PutU32(nets, static_cast<uint32_t>(8 + name.size()));
+        PutU32(nets, i);
+        nets.insert(nets.end(), name.begin(), name.end());
+    }
+
+    std::vector<char> blocks;
+    // Outline rectangle on layer 28 with a rounded corner on layer 17
+    const int x0 = kOriginX, y0 = kOriginY, x1 = kOriginX + width, y1 = kOriginY + height;
+    PutBlock(blocks, 0x05, {28, Raw(x0 + 100), Raw(y0), Raw(x1), Raw(y0), 0});
+    PutBlock(blocks, 0x05, {28, Raw(x1), Raw(y0), Raw(x1), Raw(y1), 0});
+    PutBlock(blocks, 0x05, {28, Raw(x1), Raw(y1), Raw(x0), Raw(y1), 0});
+    PutBlock(blocks, 0x05, {28, Raw(x0), Raw(y1), Raw(x0), Raw(y0 + 100), 0});
+    PutBlock(blocks, 0x01, {17, Raw(x0 + 100), Raw(y0 + 100), Raw(100), Raw(180), Raw(270), 0});
+    for (size_t i = 0; i < trace_count; ++i) {
+        const uint32_t layer = 1 + static_cast<uint32_t>(rng() % 4);
+        const uint32_t net = 1 + static_cast<uint32_t>(rng() % 500);
+        if (i % 16 == 0) {
+            PutBlock(blocks, 0x01, {layer, Raw(rx()), Raw(ry()), Raw(5), Raw(0), Raw(90), 2000, net});
+        } else {
+            PutBlock(blocks, 0x05, {layer, Raw(rx()), Raw(ry()), Raw(rx()), Raw(ry()), 2000, net});
+        }
+    }
+    for (size_t i = 0; i < pad_count; ++i) {
+        std::string name = "TP" + std::to_string(i);
+        std::string tail = name;
+        tail.resize(name.size() + 9, '\0'); // width, height, shape
+        std::memcpy(&tail[name.size()], "\x10\x27\x00\x00\x10\x27\x00\x00\x01", 9);
+        tail.resize(tail.size() + 12, '\0');
+        const uint32_t net = 1 + static_cast<uint32_t>(i % 500);
+        std::memcpy(&tail[tail.size() - 12], &net, 4);
+        PutBlock(blocks, 0x09, {static_cast<uint32_t>(i), Raw(rx()), Raw(ry()), 0, 0, static_cast<uint32_t>(name.size())}, tail);
+    }
+
+    std::vector<char> file(0x40, '\0');
+    std::memcpy(file.data(), "XZZPCB", 6);
+    const uint32_t net_start = 0x40, main_start = net_start + 4 + static_cast<uint32_t>(nets.size());
+    const uint32_t main_offset = main_start - 0x20, net_offset = net_start - 0x20; // offsets are stored minus 0x20
+    std::memcpy(&file[0x20], &main_offset, 4);
+    std::memcpy(&file[0x28], &net_offset, 4);
+    PutU32(file, static_cast<uint32_t>(nets.size()));
+    file.insert(file.end(), nets.begin(), nets.end());
+    PutU32(file, static_cast<uint32_t>(blocks.size()));
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+uint64_t Mix(uint64_t h, int64_t v) { return (h ^ static_cast<uint64_t>(v)) * 0x100000001B3ull; }
+
+uint64_t Checksum(const BRDFileBase& board) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto point = [&](const BRDPoint& p) { h = Mix(Mix(h, p.x), p.y); };
+    for (const auto& s : board.outline_segments) { point(s.first); point(s.second); }
+    for (const auto& a : board.outline_arcs) point(a.center);
+    for (const auto& pin : board.pins) point(pin.pos);
+    for (const auto& c : board.circles) point(c.center);
+    for (const auto& r : board.rectangles) point(r.center);
+    for (const auto& layer : board.trace_layers) {
+        for (const auto& t : layer.segments) { point(t.a); point(t.b); h = Mix(h, t.net); }
+        for (const auto& a : layer.arcs) point(a.center);
+    }
+    return h;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t trace_count = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 2000000;
+    const size_t pad_count = 2000;
+    using Clock = std::chrono::steady_clock;
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    const std::vector<char> file = MakeFile(trace_count, pad_count);
+    std::cout << "Synthetic XZZ: " << trace_count << " traces/arcs, " << pad_count << " test pads, "
+              << file.size() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    // Best of several loads; the loader logs per test pad, so its output is dropped
+    std::unique_ptr<XZZPCBFile> loaded;
+    bool ok = false;
+    double best_ms = 0.0;
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    for (int run = 0; run < 5; ++run) {
+        auto attempt = std::make_unique<XZZPCBFile>();
+        auto t0 = Clock::now();
+        ok = attempt->Load(ByteView(file.data(), file.size()), "synthetic.pcb");
+        auto t1 = Clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (run == 0 || ms < best_ms) best_ms = ms;
+        loaded = std::move(attempt);
+        sink.str({});
+    }
+    std::cout.rdbuf(saved);
+    const XZZPCBFile& board = *loaded;
+
+    std::cout << "Load (best of 5): " << best_ms << " ms" << std::endl;
+    std::cout << "Geometry checksum: " << std::hex << Checksum(board) << std::dec << std::endl;
+
+    check(ok, "synthetic file loads");
+    check(board.TraceSegmentCount() + 1 >= trace_count - trace_count / 16, "traces parsed");
+    check(board.pins.size() == pad_count, "test pads parsed");
+    int min_x = 1 << 30, min_y = 1 << 30;
+    for (const auto& s : board.outline_segments) {
+        min_x = std::min({min_x, s.first.x, s.second.x});
+        min_y = std::min({min_y, s.first.y, s.second.y});
+    }
+    check(min_x == 0 && min_y == 0, "outline starts at the origin after translation");
+    bool in_board = true;
+    for (const auto& pin : board.pins) in_board = in_board && pin.pos.x >= 0 && pin.pos.y >= 0 && pin.pos.x < 40000 && pin.pos.y < 25000;
+    check(in_board, "pins translated with the outline");
+    for (const auto& layer : board.trace_layers) {
+        for (const auto& t : layer.segments) in_board = in_board && t.a.x >= 0 && t.a.y >= 0 && t.b.x < 40000 && t.b.y < 25000;
+    }
+    check(in_board, "traces translated with the outline");
+
+    if (failures == 0) {
+        std::cout << "Synthetic XZZ board loaded and translated" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " load check(s) failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,157 @@
+// XZZ header pass: fused XOR decode + marker scan (XZZPCBFile::DecodeInPlace /
+// FindMarkers over ByteScan) vs the old std::search calls and byte-wise XOR
+//
+// Build (from repo root; add -mavx2 to try the AVX2 path):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/bench_xzz_scan.cpp
+//       src/viewers/pcb/format/XZZPCBFile.cpp src/viewers/pcb/format/ByteScan.cpp src/viewers/pcb/format/JsonScanner.cpp
+//       src/viewers/pcb/format/des.cpp src/viewers/pcb/format/BRDFileBase.cpp src/viewers/pcb/core/MappedFile.cpp
+//       src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o bench_xzz_scan
+//   ./bench_xzz_scan [max_mb]   (default 100; runs 10, 50 and 100 MB up to max_mb)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ByteScan.h"
+#include "XZZPCBFile.h"
+
+namespace {
+
+const uint8_t kPostV6Marker[] = {0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
+const uint8_t kJsonMarker[] = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
+const char kPartArray[] = "\"part\":[";
+
+using Markers = XZZPCBFile::Markers;
+
+size_t Search(const std::vector<char>& buf, const void* pattern, size_t size) {
+    const char* p = static_cast<const char*>(pattern);
+    auto it = std::search(buf.begin(), buf.end(), p, p + size);
+    return it == buf.end() ? ByteView::npos : static_cast<size_t>(it - buf.begin());
+}
+
+// What XZZPCBFile::LoadInPlace and ParseXZZPCBOriginal did before: find the
+// post-v6 marker, XOR byte by byte up to it, then search the decoded buffer
+Markers Legacy(std::vector<char>& buf) {
+    Markers m;
+    m.post_v6 = Search(buf, kPostV6Marker, sizeof(kPostV6Marker));
+    if (buf.size() > 0x10 && buf[0x10] != 0x00) {
+        uint8_t xor_key = buf[0x10];
+        size_t xor_end = m.post_v6 != ByteView::npos ? m.post_v6 : buf.size();
+        for (size_t i = 0; i < xor_end; ++i) buf[i] ^= xor_key;
+    }
+    m.json = Search(buf, kJsonMarker, sizeof(kJsonMarker));
+    if (m.json == ByteView::npos) m.part_array = Search(buf, kPartArray, std::strlen(kPartArray));
+    return m;
+}
+
+struct Layout {
+    const char* name;
+    bool obfuscated;
+    double v6_at;   // fraction of the file, < 0 for none
+    double json_at; // fraction of the file, < 0 for none
+    bool part_array;
+};
+
+// Random board-like bytes with the markers placed as described; obfuscated
+// files are XORed up to the post-v6 marker like the real ones
+std::vector<char> MakeFile(size_t size, const Layout& layout, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<char> buf(size);
+    for (char& c : buf) c = static_cast<char>(rng());
+    std::memcpy(buf.data(), "XZZPCB", 6);
+    buf[0x10] = 0;
+    auto put = [&](double at, const void* bytes, size_t n) {
+        size_t pos = std::min(static_cast<size_t>(at * size), size - n);
+        std::memcpy(buf.data() + pos, bytes, n);
+        return pos;
+    };
+    size_t v6 = layout.v6_at >= 0 ? put(layout.v6_at, kPostV6Marker, sizeof(kPostV6Marker)) : size;
+    if (layout.json_at >= 0) put(layout.json_at, kJsonMarker, sizeof(kJsonMarker));
+    if (layout.part_array) put(0.9, kPartArray, std::strlen(kPartArray));
+    if (layout.obfuscated) {
+        const char key = 0x5C;
+        for (size_t i = 0; i < v6; ++i) buf[i] ^= key;
+        buf[0x10] = key; // decodes to 0 like in real files
+    }
+    return buf;
+}
+
+bool Same(const Markers& a, const Markers& b, bool compare_part) {
+    return a.post_v6 == b.post_v6 && a.json == b.json && (!compare_part || a.part_array == b.part_array);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t max_mb = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 100;
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    const Layout layouts[] = {
+        {"obfuscated, post-v6 at 95%, JSON after it", true, 0.95, 0.97, false},
+        {"obfuscated, no post-v6, JSON at 80%", true, -1, 0.8, false},
+        {"plain, post-v6 at 95%, JSON after it", false, 0.95, 0.97, false},
+        {"plain, no markers, part array at 90%", false, -1, -1, true},
+    };
+    std::cout << "ByteScan built for " << ByteScan::Isa() << std::endl;
+
+    for (size_t mb : {10, 50, 100}) {
+        if (mb > max_mb) break;
+        const size_t size = mb << 20;
+        for (const Layout& layout : layouts) {
+            std::vector<char> legacy_buf = MakeFile(size, layout, 7);
+            std::vector<char> buf = legacy_buf;
+
+            auto t0 = Clock::now();
+            Markers legacy = Legacy(legacy_buf);
+            auto t1 = Clock::now();
+            Markers fused = layout.obfuscated ? XZZPCBFile::DecodeInPlace(buf) : XZZPCBFile::FindMarkers(buf);
+            auto t2 = Clock::now();
+
+            std::cout << mb << " MB, " << layout.name << ": legacy " << ms(t0, t1) << " ms, fused " << ms(t1, t2)
+                      << " ms (" << ms(t0, t1) / ms(t1, t2) << "x)" << std::endl;
+            check(Same(legacy, fused, legacy.json == ByteView::npos), std::string("markers match for ") + layout.name);
+            check(buf == legacy_buf, std::string("decoded bytes match for ") + layout.name);
+        }
+    }
+
+    // Markers at random places, including block edges, the tail and partial
+    // markers; small files so every position class is hit
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 3000; ++round) {
+        const size_t size = 20 + rng() % 300;
+        Layout layout{"random", (rng() & 1) != 0, (rng() % 3) ? (rng() % 1000) / 1000.0 : -1.0,
+                      (rng() % 3) ? (rng() % 1000) / 1000.0 : -1.0, (rng() % 2) != 0};
+        std::vector<char> legacy_buf = MakeFile(size, layout, round);
+        if (rng() % 4 == 0) { // partial marker just before a full one
+            size_t at = rng() % (size - 6);
+            std::memcpy(legacy_buf.data() + at, kPostV6Marker, 6);
+        }
+        std::vector<char> buf = legacy_buf;
+        Markers legacy = Legacy(legacy_buf);
+        Markers fused = XZZPCBFile::DecodeInPlace(buf);
+        if (!Same(legacy, fused, legacy.json == ByteView::npos) || buf != legacy_buf) {
+            check(false, "random layout " + std::to_string(round) + " (size " + std::to_string(size) + ")");
+            if (failures > 10) break;
+        }
+    }
+
+    if (failures == 0) {
+        std::cout << "Fused scan matches the legacy search and decode" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " scan check(s) failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,91 @@
+// Analytic arcs: bounds and zoom-adaptive tessellation
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -Isrc/viewers/pcb/core -Isrc/viewers/pcb/rendering tests/test_arc_tessellator.cpp
+//       src/viewers/pcb/rendering/ArcTessellator.cpp src/viewers/pcb/core/BRDTypes.cpp -o test_arc_tessellator
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "ArcTessellator.h"
+
+namespace {
+
+bool Near(float a, float b, float eps = 1e-3f) { return std::fabs(a - b) <= eps; }
+
+// Largest distance from the true arc of any chord midpoint, in board units
+float MaxChordError(const BRDArc& arc, const ArcTessellator::Point* points, uint32_t count) {
+    float worst = 0.0f;
+    for (uint32_t i = 0; i + 1 < count; ++i) {
+        float mx = 0.5f * (points[i].x + points[i + 1].x) - arc.center.x;
+        float my = 0.5f * (points[i].y + points[i + 1].y) - arc.center.y;
+        worst = std::max(worst, arc.radius - std::sqrt(mx * mx + my * my));
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing arc tessellation..." << std::endl;
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // Bounds: quarter arc from 0 to 90 degrees, then one crossing 180 clockwise
+    float min_x, min_y, max_x, max_y;
+    BRDArc quarter(BRDPoint(100, 50), 10.0f, 0.0f, 90.0f);
+    quarter.GetBounds(min_x, min_y, max_x, max_y);
+    check(Near(min_x, 100) && Near(min_y, 50) && Near(max_x, 110) && Near(max_y, 60), "quarter arc bounds");
+    BRDArc around_left(BRDPoint(0, 0), 10.0f, 225.0f, -90.0f); // 225 -> 135 through 180
+    around_left.GetBounds(min_x, min_y, max_x, max_y);
+    check(Near(min_x, -10) && Near(max_x, -7.0711f) && Near(min_y, -7.0711f) && Near(max_y, 7.0711f),
+          "clockwise arc through 180 degrees");
+    BRDArc wrapped(BRDPoint(0, 0), 10.0f, 350.0f, 20.0f); // crosses 360
+    wrapped.GetBounds(min_x, min_y, max_x, max_y);
+    check(Near(max_x, 10), "arc crossing 360 reaches +x");
+
+    // Segment counts grow with the on-screen radius and stay capped
+    check(ArcTessellator::SegmentCount(0.1f, 90.0f) == 1, "sub-pixel arc is one chord");
+    check(ArcTessellator::SegmentCount(10.0f, 90.0f) < ArcTessellator::SegmentCount(1000.0f, 90.0f), "more chords when larger");
+    check(ArcTessellator::SegmentCount(1e7f, 360.0f) == ArcTessellator::kMaxSegments, "chord count capped");
+
+    ArcTessellator tess;
+    BRDArc arcs[2] = {BRDArc(BRDPoint(0, 0), 50.0f, 30.0f, 120.0f), BRDArc(BRDPoint(10, 10), 5.0f, 180.0f, -90.0f)};
+    tess.Reset(2);
+    for (float zoom : {0.5f, 1.0f, 4.0f, 20.0f}) {
+        tess.SetZoom(zoom);
+        uint32_t count = 0;
+        const ArcTessellator::Point* p = tess.Polyline(arcs[0], 0, count);
+        check(p && count >= 2, "polyline at zoom " + std::to_string(zoom));
+        if (!p || count < 2) continue;
+        check(Near(p[0].x, 50 * std::cos(30 * 3.14159265f / 180)) && Near(p[0].y, 25.0f), "starts at start angle");
+        check(Near(p[count - 1].x, 50 * std::cos(150 * 3.14159265f / 180)) && Near(p[count - 1].y, 25.0f), "ends at start + sweep");
+        check(MaxChordError(arcs[0], p, count) * zoom <= ArcTessellator::kTolerancePx + 1e-3f,
+              "chord error within tolerance at zoom " + std::to_string(zoom));
+    }
+
+    // Same bucket reuses polylines; a new bucket rebuilds them
+    tess.SetZoom(4.0f);
+    uint32_t count = 0;
+    tess.Polyline(arcs[1], 1, count);
+    size_t cached = tess.CachedPoints();
+    tess.SetZoom(4.05f);
+    tess.Polyline(arcs[1], 1, count);
+    check(tess.CachedPoints() == cached, "same zoom bucket reuses the polyline");
+    tess.SetZoom(16.0f);
+    check(tess.CachedPoints() == 0, "new zoom bucket drops cached polylines");
+    check(tess.Polyline(arcs[1], 5, count) == nullptr && count == 0, "out of range index");
+
+    if (failures == 0) {
+        std::cout << "All arc tessellation tests passed" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " arc tessellation test(s) failed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,165 @@
+// Round-trip and rejection checks for the board snapshot cache
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -pthread -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format tests/test_board_cache.cpp
+//       src/viewers/pcb/format/BoardCacheFile.cpp src/viewers/pcb/format/BRDFileBase.cpp
+//       src/viewers/pcb/core/MappedFile.cpp src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp -o test_board_cache
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "BoardCacheFile.h"
+
+namespace {
+
+// Minimal concrete board to fill in by hand
+class TestBoard : public BRDFileBase {
+public:
+    bool Load(ByteView, const std::string& = "") override { return true; }
+    bool VerifyFormat(ByteView) override { return true; }
+};
+
+bool SameBoard(const BRDFileBase& a, const BRDFileBase& b) {
+    if (a.num_parts != b.num_parts || a.num_pins != b.num_pins || a.valid != b.valid) return false;
+    if (a.parts.size() != b.parts.size() || a.pins.size() != b.pins.size() || a.nails.size() != b.nails.size()) return false;
+    for (size_t i = 0; i < a.parts.size(); ++i) {
+        const auto& x = a.parts[i];
+        const auto& y = b.parts[i];
+        if (x.name != y.name || x.mfgcode != y.mfgcode || x.mounting_side != y.mounting_side ||
+            x.end_of_pins != y.end_of_pins || x.p1 != y.p1 || x.p2 != y.p2) return false;
+    }
+    for (size_t i = 0; i < a.pins.size(); ++i) {
+        const auto& x = a.pins[i];
+        const auto& y = b.pins[i];
+        if (x.pos != y.pos || x.part != y.part || x.side != y.side || a.PinNet(x) != b.PinNet(y) || x.radius != y.radius ||
+            a.PinSnum(x) != b.PinSnum(y) || a.PinName(x) != b.PinName(y) || x.comment != y.comment) return false;
+    }
+    for (size_t i = 0; i < a.nails.size(); ++i) {
+        if (a.nails[i].pos != b.nails[i].pos || a.nails[i].net != b.nails[i].net) return false;
+    }
+    if (a.outline_segments != b.outline_segments || a.part_outline_segments != b.part_outline_segments) return false;
+    if (a.circles.size() != b.circles.size() || a.rectangles.size() != b.rectangles.size() || a.ovals.size() != b.ovals.size()) return false;
+    for (size_t i = 0; i < a.circles.size(); ++i) {
+        if (a.circles[i].center != b.circles[i].center || a.circles[i].radius != b.circles[i].radius || a.circles[i].g != b.circles[i].g) return false;
+    }
+    for (size_t i = 0; i < a.rectangles.size(); ++i) {
+        if (a.rectangles[i].width != b.rectangles[i].width || a.rectangles[i].rotation != b.rectangles[i].rotation) return false;
+    }
+    for (size_t i = 0; i < a.ovals.size(); ++i) {
+        if (a.ovals[i].height != b.ovals[i].height || a.ovals[i].center != b.ovals[i].center) return false;
+    }
+    if (a.trace_nets != b.trace_nets || a.trace_layers.size() != b.trace_layers.size()) return false;
+    for (size_t l = 0; l < a.trace_layers.size(); ++l) {
+        const auto& x = a.trace_layers[l];
+        const auto& y = b.trace_layers[l];
+        if (x.layer != y.layer || x.segments.size() != y.segments.size()) return false;
+        for (size_t i = 0; i < x.segments.size(); ++i) {
+            if (x.segments[i].a != y.segments[i].a || x.segments[i].b != y.segments[i].b ||
+                x.segments[i].width != y.segments[i].width || x.segments[i].net != y.segments[i].net) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing board snapshot cache..." << std::endl;
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // XXH64 known answers
+    check(BoardCacheFile::ContentHash(ByteView("", 0)) == 0xEF46DB3751D8E999ULL, "hash of empty input");
+    check(BoardCacheFile::ContentHash(ByteView("abc", 3)) == 0x44BC2CF5AD770999ULL, "hash of \"abc\"");
+
+    TestBoard board;
+    for (int p = 0; p < 50; ++p) {
+        BRDPart part;
+        part.name = "U" + std::to_string(p);
+        part.mounting_side = p % 2 ? BRDPartMountingSide::Bottom : BRDPartMountingSide::Top;
+        part.p1 = BRDPoint(p * 10, -p);
+        part.p2 = BRDPoint(p * 10 + 5, p);
+        for (int n = 0; n < 8; ++n) {
+            BRDPin pin;
+            pin.pos = BRDPoint(p * 10 + n, n);
+            pin.part = p + 1;
+            pin.side = p % 2 ? BRDPinSide::Bottom : BRDPinSide::Top;
+            board.SetPinNet(pin, n == 0 ? "GND" : "NET" + std::to_string(p * 8 + n));
+            pin.radius = 0.25 * (n + 1);
+            board.SetPinSnum(pin, std::to_string(n + 1));
+            pin.name_id = pin.snum_id;
+            pin.comment = n == 1 ? "0.512" : "";
+            board.pins.push_back(pin);
+            board.circles.emplace_back(pin.pos, 3.5f, 0.5f, 0.25f, 0.0f, 1.0f);
+        }
+        part.end_of_pins = static_cast<unsigned int>(board.pins.size());
+        board.parts.push_back(part);
+        board.part_outline_segments.emplace_back(part.p1, part.p2);
+        board.rectangles.emplace_back(part.p1, 4.0f, 2.0f, 90.0f);
+        board.ovals.emplace_back(part.p2, 1.5f, 3.0f, 45.0f);
+    }
+    BRDNail nail;
+    nail.pos = BRDPoint(7, 9);
+    nail.net = "GND";
+    board.nails.push_back(nail);
+    board.outline_segments.emplace_back(BRDPoint(0, 0), BRDPoint(500, 0));
+    board.trace_nets = {"NET1", "TRACE_ONLY"};
+    board.GetTraceLayer(16).segments.emplace_back(BRDPoint(0, 0), BRDPoint(10, 0), 0.5f, 1);
+    board.GetTraceLayer(1).segments.emplace_back(BRDPoint(1, 0), BRDPoint(1, 20), 0.25f, 0);
+    board.GetTraceLayer(1).segments.emplace_back(BRDPoint(1, 20), BRDPoint(9, 20), 0.25f, 0);
+    board.num_parts = static_cast<unsigned int>(board.parts.size());
+    board.num_pins = static_cast<unsigned int>(board.pins.size());
+    board.num_nails = 1;
+    board.SetValid(true);
+
+    const std::string dir = (std::filesystem::temp_directory_path() / "pcb_board_cache_test").string();
+    std::filesystem::remove_all(dir);
+    const uint64_t hash = 0x0123456789ABCDEFULL;
+    const uint64_t size = 4096;
+
+    check(!BoardCacheFile::LoadFromCache(dir, hash, size), "empty cache reports a hit");
+    check(BoardCacheFile::Store(dir, hash, size, board, 12.5), "store snapshot");
+
+    auto cached = BoardCacheFile::LoadFromCache(dir, hash, size);
+    check(cached != nullptr, "load stored snapshot");
+    if (cached) {
+        check(SameBoard(board, *cached), "snapshot round-trip differs from source board");
+        check(cached->SourceParseMs() == 12.5, "cold parse time not preserved");
+        check(cached->trace_layers.size() == 2 && cached->trace_layers[0].layer == 1, "trace layers in layer order");
+        check(cached->trace_net_ids.size() == 2 && cached->trace_net_ids[0] == cached->FindNetId("NET1") &&
+                  cached->NetName(cached->trace_net_ids[1]) == "TRACE_ONLY",
+              "trace nets resolved to pool ids");
+        check(cached->PinsOnNet(cached->trace_net_ids[1]).empty(), "trace-only net has no pins");
+    }
+    check(!BoardCacheFile::LoadFromCache(dir, hash, size + 1), "source size mismatch accepted");
+
+    // Truncated and version-bumped entries must be treated as misses
+    const std::string path = BoardCacheFile::CachePath(dir, hash);
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 3));
+    check(!BoardCacheFile::LoadFromCache(dir, hash, size), "truncated snapshot accepted");
+
+    std::vector<char> bumped(bytes);
+    bumped[8] = static_cast<char>(BoardCacheFile::kVersion + 1);
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bumped.data(), static_cast<std::streamsize>(bumped.size()));
+    check(!BoardCacheFile::LoadFromCache(dir, hash, size), "snapshot with another version accepted");
+
+    std::filesystem::remove_all(dir);
+
+    if (failures == 0) {
+        std::cout << "All board cache checks passed" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " board cache check(s) failed" << std::endl;
+    return 1;
+}
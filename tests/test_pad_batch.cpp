@@ -0,0 +1,171 @@
+// Instanced pad renderer: instance packing and pixels from an offscreen render
+// in a headless GL 3.3 core context (EGL surfaceless, e.g. Mesa llvmpipe).
+// Manual test: no build target compiles it, and it needs GLEW, EGL and a GL
+// driver on the machine
+//
+// Build (from repo root):
+//   g++ -std=c++17 -O2 -Isrc/viewers/pcb/core -Isrc/viewers/pcb/format -Isrc/viewers/pcb/rendering tests/test_pad_batch.cpp
+//       src/viewers/pcb/rendering/PadBatchRenderer.cpp src/viewers/pcb/format/BRDFileBase.cpp
+//       src/viewers/pcb/core/MappedFile.cpp src/viewers/pcb/core/Utils.cpp src/viewers/pcb/core/BRDTypes.cpp
+//       -lGLEW -lEGL -lGL -o test_pad_batch
+//   EGL_PLATFORM=surfaceless ./test_pad_batch
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "PadBatchRenderer.h"
+
+namespace {
+
+class TestBoard : public BRDFileBase {
+public:
+    bool Load(ByteView, const std::string& = "") override { return true; }
+    bool VerifyFormat(ByteView) override { return true; }
+};
+
+bool CreateHeadlessContext() {
+    auto get_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!get_display) return false;
+    EGLDisplay display = get_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) return false;
+    eglBindAPI(EGL_OPENGL_API);
+
+    const EGLint context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+                                      EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE};
+    EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attribs);
+    if (context == EGL_NO_CONTEXT) return false;
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) return false;
+
+    glewExperimental = GL_TRUE;
+    glewInit(); // may report an error without a default framebuffer; entry points still load
+    glGetError();
+    return true;
+}
+
+void AddPin(TestBoard& board, int x, int y, const char* net) {
+    BRDPin pin;
+    pin.pos = BRDPoint(x, y);
+    pin.part = 1;
+    board.SetPinNet(pin, net);
+    board.SetPinSnum(pin, std::to_string(board.pins.size() + 1));
+    board.pins.push_back(pin);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing instanced pad renderer..." << std::endl;
+    int failures = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        if (!ok) {
+            std::cout << "FAIL: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    // One unit per pixel on a 64x64 target
+    TestBoard board;
+    board.circles.emplace_back(BRDPoint(16, 16), 6.0f, 1.0f, 0.0f, 0.0f, 1.0f);  // no pin: own color
+    board.circles.emplace_back(BRDPoint(48, 48), 6.0f, 1.0f, 0.0f, 0.0f, 1.0f);  // NC pin
+    board.circles.emplace_back(BRDPoint(4, 60), 1.0f, 0.0f, 0.0f, 1.0f, 1.0f);   // below the dot threshold
+    board.rectangles.emplace_back(BRDPoint(48, 16), 16.0f, 6.0f, 90.0f, 0.0f, 1.0f, 0.0f, 1.0f); // highlighted net
+    board.ovals.emplace_back(BRDPoint(16, 48), 20.0f, 8.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f);        // GND pin
+    AddPin(board, 48, 48, "NC");
+    AddPin(board, 4, 60, "NET2");
+    AddPin(board, 48, 16, "NET1");
+    AddPin(board, 16, 48, "GND");
+    BRDPart part;
+    part.name = "U1";
+    part.end_of_pins = static_cast<unsigned int>(board.pins.size());
+    board.parts.push_back(part);
+    board.num_parts = 1;
+    board.num_pins = static_cast<unsigned int>(board.pins.size());
+    board.SetValid(true);
+    board.BuildIndices();
+
+    std::vector<PadBatchRenderer::Instance> instances;
+    PadBatchRenderer::BuildInstances(board, 0.0, 0.0, instances);
+    check(instances.size() == 5, "one instance per pad");
+    if (instances.size() == 5) {
+        check(instances[0].shape == PadBatchRenderer::kCircle && instances[0].pin_class == PadBatchRenderer::kNoPin,
+              "unlinked circle first, without a pin");
+        check(instances[1].pin_class == PadBatchRenderer::kNoConnect, "NC pin class");
+        check(instances[2].pin_class == PadBatchRenderer::kDefault, "default pin class");
+        check(instances[3].shape == PadBatchRenderer::kRectangle && instances[3].net == board.FindNetId("NET1"),
+              "rectangle after circles, with its pin's net");
+        check(instances[4].shape == PadBatchRenderer::kOval && instances[4].pin_class == PadBatchRenderer::kGround,
+              "oval last, GND pin class");
+        check(instances[3].half_size[0] == 8.0f && instances[3].half_size[1] == 3.0f, "rectangle half size");
+        check(instances[0].color[0] == 255 && instances[0].color[1] == 0, "shape color packed to bytes");
+    }
+
+    if (!CreateHeadlessContext()) {
+        std::cout << "No headless GL context; skipped the render checks" << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+    std::cout << "GL: " << glGetString(GL_VERSION) << " | " << glGetString(GL_RENDERER) << std::endl;
+
+    const int size = 64;
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glGenRenderbuffers(1, &color);
+    glBindRenderbuffer(GL_RENDERBUFFER, color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size, size);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    check(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "framebuffer complete");
+    glViewport(0, 0, size, size);
+    glClearColor(0.f, 0.f, 0.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    PadBatchRenderer pads;
+    check(pads.Initialize(), "shaders compile and link");
+    pads.Upload(instances);
+    check(pads.InstanceCount() == instances.size(), "instance count after upload");
+
+    PadBatchRenderer::FrameParams params;
+    params.linear[0] = 2.0f / size;
+    params.linear[3] = 2.0f / size;
+    params.translate[0] = -1.0f;
+    params.translate[1] = -1.0f;
+    params.zoom = 1.0f;
+    params.highlight_net = board.FindNetId("NET1");
+    params.same_net_color[0] = 1.f; params.same_net_color[1] = 1.f; params.same_net_color[2] = 0.f;
+    params.nc_color[0] = 0.f; params.nc_color[1] = 0.f; params.nc_color[2] = 1.f;
+    params.ground_color[0] = 1.f; params.ground_color[1] = 0.f; params.ground_color[2] = 1.f;
+    pads.Draw(params);
+    check(glGetError() == GL_NO_ERROR, "draw without GL errors");
+
+    std::vector<unsigned char> pixels(size * size * 4);
+    glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    auto expect = [&](int x, int y, int r, int g, int b, const char* what) {
+        const unsigned char* p = &pixels[(y * size + x) * 4];
+        bool ok = std::abs(p[0] - r) < 8 && std::abs(p[1] - g) < 8 && std::abs(p[2] - b) < 8;
+        check(ok, std::string(what) + " (got " + std::to_string(p[0]) + "," + std::to_string(p[1]) + "," +
+                      std::to_string(p[2]) + ")");
+    };
+    expect(16, 16, 255, 0, 0, "unlinked circle keeps its own color");
+    expect(48, 48, 0, 0, 255, "NC pad uses the NC color");
+    expect(4, 60, 0, 0, 255, "tiny pad drawn as a dot");
+    expect(48, 22, 255, 255, 0, "rotated rectangle covers its long axis in y, same-net color");
+    expect(54, 16, 0, 0, 0, "rotated rectangle leaves its unrotated width empty");
+    expect(24, 48, 255, 0, 255, "oval end uses the ground color");
+    expect(16, 53, 0, 0, 0, "outside the oval");
+    expect(32, 32, 0, 0, 0, "empty board stays clear");
+    expect(21, 16, 180, 0, 0, "circle edge is outlined");
+
+    pads.Shutdown();
+    glDeleteRenderbuffers(1, &color);
+    glDeleteFramebuffers(1, &fbo);
+
+    if (failures == 0) {
+        std::cout << "All pad batch tests passed" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " pad batch test(s) failed" << std::endl;
+    return 1;
+}